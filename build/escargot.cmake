@@ -81,6 +81,9 @@ LIST (REMOVE_ITEM ESCARGOT_SRC ${ESCARGOT_ROOT}/src/shell/Shell.cpp)
 # Always exclude N-API Shell source from the core engine files to prevent main() conflicts
 LIST (REMOVE_ITEM ESCARGOT_SRC ${ESCARGOT_ROOT}/src/shell/NapiShell.cpp)
 
+# Bytecode bundle compiler is a separate executable too
+LIST (REMOVE_ITEM ESCARGOT_SRC ${ESCARGOT_ROOT}/src/shell/Compile.cpp)
+
 IF (ESCARGOT_BUILD_CCTEST)
     SET (BUILD_GMOCK OFF)
     SET (INSTALL_GTEST OFF)
@@ -348,6 +351,17 @@ IF(ESCARGOT_ENABLE_SHELL)
     TARGET_COMPILE_DEFINITIONS (escargot_shell PRIVATE ${ESCARGOT_DEFINITIONS} ${ESCARGOT_CONFIG_DEFINITIONS})
 ENDIF()
 
+# Build the bytecode bundle compiler along with the shell (needs code cache)
+IF (ESCARGOT_ENABLE_SHELL AND ESCARGOT_CODE_CACHE)
+    ADD_EXECUTABLE (escargot_compile ${ESCARGOT_ROOT}/src/shell/Compile.cpp)
+    SET_TARGET_PROPERTIES (escargot_compile PROPERTIES OUTPUT_NAME "escargot-compile")
+
+    TARGET_LINK_LIBRARIES (escargot_compile PRIVATE ${ESCARGOT_TARGET})
+    TARGET_COMPILE_OPTIONS (escargot_compile PRIVATE ${ESCARGOT_CXXFLAGS_SHELL} ${ESCARGOT_CONFIG_CXXFLAGS} ${ESCARGOT_CXXFLAGS} ${CXXFLAGS_FROM_ENV})
+    TARGET_INCLUDE_DIRECTORIES (escargot_compile PRIVATE ${ESCARGOT_INCDIRS})
+    TARGET_COMPILE_DEFINITIONS (escargot_compile PRIVATE ${ESCARGOT_DEFINITIONS} ${ESCARGOT_CONFIG_DEFINITIONS})
+ENDIF()
+
 # 3. Build the C++ tests if enabled
 IF(ESCARGOT_BUILD_CCTEST)
     ADD_EXECUTABLE (${ESCARGOT_CCTEST_TARGET} ${CCTEST_SRC})
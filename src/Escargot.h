@@ -654,12 +654,41 @@ typedef uint16_t LexicalBlockIndex;
 #define STRING_BUILDER_INLINE_STORAGE_DEFAULT 24
 #endif
 
+// content length (in characters) at which a StringBuilder in ContiguousBufferMode
+// stops collecting pieces and starts writing into a single growing buffer
+#ifndef STRING_BUILDER_CONTIGUOUS_BUFFER_THRESHOLD
+#define STRING_BUILDER_CONTIGUOUS_BUFFER_THRESHOLD 1024 * 4
+#endif
+
 #ifndef SCRIPT_FUNCTION_OBJECT_BYTECODE_SIZE_MAX
 #define SCRIPT_FUNCTION_OBJECT_BYTECODE_SIZE_MAX 1024 * 256
 #endif
 
-#ifndef REGEXP_CACHE_SIZE_MAX
-#define REGEXP_CACHE_SIZE_MAX 64
+// upper bound of estimated bytes (parsed pattern + compiled bytecode) kept in the regexp cache
+// least recently used entries are evicted on GC once the cache grows over this
+#ifndef REGEXP_CACHE_COMPILED_SIZE_MAX
+#define REGEXP_CACHE_COMPILED_SIZE_MAX 1024 * 128
+#endif
+
+// initial number of records in the job queue ring buffer
+// a drained queue which grew over JOB_QUEUE_RETAINED_CAPACITY records returns to the initial size
+#ifndef JOB_QUEUE_INITIAL_CAPACITY
+#define JOB_QUEUE_INITIAL_CAPACITY 64
+#endif
+
+#ifndef JOB_QUEUE_RETAINED_CAPACITY
+#define JOB_QUEUE_RETAINED_CAPACITY 1024 * 4
+#endif
+
+// default TypedArray sort splits radix passes across threads for arrays of at least this many elements
+#ifndef TYPEDARRAY_PARALLEL_SORT_THRESHOLD
+#define TYPEDARRAY_PARALLEL_SORT_THRESHOLD 1024 * 1024
+#endif
+
+// the sort spawns and joins its helper threads on every call, so it stays on the calling thread
+// unless the embedder raises this (requires ENABLE_THREADING)
+#ifndef TYPEDARRAY_PARALLEL_SORT_THREAD_MAX
+#define TYPEDARRAY_PARALLEL_SORT_THREAD_MAX 1
 #endif
 
 // maximum number of tail call arguments allowed
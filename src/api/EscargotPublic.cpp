@@ -140,6 +140,11 @@ public:
         return m_platform->onReallocArrayBufferObjectDataBuffer(oldBuffer, oldSizeInByte, newSizeInByte);
     }
 
+    virtual void onCommitArrayBufferObjectDataBuffer(void* buffer, size_t oldCommittedSizeInByte, size_t newCommittedSizeInByte) override
+    {
+        m_platform->onCommitArrayBufferObjectDataBuffer(buffer, oldCommittedSizeInByte, newCommittedSizeInByte);
+    }
+
     virtual void markJSJobEnqueued(Context* relatedContext) override
     {
         // TODO Job queue should be separately managed for each thread
@@ -617,6 +622,11 @@ size_t Memory::totalSize()
     return GC_get_total_bytes();
 }
 
+size_t Memory::externalStringSize()
+{
+    return ThreadLocal::externalStringSize();
+}
+
 void Memory::addGCEventListener(GCEventType type, OnGCEventListener l, void* data)
 {
     GCEventListenerSet& list = ThreadLocal::gcEventListenerSet();
@@ -836,6 +846,51 @@ StringRef* StringRef::createExternalFromUTF16(const char16_t* s, size_t len)
     return toRef(new UTF16StringFromExternalMemory(s, len));
 }
 
+struct ExternalStringFinalizerData {
+    StringRef::ExternalStringFinalizer finalizer;
+    void* buffer;
+    size_t byteLength;
+    void* data;
+};
+
+static void externalStringFinalizer(void* self, void* data)
+{
+    ExternalStringFinalizerData* d = reinterpret_cast<ExternalStringFinalizerData*>(data);
+    ThreadLocal::removeExternalStringSize(d->byteLength);
+    if (d->finalizer) {
+        d->finalizer(d->buffer, d->data);
+    }
+    delete d;
+}
+
+static StringRef* registerExternalStringFinalizer(String* str, const void* buffer, size_t byteLength, StringRef::ExternalStringFinalizer finalizer, void* data)
+{
+    ExternalStringFinalizerData* d = new ExternalStringFinalizerData;
+    d->finalizer = finalizer;
+    d->buffer = const_cast<void*>(buffer);
+    d->byteLength = byteLength;
+    d->data = data;
+    ThreadLocal::addExternalStringSize(byteLength);
+    // go through Memory::gcRegisterFinalizer so that the host can still add its own finalizers to the string
+    Memory::gcRegisterFinalizer(str, externalStringFinalizer, d);
+    return toRef(str);
+}
+
+StringRef* StringRef::createExternalFromASCII(const char* s, size_t len, ExternalStringFinalizer finalizer, void* data)
+{
+    return registerExternalStringFinalizer(new ASCIIStringFromExternalMemory(s, len), s, len, finalizer, data);
+}
+
+StringRef* StringRef::createExternalFromLatin1(const unsigned char* s, size_t len, ExternalStringFinalizer finalizer, void* data)
+{
+    return registerExternalStringFinalizer(new Latin1StringFromExternalMemory(s, len), s, len, finalizer, data);
+}
+
+StringRef* StringRef::createExternalFromUTF16(const char16_t* s, size_t len, ExternalStringFinalizer finalizer, void* data)
+{
+    return registerExternalStringFinalizer(new UTF16StringFromExternalMemory(s, len), s, len * sizeof(char16_t), finalizer, data);
+}
+
 bool StringRef::isCompressibleStringEnabled()
 {
 #if defined(ENABLE_COMPRESSIBLE_STRING)
@@ -1529,6 +1584,31 @@ Evaluator::EvaluatorResult VMInstanceRef::executePendingJob()
     return toEvaluatorResultRef(result);
 }
 
+Evaluator::EvaluatorResult VMInstanceRef::executePendingJobs(size_t maxCount, uint64_t timeBudgetInMillisecond, size_t* executedJobCount)
+{
+    size_t count;
+    auto result = toImpl(this)->executePendingJobs(maxCount, timeBudgetInMillisecond, count);
+    if (executedJobCount) {
+        *executedJobCount = count;
+    }
+    return toEvaluatorResultRef(result);
+}
+
+size_t VMInstanceRef::pendingJobCount()
+{
+    return toImpl(this)->pendingJobCount();
+}
+
+size_t VMInstanceRef::pendingJobHighWaterMark()
+{
+    return toImpl(this)->pendingJobHighWaterMark();
+}
+
+void VMInstanceRef::resetPendingJobHighWaterMark()
+{
+    toImpl(this)->resetPendingJobHighWaterMark();
+}
+
 void VMInstanceRef::enqueueEvaluateJob(ContextRef* relalatedContext, EvaluateJobCallback callback, void* data)
 {
     struct Holder : public gc {
@@ -1578,6 +1658,31 @@ void VMInstanceRef::setMaxCompiledByteCodeSize(size_t s)
     toImpl(this)->setMaxCompiledByteCodeSize(s);
 }
 
+size_t VMInstanceRef::maxRegExpCacheCompiledSize()
+{
+    return toImpl(this)->maxRegExpCacheCompiledSize();
+}
+
+void VMInstanceRef::setMaxRegExpCacheCompiledSize(size_t s)
+{
+    toImpl(this)->setMaxRegExpCacheCompiledSize(s);
+}
+
+size_t VMInstanceRef::regExpCacheCompiledSize()
+{
+    return toImpl(this)->regexpCacheCompiledSize();
+}
+
+size_t VMInstanceRef::regExpCacheHitCount()
+{
+    return toImpl(this)->regexpCacheHitCount();
+}
+
+size_t VMInstanceRef::regExpCacheMissCount()
+{
+    return toImpl(this)->regexpCacheMissCount();
+}
+
 #if defined(ENABLE_CODE_CACHE)
 bool VMInstanceRef::isCodeCacheEnabled()
 {
@@ -1613,6 +1718,11 @@ void VMInstanceRef::setCodeCacheShouldLoadFunctionOnScriptLoading(bool s)
 {
     toImpl(this)->codeCache()->setShouldLoadFunctionOnScriptLoading(s);
 }
+
+void VMInstanceRef::flushCodeCache()
+{
+    toImpl(this)->codeCache()->flush();
+}
 #else // ENABLE_CODE_CACHE
 bool VMInstanceRef::isCodeCacheEnabled()
 {
@@ -1654,6 +1764,12 @@ void VMInstanceRef::setCodeCacheShouldLoadFunctionOnScriptLoading(bool s)
     ESCARGOT_LOG_ERROR("If you want to use this function, you should enable code cache");
     RELEASE_ASSERT_NOT_REACHED();
 }
+
+void VMInstanceRef::flushCodeCache()
+{
+    ESCARGOT_LOG_ERROR("If you want to use this function, you should enable code cache");
+    RELEASE_ASSERT_NOT_REACHED();
+}
 #endif // ENABLE_CODE_CACHE
 
 #ifdef ESCARGOT_DEBUGGER
@@ -4688,6 +4804,11 @@ size_t SetObjectRef::size(ExecutionStateRef* state)
     return toImpl(this)->size(*toImpl(state));
 }
 
+size_t SetObjectRef::allocatedMemorySize()
+{
+    return toImpl(this)->allocatedMemorySize();
+}
+
 WeakSetObjectRef* WeakSetObjectRef::create(ExecutionStateRef* state)
 {
     return toRef(new WeakSetObject(*toImpl(state)));
@@ -4753,6 +4874,11 @@ size_t MapObjectRef::size(ExecutionStateRef* state)
     return toImpl(this)->size(*toImpl(state));
 }
 
+size_t MapObjectRef::allocatedMemorySize()
+{
+    return toImpl(this)->allocatedMemorySize();
+}
+
 WeakMapObjectRef* WeakMapObjectRef::create(ExecutionStateRef* state)
 {
     return toRef(new WeakMapObject(*toImpl(state)));
@@ -5092,6 +5218,306 @@ ScriptParserRef::InitializeScriptResult ScriptParserRef::initializeJSONModule(St
     return result;
 }
 
+#if defined(ENABLE_CODE_CACHE)
+#if defined(ENABLE_THREADING)
+// compiles a part of a bundle on its own thread and VMInstance
+class BundleCompileWorker {
+public:
+    BundleCompileWorker(StringRef* sourceCode, StringRef* srcName, bool storeFunctions, size_t partIndex = 0, size_t partCount = 1)
+        : m_storeFunctions(storeFunctions)
+        , m_partIndex(partIndex)
+        , m_partCount(partCount)
+        , m_done(false)
+    {
+        start(sourceCode, srcName);
+    }
+
+    // store only the functions starting at functionStarts (sorted)
+    BundleCompileWorker(StringRef* sourceCode, StringRef* srcName, std::vector<size_t>&& functionStarts)
+        : m_storeFunctions(true)
+        , m_partIndex(0)
+        , m_partCount(1)
+        , m_functionStarts(std::move(functionStarts))
+        , m_hasFunctionStarts(true)
+        , m_done(false)
+    {
+        start(sourceCode, srcName);
+    }
+
+    ~BundleCompileWorker()
+    {
+        join();
+    }
+
+    bool isDone()
+    {
+        return m_done.load(std::memory_order_acquire);
+    }
+
+    std::vector<char>& join()
+    {
+        if (m_thread.joinable()) {
+            m_thread.join();
+        }
+        return m_bundle;
+    }
+
+private:
+    void start(StringRef* sourceCode, StringRef* srcName)
+    {
+        // the worker gets a copy of the source in the same encoding, so that the bundle
+        // matches the source hash of this thread and no GC object is shared between threads
+        StringBufferAccessData data = toImpl(sourceCode)->bufferAccessData();
+        m_sourceIs8Bit = data.has8BitContent;
+        m_source.assign(data.bufferAs8Bit, data.has8BitContent ? data.length : data.length * sizeof(char16_t));
+        m_srcNameUTF8 = srcName->toStdUTF8String();
+
+        m_thread = std::thread(&BundleCompileWorker::compile, this);
+    }
+
+    void compile()
+    {
+        Globals::initializeThread();
+        {
+            PersistentRefHolder<VMInstanceRef> instance = VMInstanceRef::create();
+            PersistentRefHolder<ContextRef> context = ContextRef::create(instance.get());
+
+            String* source;
+            if (m_sourceIs8Bit) {
+                source = toImpl(StringRef::createFromLatin1(reinterpret_cast<const unsigned char*>(m_source.data()), m_source.length()));
+            } else {
+                source = toImpl(StringRef::createFromUTF16(reinterpret_cast<const char16_t*>(m_source.data()), m_source.length() / sizeof(char16_t)));
+            }
+            String* srcName = toImpl(StringRef::createFromUTF8(m_srcNameUTF8.data(), m_srcNameUTF8.length()));
+            toImpl(context->scriptParser())->compileScriptBundle(source, srcName, m_bundle, m_storeFunctions, m_partIndex, m_partCount, m_hasFunctionStarts ? &m_functionStarts : nullptr);
+
+            context.release();
+            instance.release();
+        }
+        Globals::finalizeThread();
+
+        m_done.store(true, std::memory_order_release);
+    }
+
+    bool m_storeFunctions;
+    size_t m_partIndex;
+    size_t m_partCount;
+    std::vector<size_t> m_functionStarts;
+    bool m_hasFunctionStarts = false;
+    std::string m_source;
+    bool m_sourceIs8Bit;
+    std::string m_srcNameUTF8;
+    std::vector<char> m_bundle;
+    std::atomic<bool> m_done;
+    std::thread m_thread;
+};
+
+// hot functions of a running script split over workers, each compiling its share into a bundle
+class WorkerParallelCompileTask : public ParallelCompileTask {
+public:
+    WorkerParallelCompileTask(StringRef* sourceCode, StringRef* srcName, const std::vector<size_t>& functionStarts, size_t threadCount)
+    {
+        ASSERT(functionStarts.size());
+        size_t workerCount = std::min(std::max(threadCount, (size_t)1), functionStarts.size());
+        std::vector<std::vector<size_t>> shares(workerCount);
+        for (size_t i = 0; i < functionStarts.size(); i++) {
+            shares[i % workerCount].push_back(functionStarts[i]);
+            m_workerIndex[functionStarts[i]] = i % workerCount;
+        }
+        for (size_t i = 0; i < workerCount; i++) {
+            m_workers.push_back(std::unique_ptr<BundleCompileWorker>(new BundleCompileWorker(sourceCode, srcName, std::move(shares[i]))));
+        }
+    }
+
+    virtual const std::vector<char>* readyBundle(size_t functionStart) override
+    {
+        auto iter = m_workerIndex.find(functionStart);
+        if (iter == m_workerIndex.end() || !m_workers[iter->second]->isDone()) {
+            return nullptr;
+        }
+        // the worker is done, so this only reclaims its thread
+        std::vector<char>& bundle = m_workers[iter->second]->join();
+        return bundle.size() ? &bundle : nullptr;
+    }
+
+private:
+    std::unordered_map<size_t, size_t> m_workerIndex;
+    std::vector<std::unique_ptr<BundleCompileWorker>> m_workers;
+};
+#endif
+
+ScriptParserRef::InitializeScriptResult ScriptParserRef::compileScriptBundle(StringRef* sourceCode, StringRef* srcName, std::vector<char>& bundle, size_t threadCount)
+{
+#if defined(ENABLE_THREADING)
+    size_t partCount = std::max(threadCount, (size_t)1);
+
+    // this thread compiles the first part, which also gives the returned Script
+    std::vector<std::unique_ptr<BundleCompileWorker>> workers;
+    for (size_t i = 1; i < partCount; i++) {
+        workers.push_back(std::unique_ptr<BundleCompileWorker>(new BundleCompileWorker(sourceCode, srcName, true, i, partCount)));
+    }
+#else
+    size_t partCount = 1;
+#endif
+
+    std::vector<char> firstPart;
+    auto internalResult = toImpl(this)->compileScriptBundle(toImpl(sourceCode), toImpl(srcName), partCount > 1 ? firstPart : bundle, true, 0, partCount);
+
+#if defined(ENABLE_THREADING)
+    if (partCount > 1) {
+        std::vector<std::vector<char>> parts;
+        parts.push_back(std::move(firstPart));
+        for (size_t i = 0; i < workers.size(); i++) {
+            parts.push_back(std::move(workers[i]->join()));
+        }
+        if (internalResult.script && !CodeCache::mergeBundles(parts, bundle)) {
+            ESCARGOT_LOG_ERROR("[CodeCache] can't merge bundles of %s\n", toImpl(srcName)->toNonGCUTF8StringData().data());
+        }
+    }
+#endif
+
+    ScriptParserRef::InitializeScriptResult result;
+    if (internalResult.script) {
+        result.script = toRef(internalResult.script.value());
+    } else {
+        result.parseErrorMessage = toRef(internalResult.parseErrorMessage);
+        result.parseErrorCode = (Escargot::ErrorObjectRef::Code)internalResult.parseErrorCode;
+    }
+
+    return result;
+}
+
+ScriptParserRef::InitializeScriptResult ScriptParserRef::initializeScriptFromBundle(const void* bundleData, size_t bundleSize, StringRef* sourceCode, StringRef* srcName, bool verifySourceHash)
+{
+    auto internalResult = toImpl(this)->initializeScriptFromBundle(reinterpret_cast<const char*>(bundleData), bundleSize, toImpl(sourceCode), toImpl(srcName), verifySourceHash);
+    ScriptParserRef::InitializeScriptResult result;
+    if (internalResult.script) {
+        result.script = toRef(internalResult.script.value());
+    } else {
+        result.parseErrorMessage = toRef(internalResult.parseErrorMessage);
+        result.parseErrorCode = (Escargot::ErrorObjectRef::Code)internalResult.parseErrorCode;
+    }
+
+    return result;
+}
+
+ScriptParserRef::InitializeScriptResult ScriptParserRef::initializeScriptWithParallelCompile(StringRef* sourceCode, StringRef* srcName, size_t threadCount, const std::vector<size_t>& profiledFunctionStarts)
+{
+    auto internalResult = toImpl(this)->initializeScript(toImpl(sourceCode), toImpl(srcName), false);
+    ScriptParserRef::InitializeScriptResult result;
+    if (!internalResult.script) {
+        result.parseErrorMessage = toRef(internalResult.parseErrorMessage);
+        result.parseErrorCode = (Escargot::ErrorObjectRef::Code)internalResult.parseErrorCode;
+        return result;
+    }
+
+#if defined(ENABLE_THREADING)
+    Script* script = internalResult.script.value();
+    std::vector<size_t> functionStarts;
+    ScriptParser::collectHotFunctionStarts(script, profiledFunctionStarts, functionStarts);
+    if (functionStarts.size()) {
+        script->setParallelCompileTask(new WorkerParallelCompileTask(sourceCode, srcName, functionStarts, threadCount));
+    }
+#endif
+
+    result.script = toRef(internalResult.script.value());
+    return result;
+}
+#else // ENABLE_CODE_CACHE
+ScriptParserRef::InitializeScriptResult ScriptParserRef::compileScriptBundle(StringRef* sourceCode, StringRef* srcName, std::vector<char>& bundle, size_t threadCount)
+{
+    ESCARGOT_LOG_ERROR("If you want to use this function, you should enable code cache");
+    RELEASE_ASSERT_NOT_REACHED();
+}
+
+ScriptParserRef::InitializeScriptResult ScriptParserRef::initializeScriptFromBundle(const void* bundleData, size_t bundleSize, StringRef* sourceCode, StringRef* srcName, bool verifySourceHash)
+{
+    ESCARGOT_LOG_ERROR("If you want to use this function, you should enable code cache");
+    RELEASE_ASSERT_NOT_REACHED();
+}
+
+ScriptParserRef::InitializeScriptResult ScriptParserRef::initializeScriptWithParallelCompile(StringRef* sourceCode, StringRef* srcName, size_t threadCount, const std::vector<size_t>& profiledFunctionStarts)
+{
+    return initializeScript(sourceCode, srcName, false);
+}
+#endif // ENABLE_CODE_CACHE
+
+class ScriptParserRef::BackgroundParseTask {
+public:
+    BackgroundParseTask(StringRef* sourceCode, StringRef* srcName)
+        : m_sourceCode(sourceCode)
+        , m_srcName(srcName)
+#if defined(ENABLE_CODE_CACHE) && defined(ENABLE_THREADING)
+        , m_worker(sourceCode, srcName, false)
+#endif
+    {
+    }
+
+    bool isDone()
+    {
+#if defined(ENABLE_CODE_CACHE) && defined(ENABLE_THREADING)
+        return m_worker.isDone();
+#else
+        return true;
+#endif
+    }
+
+    ScriptParser::InitializeScriptResult finish(ScriptParser* parser)
+    {
+        String* sourceCode = toImpl(m_sourceCode.get());
+        String* srcName = toImpl(m_srcName.get());
+#if defined(ENABLE_CODE_CACHE) && defined(ENABLE_THREADING)
+        std::vector<char>& bundle = m_worker.join();
+        if (bundle.size()) {
+            // the bundle only holds the global code, so the Script does not refer to it after loading
+            // and functions are compiled on this thread when first called, as with initializeScript
+            // the bundle was just made from this very source
+            auto result = parser->initializeScriptFromBundle(bundle.data(), bundle.size(), sourceCode, srcName, false);
+            ASSERT(!result.script || !result.script->bundleData());
+            std::vector<char>().swap(bundle);
+            if (result.script) {
+                return result;
+            }
+        }
+#endif
+        // parse errors are reported from here as well, so the message is made on this thread
+        return parser->initializeScript(sourceCode, srcName, false);
+    }
+
+private:
+    PersistentRefHolder<StringRef> m_sourceCode;
+    PersistentRefHolder<StringRef> m_srcName;
+#if defined(ENABLE_CODE_CACHE) && defined(ENABLE_THREADING)
+    BundleCompileWorker m_worker;
+#endif
+};
+
+ScriptParserRef::BackgroundParseTask* ScriptParserRef::startBackgroundParse(StringRef* sourceCode, StringRef* srcName)
+{
+    return new BackgroundParseTask(sourceCode, srcName);
+}
+
+bool ScriptParserRef::isBackgroundParseDone(BackgroundParseTask* task)
+{
+    return task->isDone();
+}
+
+ScriptParserRef::InitializeScriptResult ScriptParserRef::finishBackgroundParse(BackgroundParseTask* task)
+{
+    auto internalResult = task->finish(toImpl(this));
+    delete task;
+
+    ScriptParserRef::InitializeScriptResult result;
+    if (internalResult.script) {
+        result.script = toRef(internalResult.script.value());
+    } else {
+        result.parseErrorMessage = toRef(internalResult.parseErrorMessage);
+        result.parseErrorCode = (Escargot::ErrorObjectRef::Code)internalResult.parseErrorCode;
+    }
+
+    return result;
+}
+
 bool ScriptRef::isModule()
 {
     return toImpl(this)->isModule();
@@ -5122,6 +5548,30 @@ ValueRef* ScriptRef::execute(ExecutionStateRef* state)
     return toRef(toImpl(this)->execute(*toImpl(state)));
 }
 
+static void collectCompiledFunctionStarts(InterpretedCodeBlock* parent, std::vector<size_t>& functionStarts)
+{
+    if (!parent->hasChildren()) {
+        return;
+    }
+
+    InterpretedCodeBlockVector& children = parent->children();
+    for (size_t i = 0; i < children.size(); i++) {
+        if (children[i]->byteCodeBlock()) {
+            functionStarts.push_back(children[i]->functionStart().index);
+        }
+        collectCompiledFunctionStarts(children[i], functionStarts);
+    }
+}
+
+std::vector<size_t> ScriptRef::compiledFunctionStarts()
+{
+    std::vector<size_t> functionStarts;
+    if (toImpl(this)->topCodeBlock()) {
+        collectCompiledFunctionStarts(toImpl(this)->topCodeBlock(), functionStarts);
+    }
+    return functionStarts;
+}
+
 size_t ScriptRef::moduleRequestsLength()
 {
     return toImpl(this)->moduleRequestsLength();
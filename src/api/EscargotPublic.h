@@ -223,6 +223,7 @@ public:
 
     static size_t heapSize(); // Return the number of bytes in the heap.  Excludes bdwgc private data structures. Excludes the unmapped memory
     static size_t totalSize(); // Return the total number of bytes allocated in this process
+    static size_t externalStringSize(); // Return the number of bytes of host memory held by live strings from StringRef::createExternalFrom* with finalizer
 
     enum GCEventType {
         MARK_START,
@@ -798,6 +799,14 @@ public:
 
     bool hasPendingJob();
     Evaluator::EvaluatorResult executePendingJob();
+    // runs pending jobs until the queue is empty, maxCount jobs have run or timeBudgetInMillisecond has elapsed (zero means infinity)
+    // stops after a job which throws and returns its result. otherwise returns the result of the last executed job,
+    // or undefined if the queue was empty (executedJobCount is zero then)
+    Evaluator::EvaluatorResult executePendingJobs(size_t maxCount = std::numeric_limits<size_t>::max(), uint64_t timeBudgetInMillisecond = 0, size_t* executedJobCount = nullptr);
+    // number of jobs currently queued, and the largest number observed since creation or the last reset
+    size_t pendingJobCount();
+    size_t pendingJobHighWaterMark();
+    void resetPendingJobHighWaterMark();
     typedef ValueRef* (*EvaluateJobCallback)(ExecutionStateRef* state, void* data);
     void enqueueEvaluateJob(ContextRef* relatedContext, EvaluateJobCallback callback, void* data);
 
@@ -811,13 +820,26 @@ public:
     size_t maxCompiledByteCodeSize();
     void setMaxCompiledByteCodeSize(size_t s);
 
+    // regexp cache is shared by every Context of this VMInstance
+    // least recently used patterns are evicted while GC once the estimated size exceeds the limit
+    size_t maxRegExpCacheCompiledSize();
+    void setMaxRegExpCacheCompiledSize(size_t s);
+    size_t regExpCacheCompiledSize();
+    size_t regExpCacheHitCount();
+    size_t regExpCacheMissCount();
+
     bool isCodeCacheEnabled();
     size_t codeCacheMinSourceLength();
     void setCodeCacheMinSourceLength(size_t s);
+    // max count of scripts this process keeps in the cache directory
+    // eviction is per-process, scripts cached by other processes are not counted
     size_t codeCacheMaxCacheCount();
     void setCodeCacheMaxCacheCount(size_t s);
     bool codeCacheShouldLoadFunctionOnScriptLoading();
     void setCodeCacheShouldLoadFunctionOnScriptLoading(bool s);
+    // code cache files are written on a background thread
+    // block until every pending entry has been written (e.g. before shutting down)
+    void flushCodeCache();
 };
 
 class ESCARGOT_EXPORT DebuggerOperationsRef {
@@ -1166,6 +1188,14 @@ public:
     static StringRef* createExternalFromLatin1(const unsigned char* s, size_t stringLength);
     static StringRef* createExternalFromUTF16(const char16_t* s, size_t stringLength);
 
+    // zero-copy strings over host memory whose lifetime is managed by the host
+    // the buffer must stay valid and unmodified until `finalizer` is called with it (after the string is collected)
+    // the buffer size is reported by Memory::externalStringSize while the string is alive
+    typedef void (*ExternalStringFinalizer)(void* buffer, void* data);
+    static StringRef* createExternalFromASCII(const char* s, size_t stringLength, ExternalStringFinalizer finalizer, void* data);
+    static StringRef* createExternalFromLatin1(const unsigned char* s, size_t stringLength, ExternalStringFinalizer finalizer, void* data);
+    static StringRef* createExternalFromUTF16(const char16_t* s, size_t stringLength, ExternalStringFinalizer finalizer, void* data);
+
     // you can use these functions only if you enabled string compression
     static bool isCompressibleStringEnabled();
     static StringRef* createFromUTF8ToCompressibleString(VMInstanceRef* instance, const char* s, size_t byteLength, bool maybeASCII = true);
@@ -2015,6 +2045,8 @@ public:
     bool deleteOperation(ExecutionStateRef* state, ValueRef* key);
     bool has(ExecutionStateRef* state, ValueRef* key);
     size_t size(ExecutionStateRef* state);
+    // bytes currently held by the entry storage and hash index
+    size_t allocatedMemorySize();
 };
 
 class ESCARGOT_EXPORT WeakSetObjectRef : public ObjectRef {
@@ -2034,6 +2066,8 @@ public:
     bool has(ExecutionStateRef* state, ValueRef* key);
     void set(ExecutionStateRef* state, ValueRef* key, ValueRef* value);
     size_t size(ExecutionStateRef* state);
+    // bytes currently held by the entry storage and hash index
+    size_t allocatedMemorySize();
 };
 
 class ESCARGOT_EXPORT WeakMapObjectRef : public ObjectRef {
@@ -2240,6 +2274,49 @@ public:
     InitializeFunctionScriptResult initializeFunctionScript(StringRef* sourceName, AtomicStringRef* functionName, size_t argumentCount, ValueRef** argumentNameArray, ValueRef* functionBody);
     // parse the input JSON data and return the result (Script)
     InitializeScriptResult initializeJSONModule(StringRef* sourceCode, StringRef* srcName);
+
+    // precompiled bytecode bundles (only available with code cache enabled)
+    // compile the script and all of its functions into `bundle`, and return the compiled Script
+    // `bundle` is left empty when the script could not be stored (e.g. empty srcName)
+    // with threadCount > 1 and threading support, the functions are split over worker threads
+    // which compile them with their own VMInstance, and the parts are merged into one bundle
+    // every function is compiled ahead of time. a Script loaded from the bundle installs
+    // the bytecode of each function on its own thread when the function is first called
+    // (see initializeScriptWithParallelCompile for compiling only the likely-hot functions while the script runs)
+    InitializeScriptResult compileScriptBundle(StringRef* sourceCode, StringRef* srcName, std::vector<char>& bundle, size_t threadCount = 1);
+    // load a Script from a bundle made by the same Escargot build without parsing it
+    // bundleData should be kept alive while the Script lives, and sourceCode should be the source the bundle was made from
+    // sourceCode is only read for Function.prototype.toString or functions missing in the bundle,
+    // so a reloadable string (StringRef::createReloadableString) can keep it unloaded until then
+    // NOTE: bundles are trusted input. the checksums are keyed by the public build ID and only
+    // catch accidental corruption, so a crafted bundle runs arbitrary bytecode.
+    // never load a bundle from a location untrusted code can write to
+    // with verifySourceHash = false only the length of sourceCode is compared with the bundle,
+    // and a different source of the same length is NOT detected: the bundled code runs,
+    // while toString and functions missing in the bundle read the other source.
+    // verifySourceHash = true hashes sourceCode and compares it with the hash stored in the bundle
+    // (this reads the whole source, so a reloadable string is loaded)
+    InitializeScriptResult initializeScriptFromBundle(const void* bundleData, size_t bundleSize, StringRef* sourceCode, StringRef* srcName, bool verifySourceHash);
+
+    // parse the script like initializeScript, and compile its likely-hot functions on up to threadCount worker threads
+    // with their own VMInstance while the script runs. the selected functions are IIFEs, top-level function declarations
+    // called from the top-level code and the functions starting at profiledFunctionStarts (see ScriptRef::compiledFunctionStarts)
+    // a function called before its worker is done is compiled on this thread as usual, this thread never waits for the workers
+    // the workers need code cache and threading support. without them, this is the same as initializeScript
+    InitializeScriptResult initializeScriptWithParallelCompile(StringRef* sourceCode, StringRef* srcName, size_t threadCount, const std::vector<size_t>& profiledFunctionStarts = std::vector<size_t>());
+
+    // background parsing
+    // startBackgroundParse parses the script and generates its global code on a worker thread with its own VMInstance,
+    // and finishBackgroundParse loads the result into this context, interning its strings on this thread.
+    // functions are compiled on this thread when they are first called, as with initializeScript
+    // the worker needs code cache and threading support. without them, or when the worker result cannot be used,
+    // finishBackgroundParse parses on this thread
+    class BackgroundParseTask;
+    BackgroundParseTask* startBackgroundParse(StringRef* sourceCode, StringRef* srcName);
+    // true when finishBackgroundParse would not wait for the worker
+    static bool isBackgroundParseDone(BackgroundParseTask* task);
+    // waits for the worker if needed and deletes the task
+    InitializeScriptResult finishBackgroundParse(BackgroundParseTask* task);
 };
 
 class ESCARGOT_EXPORT ScriptRef {
@@ -2250,6 +2327,9 @@ public:
     StringRef* sourceCode();
     ContextRef* context();
     ValueRef* execute(ExecutionStateRef* state);
+    // source offsets of the functions compiled so far, which can be handed to
+    // ScriptParserRef::initializeScriptWithParallelCompile as a profile of the next run
+    std::vector<size_t> compiledFunctionStarts();
 
     // only module can use these functions
     size_t moduleRequestsLength();
@@ -2295,6 +2375,14 @@ public:
         return ptr;
     }
 
+    // resizable ArrayBuffers and growable SharedArrayBuffers with a large maxByteLength reserve address space
+    // and commit pages as they grow instead of calling onMallocArrayBufferObjectDataBuffer.
+    // this reports every change of their committed size (zero once released) for memory accounting.
+    // it may be called from another thread for SharedArrayBuffers
+    virtual void onCommitArrayBufferObjectDataBuffer(void* buffer, size_t oldCommittedSizeInByte, size_t newCommittedSizeInByte)
+    {
+    }
+
     // If you want to add a Job event, you should call VMInstanceRef::executePendingJob after event. see Shell.cpp
     virtual void markJSJobEnqueued(ContextRef* relatedContext) = 0;
 
@@ -30,7 +30,9 @@
 #include "runtime/NativeFunctionObject.h"
 #include "runtime/ExtendedNativeFunctionObject.h"
 #include "runtime/PromiseObject.h"
+#include "runtime/ScriptFunctionObject.h"
 #include "interpreter/ByteCodeInterpreter.h"
+#include "parser/Lexer.h"
 
 namespace Escargot {
 
@@ -854,7 +856,7 @@ static Value builtinArrayJoin(ExecutionState& state, Value thisValue, size_t arg
     }
     ToStringRecursionPreventerItemAutoHolder holder(state, thisBinded);
 
-    StringBuilder builder;
+    StringBuilder builder(StringBuilder::ContiguousBufferMode);
     int64_t prevIndex = 0;
     int64_t curIndex = 0;
     while (curIndex < len) {
@@ -975,6 +977,180 @@ static Value builtinArrayReverse(ExecutionState& state, Value thisValue, size_t
     return O;
 }
 
+struct SortComparatorToken {
+    enum Kind : uint8_t {
+        Identifier,
+        Arrow,
+        Punctuator,
+    };
+    Kind m_kind;
+    char m_punctuator;
+    size_t m_start;
+    size_t m_length;
+};
+
+// tokenize a short comparator source. anything outside ASCII identifiers and
+// the few punctuators the recognized shapes use (comments, literals, escapes) fails
+static bool tokenizeSortComparator(const StringBufferAccessData& src, SortComparatorToken* tokens, size_t tokensCapacity, size_t& tokenCount)
+{
+    tokenCount = 0;
+    size_t i = 0;
+    while (i < src.length) {
+        char16_t c = src.charAt(i);
+        if (EscargotLexer::isWhiteSpaceOrLineTerminator(c)) {
+            i++;
+            continue;
+        }
+        if (tokenCount == tokensCapacity) {
+            return false;
+        }
+        SortComparatorToken& token = tokens[tokenCount++];
+        token.m_start = i;
+        if (c == '_' || c == '$' || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z')) {
+            while (i < src.length) {
+                c = src.charAt(i);
+                if (!(c == '_' || c == '$' || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9'))) {
+                    break;
+                }
+                i++;
+            }
+            token.m_kind = SortComparatorToken::Identifier;
+        } else if (c == '=' && i + 1 < src.length && src.charAt(i + 1) == '>') {
+            token.m_kind = SortComparatorToken::Arrow;
+            i += 2;
+        } else if (c == '(' || c == ')' || c == '{' || c == '}' || c == ',' || c == '.' || c == '-' || c == ';') {
+            token.m_kind = SortComparatorToken::Punctuator;
+            token.m_punctuator = (char)c;
+            i++;
+        } else {
+            return false;
+        }
+        token.m_length = i - token.m_start;
+    }
+    return true;
+}
+
+static bool isSortComparatorIdentifier(const StringBufferAccessData& src, const SortComparatorToken& token, const char* name)
+{
+    if (token.m_kind != SortComparatorToken::Identifier || token.m_length != strlen(name)) {
+        return false;
+    }
+    for (size_t i = 0; i < token.m_length; i++) {
+        if (src.charAt(token.m_start + i) != (char16_t)name[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool isSortComparatorIdentifier(const StringBufferAccessData& src, const SortComparatorToken& token, const AtomicString& name)
+{
+    String* str = name.string();
+    if (token.m_kind != SortComparatorToken::Identifier || token.m_length != str->length()) {
+        return false;
+    }
+    for (size_t i = 0; i < token.m_length; i++) {
+        if (src.charAt(token.m_start + i) != str->charAt(i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool isSortComparatorPunctuator(const SortComparatorToken& token, char punctuator)
+{
+    return token.m_kind == SortComparatorToken::Punctuator && token.m_punctuator == punctuator;
+}
+
+// recognize comparators whose whole body is `a - b`, `b - a`, `a.x - b.x` or `b.x - a.x`,
+// written as an arrow function or as `{ return ...; }`.
+// these compare exactly like a native numeric order as long as every key is a non-NaN number
+static Optional<ArrayObject::NativeSortOrder> recognizeSortComparator(ExecutionState& state, const Value& cmpfn)
+{
+    if (!cmpfn.isObject() || !cmpfn.asObject()->isScriptFunctionObject() || cmpfn.asObject()->isScriptClassConstructorFunctionObject()) {
+        return NullOption;
+    }
+
+    InterpretedCodeBlock* codeBlock = cmpfn.asObject()->asScriptFunctionObject()->interpretedCodeBlock();
+    if (codeBlock->isAsyncOrGenerator() || codeBlock->parameterCount() != 2 || codeBlock->hasParameterOtherThanIdentifier()
+        || codeBlock->parameterNames()[0] == codeBlock->parameterNames()[1]) {
+        return NullOption;
+    }
+
+    const size_t tokensCapacity = 24;
+    SortComparatorToken tokens[tokensCapacity];
+    size_t tokenCount;
+    auto src = codeBlock->src().bufferAccessData();
+    if (!tokenizeSortComparator(src, tokens, tokensCapacity, tokenCount)) {
+        return NullOption;
+    }
+
+    // parameters are plain identifiers, so the first ')' closes the parameter list
+    size_t cursor = 0;
+    while (cursor < tokenCount && !isSortComparatorPunctuator(tokens[cursor], ')')) {
+        cursor++;
+    }
+    cursor++;
+
+    size_t end = tokenCount;
+    bool hasBlock = true;
+    if (cursor < end && tokens[cursor].m_kind == SortComparatorToken::Arrow) {
+        cursor++;
+        hasBlock = cursor < end && isSortComparatorPunctuator(tokens[cursor], '{');
+    }
+    if (hasBlock) {
+        if (end - cursor < 3 || !isSortComparatorPunctuator(tokens[cursor], '{') || !isSortComparatorIdentifier(src, tokens[cursor + 1], "return")
+            || !isSortComparatorPunctuator(tokens[end - 1], '}')) {
+            return NullOption;
+        }
+        // `return` followed by a line terminator returns undefined
+        for (size_t i = tokens[cursor + 1].m_start + tokens[cursor + 1].m_length; i < tokens[cursor + 2].m_start; i++) {
+            if (EscargotLexer::isLineTerminator(src.charAt(i))) {
+                return NullOption;
+            }
+        }
+        cursor += 2;
+        end--;
+        if (end > cursor && isSortComparatorPunctuator(tokens[end - 1], ';')) {
+            end--;
+        }
+    }
+
+    const AtomicString& first = codeBlock->parameterNames()[0];
+    const AtomicString& second = codeBlock->parameterNames()[1];
+    size_t length = end - cursor;
+    SortComparatorToken* expr = tokens + cursor;
+    if (length == 3 && isSortComparatorPunctuator(expr[1], '-')) {
+        if (isSortComparatorIdentifier(src, expr[0], first) && isSortComparatorIdentifier(src, expr[2], second)) {
+            return ArrayObject::NativeSortOrder(ArrayObject::NativeSortOrder::ByNumber, false);
+        }
+        if (isSortComparatorIdentifier(src, expr[0], second) && isSortComparatorIdentifier(src, expr[2], first)) {
+            return ArrayObject::NativeSortOrder(ArrayObject::NativeSortOrder::ByNumber, true);
+        }
+    } else if (length == 7 && isSortComparatorPunctuator(expr[1], '.') && isSortComparatorPunctuator(expr[3], '-') && isSortComparatorPunctuator(expr[5], '.')
+               && expr[2].m_kind == SortComparatorToken::Identifier && expr[6].m_kind == SortComparatorToken::Identifier && expr[2].m_length == expr[6].m_length) {
+        for (size_t i = 0; i < expr[2].m_length; i++) {
+            if (src.charAt(expr[2].m_start + i) != src.charAt(expr[6].m_start + i)) {
+                return NullOption;
+            }
+        }
+        bool isDescending;
+        if (isSortComparatorIdentifier(src, expr[0], first) && isSortComparatorIdentifier(src, expr[4], second)) {
+            isDescending = false;
+        } else if (isSortComparatorIdentifier(src, expr[0], second) && isSortComparatorIdentifier(src, expr[4], first)) {
+            isDescending = true;
+        } else {
+            return NullOption;
+        }
+        std::string propertyName;
+        for (size_t i = 0; i < expr[2].m_length; i++) {
+            propertyName += (char)src.charAt(expr[2].m_start + i);
+        }
+        return ArrayObject::NativeSortOrder(ArrayObject::NativeSortOrder::ByNumberProperty, isDescending, AtomicString(state.context(), propertyName.data(), propertyName.length()));
+    }
+    return NullOption;
+}
+
 static Value builtinArraySort(ExecutionState& state, Value thisValue, size_t argc, Value* argv, Optional<Object*> newTarget)
 {
     Value cmpfn = argv[0];
@@ -986,6 +1162,18 @@ static Value builtinArraySort(ExecutionState& state, Value thisValue, size_t arg
     Object* thisObject = thisValue.toObject(state);
     uint64_t len = thisObject->length(state);
 
+    if (thisObject->isArrayObject() && thisObject->asArrayObject()->isFastModeArray()) {
+        Optional<ArrayObject::NativeSortOrder> order;
+        if (defaultSort) {
+            order = ArrayObject::NativeSortOrder(ArrayObject::NativeSortOrder::ByString);
+        } else {
+            order = recognizeSortComparator(state, cmpfn);
+        }
+        if (order && thisObject->asArrayObject()->sortFastModeElementsByNativeOrder(state, order.value())) {
+            return thisObject;
+        }
+    }
+
     thisObject->sort(state, len, [defaultSort, &cmpfn, &state](const Value& a, const Value& b) -> bool {
         if (a.isEmpty() && b.isUndefined())
             return false;
@@ -1007,6 +1195,23 @@ static Value builtinArraySort(ExecutionState& state, Value thisValue, size_t arg
     return thisObject;
 }
 
+// the iteration builtins below read elements straight from fast-mode storage
+// while this holds, instead of doing [[HasProperty]]/[[Get]] per index. a hole
+// then means "not present", which is only true while no prototype object has
+// an indexed property and O sits directly on Array.prototype (see the note in
+// builtinArrayConcat). user callbacks can change any of this, so callers
+// re-check before each element
+static ALWAYS_INLINE bool canReadFastModeElements(ExecutionState& state, Object* O, int64_t len)
+{
+    if (!O->isArrayObject()) {
+        return false;
+    }
+    ArrayObject* arr = O->asArrayObject();
+    return arr->isFastModeArray() && (uint64_t)len <= arr->fastModeArrayLength()
+        && !state.context()->vmInstance()->didSomePrototypeObjectDefineIndexedProperty()
+        && arr->getPrototypeObject(state) == state.context()->globalObject()->arrayPrototype();
+}
+
 static Value builtinArraySplice(ExecutionState& state, Value thisValue, size_t argc, Value* argv, Optional<Object*> newTarget)
 {
     // TODO(ES6): the number of actual arguments is used.
@@ -1048,6 +1253,41 @@ static Value builtinArraySplice(ExecutionState& state, Value thisValue, size_t a
     // Let A be ArraySpeciesCreate(O, actualDeleteCount).
     Object* A = arraySpeciesCreate(state, O, actualDeleteCount);
 
+    // fast path: no user code runs below, so the whole splice can work on the
+    // raw storage of O and A once the guards hold
+    if (canReadFastModeElements(state, O, len) && A->isArrayObject() && A != O) {
+        ArrayObject* arrayO = O->asArrayObject();
+        ArrayObject* arrayA = A->asArrayObject();
+        int64_t newLength = len - actualDeleteCount + insertCount;
+        if (arrayO->isLengthPropertyWritableDirect() && (newLength <= len || arrayO->isExtensible(state))
+            && newLength < (int64_t)(std::numeric_limits<uint32_t>::max() / 2)
+            && arrayA->isFastModeArray() && arrayA->isExtensible(state) && arrayA->isLengthPropertyWritableDirect() && arrayA->fastModeArrayLength() == actualDeleteCount) {
+            if (newLength > len) {
+                // the gap is filled by the inserted items below, so O stays in fast mode
+                arrayO->setArrayLengthDirect(state, (uint32_t)newLength, false, false);
+                ASSERT(arrayO->isFastModeArray());
+            }
+            arrayA->copyFastModeElementsFrom(state, arrayO, (uint32_t)actualStart, 0, (uint32_t)actualDeleteCount);
+            // holes move as holes, like the Delete steps of the generic loops
+            if (insertCount < actualDeleteCount) {
+                for (int64_t k = actualStart; k < len - actualDeleteCount; k++) {
+                    arrayO->setFastModeValue(k + insertCount, arrayO->getFastModeValue(k + actualDeleteCount));
+                }
+            } else if (insertCount > actualDeleteCount) {
+                for (int64_t k = len - actualDeleteCount; k > actualStart; k--) {
+                    arrayO->setFastModeValue(k + insertCount - 1, arrayO->getFastModeValue(k + actualDeleteCount - 1));
+                }
+            }
+            for (int64_t i = 0; i < insertCount; i++) {
+                arrayO->setFastModeValue(actualStart + i, argv[i + 2]);
+            }
+            if (newLength < len) {
+                arrayO->setArrayLengthDirect(state, (uint32_t)newLength);
+            }
+            return A;
+        }
+    }
+
     // Let k be 0.
     int64_t k = 0;
 
@@ -1414,6 +1654,15 @@ static Value builtinArrayForEach(ExecutionState& state, Value thisValue, size_t
         T = argv[1];
 
     int64_t k = 0;
+    while (k < len && canReadFastModeElements(state, thisObject, len)) {
+        Value kValue = thisObject->asArrayObject()->getFastModeValue(k);
+        if (LIKELY(!kValue.isEmpty())) {
+            Value args[3] = { kValue, Value(k), thisObject };
+            Object::call(state, callbackfn, T, 3, args);
+        }
+        k++;
+    }
+
     while (k < len) {
         Value Pk = Value(k);
         auto res = thisObject->hasProperty(state, ObjectPropertyName(state, Pk));
@@ -1590,6 +1839,17 @@ static Value builtinArrayEvery(ExecutionState& state, Value thisValue, size_t ar
     // Let k be 0.
     int64_t k = 0;
 
+    while (k < len && canReadFastModeElements(state, O, len)) {
+        Value kValue = O->asArrayObject()->getFastModeValue(k);
+        if (LIKELY(!kValue.isEmpty())) {
+            Value args[] = { kValue, Value(k), O };
+            if (!Object::call(state, callbackfn, T, 3, args).toBoolean()) {
+                return Value(false);
+            }
+        }
+        k++;
+    }
+
     while (k < len) {
         // Let Pk be ToString(k).
         // Let kPresent be the result of calling the [[HasProperty]] internal method of O with argument Pk.
@@ -1680,6 +1940,23 @@ static Value builtinArrayFilter(ExecutionState& state, Value thisValue, size_t a
     int64_t k = 0;
     // Let to be 0.
     int64_t to = 0;
+
+    while (k < len && canReadFastModeElements(state, O, len)) {
+        Value kValue = O->asArrayObject()->getFastModeValue(k);
+        if (LIKELY(!kValue.isEmpty())) {
+            Value v[] = { kValue, Value(k), O };
+            if (Object::call(state, callbackfn, T, 3, v).toBoolean()) {
+                // appending to a fast-mode A is CreateDataPropertyOrThrow(A, to, kValue)
+                if (!A->isArrayObject() || !A->asArrayObject()->isFastModeArray() || A->asArrayObject()->fastModeArrayLength() != to
+                    || !A->isExtensible(state) || !A->asArrayObject()->pushIntoFastModeElements(state, &kValue, 1)) {
+                    A->defineOwnPropertyThrowsException(state, ObjectPropertyName(state, Value(to)), ObjectPropertyDescriptor(kValue, ObjectPropertyDescriptor::AllPresent));
+                }
+                to++;
+            }
+        }
+        k++;
+    }
+
     // Repeat, while k < len
     while (k < len) {
         // Let Pk be ToString(k).
@@ -1744,13 +2021,13 @@ static Value builtinArrayMap(ExecutionState& state, Value thisValue, size_t argc
     if (O->isArrayObject() && A->isArrayObject()) {
         auto* arrayO = static_cast<ArrayObject*>(O);
         auto* arrayA = static_cast<ArrayObject*>(A);
-        if (LIKELY(arrayO->isFastModeArray() && arrayA->isFastModeArray() && arrayO->isLengthPropertyWritableDirect() && arrayA->isLengthPropertyWritableDirect())) {
+        if (LIKELY(canReadFastModeElements(state, O, len) && arrayA->isFastModeArray() && arrayO->isLengthPropertyWritableDirect() && arrayA->isLengthPropertyWritableDirect())) {
             // fast path
             arrayA->setArrayLengthDirect(state, len, false, false, false); // clearNewSlots = false since we will write them!
 
             bool bailedOut = false;
             while (k < len) {
-                if (UNLIKELY(!arrayO->isFastModeArray() || !arrayA->isFastModeArray() || arrayO->fastModeArrayLength() != len || arrayA->fastModeArrayLength() != len)) {
+                if (UNLIKELY(!canReadFastModeElements(state, O, len) || !arrayA->isFastModeArray() || arrayA->fastModeArrayLength() != len)) {
                     bailedOut = true;
                     break;
                 }
@@ -1758,7 +2035,7 @@ static Value builtinArrayMap(ExecutionState& state, Value thisValue, size_t argc
                 if (LIKELY(!kValue.isEmpty())) {
                     Value v[] = { kValue, Value(k), O };
                     Value mappedValue = Object::call(state, callbackfn, T, 3, v);
-                    if (UNLIKELY(!arrayO->isFastModeArray() || !arrayA->isFastModeArray() || arrayO->fastModeArrayLength() != len || arrayA->fastModeArrayLength() != len)) {
+                    if (UNLIKELY(!canReadFastModeElements(state, O, len) || !arrayA->isFastModeArray() || arrayA->fastModeArrayLength() != len)) {
                         A->defineOwnPropertyThrowsException(state, ObjectPropertyName(state, Value(k)), ObjectPropertyDescriptor(mappedValue, ObjectPropertyDescriptor::AllPresent));
                         k++;
                         bailedOut = true;
@@ -1825,6 +2102,18 @@ static Value builtinArraySome(ExecutionState& state, Value thisValue, size_t arg
 
     // Let k be 0.
     int64_t k = 0;
+
+    while (k < len && canReadFastModeElements(state, O, len)) {
+        Value kValue = O->asArrayObject()->getFastModeValue(k);
+        if (LIKELY(!kValue.isEmpty())) {
+            Value args[] = { kValue, Value(k), O };
+            if (Object::call(state, callbackfn, T, 3, args).toBoolean()) {
+                return Value(true);
+            }
+        }
+        k++;
+    }
+
     // Repeat, while k < len
     while (k < len) {
         // Let Pk be ToString(k).
@@ -1996,6 +2285,14 @@ static Value builtinArrayReduce(ExecutionState& state, Value thisValue, size_t a
         if (!kPresent)
             ErrorObject::throwBuiltinError(state, ErrorCode::TypeError, state.context()->staticStrings().Array.string(), true, state.context()->staticStrings().reduce.string(), ErrorObject::Messages::GlobalObject_ReduceError);
     }
+    while (k < len && canReadFastModeElements(state, O, len)) {
+        Value kValue = O->asArrayObject()->getFastModeValue(k);
+        if (LIKELY(!kValue.isEmpty())) {
+            Value fnargs[] = { accumulator, kValue, Value(k), O };
+            accumulator = Object::call(state, callbackfn, Value(), 4, fnargs);
+        }
+        k++;
+    }
     while (k < len) { // 9
         ObjectHasPropertyResult kPresent = O->hasIndexedProperty(state, Value(k)); // 9.b
         if (kPresent) { // 9.c
@@ -2070,6 +2367,15 @@ static Value builtinArrayReduceRight(ExecutionState& state, Value thisValue, siz
         }
     }
 
+    while (k >= 0 && canReadFastModeElements(state, O, len)) {
+        Value kValue = O->asArrayObject()->getFastModeValue(k);
+        if (LIKELY(!kValue.isEmpty())) {
+            Value v[] = { accumulator, kValue, Value(k), O };
+            accumulator = Object::call(state, callbackfn, Value(), 4, v);
+        }
+        k--;
+    }
+
     // Repeat, while k ≥ 0
     while (k >= 0) {
         // Let Pk be ToString(k).
@@ -2416,6 +2722,18 @@ static Value builtinArrayFind(ExecutionState& state, Value thisValue, size_t arg
 
     // Let k be 0.
     uint64_t k = 0;
+    // find reads holes as undefined
+    while (k < len && canReadFastModeElements(state, O, len)) {
+        Value kValue = O->asArrayObject()->getFastModeValue(k);
+        if (UNLIKELY(kValue.isEmpty())) {
+            kValue = Value();
+        }
+        Value v[] = { kValue, Value(k), O };
+        if (Object::call(state, predicate, thisArg, 3, v).toBoolean()) {
+            return kValue;
+        }
+        k++;
+    }
     // Repeat, while k < len
     while (k < len) {
         // Let Pk be ! ToString(k).
@@ -2451,6 +2769,17 @@ static Value builtinArrayFindIndex(ExecutionState& state, Value thisValue, size_
 
     // Let k be 0.
     uint64_t k = 0;
+    while (k < len && canReadFastModeElements(state, O, len)) {
+        Value kValue = O->asArrayObject()->getFastModeValue(k);
+        if (UNLIKELY(kValue.isEmpty())) {
+            kValue = Value();
+        }
+        Value v[] = { kValue, Value(k), O };
+        if (Object::call(state, predicate, thisArg, 3, v).toBoolean()) {
+            return Value(k);
+        }
+        k++;
+    }
     // Repeat, while k < len
     while (k < len) {
         // Let Pk be ! ToString(k).
@@ -133,7 +133,7 @@ static Value builtinArrayBufferResize(ExecutionState& state, Value thisValue, si
         ErrorObject::throwBuiltinError(state, ErrorCode::RangeError, state.context()->staticStrings().ArrayBuffer.string(), true, state.context()->staticStrings().resize.string(), ErrorObject::Messages::GlobalObject_FirstArgumentInvalidLength);
     }
 
-    obj->backingStore()->resize(static_cast<size_t>(newByteLength));
+    obj->resizeBackingStore(static_cast<size_t>(newByteLength));
 
     return Value();
 }
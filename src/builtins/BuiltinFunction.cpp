@@ -315,7 +315,6 @@ void GlobalObject::installFunction(ExecutionState& state)
         m_functionPrototype->directDefineOwnProperty(state, ObjectPropertyName(state.context()->staticStrings().arguments), desc);
     }
 
-    directDefineOwnProperty(state, ObjectPropertyName(state.context()->staticStrings().Function),
-                            ObjectPropertyDescriptor(m_function, (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::WritablePresent | ObjectPropertyDescriptor::ConfigurablePresent)));
+    defineBuiltinProperty(state, state.context()->staticStrings().Function, m_function);
 }
 } // namespace Escargot
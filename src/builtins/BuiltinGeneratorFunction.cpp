@@ -105,7 +105,7 @@ void GlobalObject::installGenerator(ExecutionState& state)
     // The initial value of Generator.prototype.constructor is the intrinsic object %Generator%.
     m_generatorPrototype->directDefineOwnProperty(state, ObjectPropertyName(state.context()->staticStrings().constructor), ObjectPropertyDescriptor(m_generator, ObjectPropertyDescriptor::ConfigurablePresent));
 
-    m_generatorPrototype->defineBuiltinFunction(state, state.context()->staticStrings().next, builtinGeneratorNext, 1);
+    m_generatorPrototypeNext = m_generatorPrototype->defineBuiltinFunction(state, state.context()->staticStrings().next, builtinGeneratorNext, 1);
     m_generatorPrototype->defineBuiltinFunction(state, state.context()->staticStrings().stringReturn, builtinGeneratorReturn, 1);
     m_generatorPrototype->defineBuiltinFunction(state, state.context()->staticStrings().stringThrow, builtinGeneratorThrow, 1);
     // http://www.ecma-international.org/ecma-262/6.0/#sec-generatorfunction.prototype-@@tostringtag
@@ -1166,7 +1166,6 @@ void GlobalObject::installIterator(ExecutionState& state)
 
     m_iteratorPrototype->defineBuiltinFunction(state, strings->flatMap, builtinIteratorFlatMap, 1);
 
-    directDefineOwnProperty(state, ObjectPropertyName(strings->Iterator),
-                            ObjectPropertyDescriptor(m_iterator, (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::WritablePresent | ObjectPropertyDescriptor::ConfigurablePresent)));
+    defineBuiltinProperty(state, strings->Iterator, m_iterator);
 }
 } // namespace Escargot
@@ -949,8 +949,7 @@ void GlobalObject::installObject(ExecutionState& state)
     ObjectPropertyDescriptor __proto__desc(gs, ObjectPropertyDescriptor::ConfigurablePresent);
     m_objectPrototype->directDefineOwnProperty(state, ObjectPropertyName(strings.__proto__), __proto__desc);
 
-    directDefineOwnProperty(state, ObjectPropertyName(strings.Object),
-                            ObjectPropertyDescriptor(m_object, (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::WritablePresent | ObjectPropertyDescriptor::ConfigurablePresent)));
+    defineBuiltinProperty(state, strings.Object, m_object);
 
     m_objectPrototypeToString = new NativeFunctionObject(state, NativeFunctionInfo(strings.toString, builtinObjectToString, 0, NativeFunctionInfo::Strict));
 }
@@ -137,6 +137,7 @@ static Value builtinSetForEach(ExecutionState& state, Value thisValue, size_t ar
         T = argv[1];
     }
     // Let entries be the List that is the value of S's [[SetData]] internal slot.
+    SetObject::CompactionBlocker blocker(S);
     const SetObject::SetObjectData& entries = S->storage();
     // Repeat for each e that is an element of entries, in original insertion order
     for (size_t i = 0; i < entries.size(); i++) {
@@ -297,6 +298,8 @@ static Value builtinSetIntersection(ExecutionState& state, Value thisValue, size
 
     // 5. If SetDataSize(O.[[SetData]]) ≤ otherRec.[[Size]], then
     if (setDataSize(state, O->storage()) <= otherRec.size) {
+        // indexes into O.[[SetData]] must stay put while otherRec.[[Has]] runs
+        SetObject::CompactionBlocker blocker(O);
         // a. Let thisSize be the number of elements in O.[[SetData]].
         auto thisSize = O->storage().size();
         // b. Let index be 0.
@@ -372,6 +375,8 @@ static Value builtinSetIsDisjointFrom(ExecutionState& state, Value thisValue, si
     SetRecord otherRec = getSetRecord(state, argv[0]);
     // 4. If SetDataSize(O.[[SetData]]) ≤ otherRec.[[Size]], then
     if (setDataSize(state, O->storage()) <= otherRec.size) {
+        // indexes into O.[[SetData]] must stay put while otherRec.[[Has]] runs
+        SetObject::CompactionBlocker blocker(O);
         // a. Let thisSize be the number of elements in O.[[SetData]].
         auto thisSize = O->storage().size();
         // b. Let index be 0.
@@ -501,6 +506,8 @@ static Value builtinSetIsSubsetOf(ExecutionState& state, Value thisValue, size_t
         return Value(false);
     }
 
+    // indexes into O.[[SetData]] must stay put while otherRec.[[Has]] runs
+    SetObject::CompactionBlocker blocker(O);
     // 5. Let thisSize be the number of elements in O.[[SetData]].
     size_t thisSize = O->storage().size();
     // 6. Let index be 0.
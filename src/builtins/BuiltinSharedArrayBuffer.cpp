@@ -102,7 +102,7 @@ static Value builtinSharedArrayBufferGrow(ExecutionState& state, Value thisValue
         ErrorObject::throwBuiltinError(state, ErrorCode::RangeError, state.context()->staticStrings().SharedArrayBuffer.string(), true, state.context()->staticStrings().grow.string(), ErrorObject::Messages::GlobalObject_FirstArgumentInvalidLength);
     }
 
-    O->backingStore()->resize(static_cast<size_t>(newByteLength));
+    O->resizeBackingStore(static_cast<size_t>(newByteLength));
     return Value();
 }
 
@@ -333,7 +333,7 @@ static Value builtinStringRepeat(ExecutionState& state, Value thisValue, size_t
 
     repeatCount = static_cast<int32_t>(count);
 
-    StringBuilder builder;
+    StringBuilder builder(StringBuilder::ContiguousBufferMode);
     for (int i = 0; i < repeatCount; i++) {
         builder.appendString(str);
     }
@@ -610,7 +610,7 @@ static Value builtinStringReplaceAll(ExecutionState& state, Value thisValue, siz
     }
     size_t endOfLastMatch = 0;
 
-    StringBuilder builder;
+    StringBuilder builder(StringBuilder::ContiguousBufferMode);
     String* replacement = String::emptyString();
     // For each element p of matchPositions, do
     for (size_t i = 0; i < matchPositions.size(); i++) {
@@ -1350,23 +1350,23 @@ static Value stringPad(ExecutionState& state, String* S, size_t argc, Value* arg
     // Let fillLen be intMaxLength - stringLength.
     uint64_t fillLen = intMaxLength - stringLength;
 
-    // Let truncatedStringFiller be a new String value consisting of repeated concatenations of filler truncated to length fillLen.
-    StringBuilder sb;
-    while (sb.contentLength() < fillLen) {
-        sb.appendString(filler);
+    // Return a new String value computed by the concatenation of truncatedStringFiller and S.
+    StringBuilder sb(StringBuilder::ContiguousBufferMode);
+    if (!isPadStart) {
+        sb.appendString(S, &state);
     }
 
-    // Build the string, than truncate the characters over fillLen
-    String* truncatedStringFiller = sb.finalize(&state);
-    truncatedStringFiller = truncatedStringFiller->substring(0, fillLen, &state);
+    // Let truncatedStringFiller be a new String value consisting of repeated concatenations of filler truncated to length fillLen.
+    // (written straight into the result instead of building it separately)
+    uint64_t remainingFillLen = fillLen;
+    while (remainingFillLen >= filler->length()) {
+        sb.appendString(filler, &state);
+        remainingFillLen -= filler->length();
+    }
+    sb.appendSubString(filler, 0, remainingFillLen, &state);
 
-    // Return a new String value computed by the concatenation of truncatedStringFiller and S.
     if (isPadStart) {
-        sb.appendString(truncatedStringFiller);
-        sb.appendString(S);
-    } else {
-        sb.appendString(S);
-        sb.appendString(truncatedStringFiller);
+        sb.appendString(S, &state);
     }
     return sb.finalize(&state);
 }
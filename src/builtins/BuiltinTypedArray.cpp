@@ -256,7 +256,6 @@ static void initializeTypedArrayFromTypedArray(ExecutionState& state, TypedArray
     TypedArrayObject::validateTypedArray(state, srcArray);
 
     size_t elementLength = srcArray->arrayLength();
-    size_t srcElementSize = srcArray->elementSize();
     size_t srcByteOffset = srcArray->byteOffset();
     size_t elementSize = obj->elementSize();
     uint64_t byteLength = static_cast<uint64_t>(elementSize) * elementLength;
@@ -272,26 +271,23 @@ static void initializeTypedArrayFromTypedArray(ExecutionState& state, TypedArray
         data = ArrayBufferObject::allocateArrayBuffer(state, bufferConstructor.asObject(), byteLength);
         // If IsDetachedBuffer(srcData) is true, throw a TypeError exception.
         srcData->throwTypeErrorIfDetached(state);
+        // If srcArray.[[ContentType]] is not O.[[ContentType]], throw a TypeError exception.
+        bool isSrcBigIntArray = srcArray->typedArrayType() == TypedArrayType::BigInt64 || srcArray->typedArrayType() == TypedArrayType::BigUint64;
+        bool isBigIntArray = obj->typedArrayType() == TypedArrayType::BigInt64 || obj->typedArrayType() == TypedArrayType::BigUint64;
+        if (isSrcBigIntArray != isBigIntArray) {
+            ErrorObject::throwBuiltinError(state, ErrorCode::TypeError, state.context()->staticStrings().TypedArray.string(), false, String::emptyString(), "Cannot mix BigIntArray with other Array");
+        }
 
         // Let srcByteIndex be srcByteOffset.
-        size_t srcByteIndex = srcByteOffset;
         // Let targetByteIndex be 0.
-        size_t targetByteIndex = 0;
         // Let count be elementLength.
-        size_t count = elementLength;
         // Repeat, while count > 0
-        while (count > 0) {
-            // Let value be GetValueFromBuffer(srcData, srcByteIndex, srcType).
-            Value value = srcData->getValueFromBuffer(state, srcByteIndex, srcArray->typedArrayType());
-            // Perform SetValueInBuffer(data, targetByteIndex, elementType, value).
-            data->setValueInBuffer(state, targetByteIndex, obj->typedArrayType(), value);
-            // Set srcByteIndex to srcByteIndex + srcElementSize.
-            srcByteIndex += srcElementSize;
-            // Set targetByteIndex to targetByteIndex + elementSize.
-            targetByteIndex += elementSize;
-            // Decrement count by 1.
-            count--;
-        }
+        //   Let value be GetValueFromBuffer(srcData, srcByteIndex, srcType).
+        //   Perform SetValueInBuffer(data, targetByteIndex, elementType, value).
+        //   Set srcByteIndex to srcByteIndex + srcElementSize.
+        //   Set targetByteIndex to targetByteIndex + elementSize.
+        //   Decrement count by 1.
+        TypedArrayObject::convertElements(state, srcArray->typedArrayType(), srcData->data() + srcByteOffset, obj->typedArrayType(), data->data(), elementLength);
     }
     // Set O’s [[ViewedArrayBuffer]] internal slot to data.
     // Set O’s [[ByteLength]] internal slot to byteLength.
@@ -500,32 +496,21 @@ static Value builtinTypedArrayCopyWithin(ExecutionState& state, Value thisValue,
         // Let countBytes be count × elementSize.
         size_t countBytes = count * elementSize;
 
-        int8_t direction = 0;
         // If fromByteIndex < toByteIndex and toByteIndex < fromByteIndex + countBytes, then
-        if (fromByteIndex < toByteIndex && toByteIndex < fromByteIndex + countBytes) {
-            // Let direction be -1.
-            direction = -1;
-            // Set fromByteIndex to fromByteIndex + countBytes - 1.
-            fromByteIndex = fromByteIndex + countBytes - 1;
-            // Set toByteIndex to toByteIndex + countBytes - 1.
-            toByteIndex = toByteIndex + countBytes - 1;
-        } else {
-            // Let direction be 1.
-            direction = 1;
-        }
-
+        //   Let direction be -1.
+        //   Set fromByteIndex to fromByteIndex + countBytes - 1.
+        //   Set toByteIndex to toByteIndex + countBytes - 1.
+        // Else,
+        //   Let direction be 1.
         // Repeat, while countBytes > 0,
-        while (countBytes > 0) {
-            // Let value be GetValueFromBuffer(buffer, fromByteIndex, uint8, true, unordered).
-            Value value = buffer->getValueFromBuffer(state, fromByteIndex, TypedArrayType::Uint8);
-            // Perform SetValueInBuffer(buffer, toByteIndex, uint8, value, true, unordered).
-            buffer->setValueInBuffer(state, toByteIndex, TypedArrayType::Uint8, value);
-            // Set fromByteIndex to fromByteIndex + direction.
-            fromByteIndex += direction;
-            // Set toByteIndex to toByteIndex + direction.
-            toByteIndex += direction;
-            // Set countBytes to countBytes - 1.
-            countBytes--;
+        //   Let value be GetValueFromBuffer(buffer, fromByteIndex, uint8, true, unordered).
+        //   Perform SetValueInBuffer(buffer, toByteIndex, uint8, value, true, unordered).
+        //   Set fromByteIndex to fromByteIndex + direction.
+        //   Set toByteIndex to toByteIndex + direction.
+        //   Set countBytes to countBytes - 1.
+        // NOTE: memmove picks the copy direction the same way
+        if (countBytes) {
+            memmove(buffer->data() + toByteIndex, buffer->data() + fromByteIndex, countBytes);
         }
     }
 
@@ -533,112 +518,6 @@ static Value builtinTypedArrayCopyWithin(ExecutionState& state, Value thisValue,
     return O;
 }
 
-template <const bool isForward>
-static Value fastTypedArrayIndexSearch(TypedArrayObject* arr, size_t k, size_t len, const Value& value)
-{
-    auto type = arr->typedArrayType();
-    if (type == TypedArrayType::BigInt64 || type == TypedArrayType::BigUint64) {
-        if (!value.isBigInt()) {
-            return Value(-1);
-        }
-    } else if (UNLIKELY(!value.isNumber())) {
-        return Value(-1);
-    } else if (UNLIKELY(arr->rawBuffer() == nullptr)) {
-        return Value(-1);
-    }
-
-    uint8_t* buffer = arr->rawBuffer();
-    auto elementSize = arr->elementSize();
-    int64_t byteK = static_cast<int64_t>(k) * elementSize;
-    int64_t byteLength = static_cast<int64_t>(len) * elementSize;
-
-    auto compFn = [](int64_t byteK, int64_t byteLength) -> bool {
-        if (isForward) {
-            return byteK < byteLength;
-        } else {
-            return byteK >= 0;
-        }
-    };
-
-    auto updateFn = [](int64_t& byteK, const int diff) {
-        if (isForward) {
-            byteK += diff;
-        } else {
-            byteK -= diff;
-        }
-    };
-
-    if (!isForward && byteK >= byteLength) {
-        byteK = byteLength - elementSize;
-    }
-
-    if (type == TypedArrayType::BigInt64 || type == TypedArrayType::BigUint64) {
-        uint64_t argv0ToUint64 = type == TypedArrayType::BigInt64 ? bitwise_cast<uint64_t>(value.asBigInt()->toInt64()) : value.asBigInt()->toUint64();
-        while (compFn(byteK, byteLength)) {
-            if (*reinterpret_cast<uint64_t*>(&buffer[byteK]) == argv0ToUint64) {
-                return Value(byteK / elementSize);
-            }
-            updateFn(byteK, 8);
-        }
-    } else if (type == TypedArrayType::Float16) {
-        double num = value.asNumber();
-        if (std::isnan(num)) {
-            return Value(-1);
-        }
-        while (compFn(byteK, byteLength)) {
-            double c = convertFloat16ToFloat64(*reinterpret_cast<uint16_t*>(&buffer[byteK]));
-            if (c == num) {
-                return Value(byteK / elementSize);
-            }
-            updateFn(byteK, 2);
-        }
-    } else if (type == TypedArrayType::Float32) {
-        double num = value.asNumber();
-        if (std::isnan(num)) {
-            return Value(-1);
-        }
-        while (compFn(byteK, byteLength)) {
-            double c = *reinterpret_cast<float*>(&buffer[byteK]);
-            if (c == num) {
-                return Value(byteK / elementSize);
-            }
-            updateFn(byteK, 4);
-        }
-    } else if (type == TypedArrayType::Float64) {
-        double num = value.asNumber();
-        if (std::isnan(num)) {
-            return Value(-1);
-        }
-        while (compFn(byteK, byteLength)) {
-            const double& c = *reinterpret_cast<double*>(&buffer[byteK]);
-            if (c == num) {
-                return Value(byteK / elementSize);
-            }
-            updateFn(byteK, 8);
-        }
-    } else {
-        int32_t argv0ToUint32;
-        if (value.isDouble()) {
-            if (value.asDouble() == -0.0) {
-                argv0ToUint32 = 0;
-            } else {
-                return Value(-1);
-            }
-        } else {
-            argv0ToUint32 = value.asInt32();
-        }
-
-        while (compFn(byteK, byteLength)) {
-            if (memcmp(&buffer[byteK], &argv0ToUint32, elementSize) == 0) {
-                return Value(byteK / elementSize);
-            }
-            updateFn(byteK, elementSize);
-        }
-    }
-
-    return Value(-1);
-}
-
 static Value builtinTypedArrayIndexOf(ExecutionState& state, Value thisValue, size_t argc, Value* argv, Optional<Object*> newTarget)
 {
     TypedArrayObject::validateTypedArray(state, thisValue);
@@ -681,7 +560,7 @@ static Value builtinTypedArrayIndexOf(ExecutionState& state, Value thisValue, si
     size_t k = (size_t)doubleK;
     // Reloading `len` because second argument can affect arrayLength
     len = std::min((size_t)O->arrayLength(), len);
-    return fastTypedArrayIndexSearch<true>(O, k, len, argv[0]);
+    return Value(O->indexOfElement(argv[0], k, len));
 }
 
 static Value builtinTypedArrayLastIndexOf(ExecutionState& state, Value thisValue, size_t argc, Value* argv, Optional<Object*> newTarget)
@@ -726,7 +605,7 @@ static Value builtinTypedArrayLastIndexOf(ExecutionState& state, Value thisValue
     }
     // Reloading `len` because second argument can affect arrayLength
     len = O->arrayLength();
-    return fastTypedArrayIndexSearch<false>(O, static_cast<int64_t>(k), len, argv[0]);
+    return Value(O->lastIndexOfElement(argv[0], static_cast<size_t>(k), len));
 }
 
 static Value builtinTypedArrayIncludes(ExecutionState& state, Value thisValue, size_t argc, Value* argv, Optional<Object*> newTarget)
@@ -765,15 +644,16 @@ static Value builtinTypedArrayIncludes(ExecutionState& state, Value thisValue, s
     size_t k = (size_t)doubleK;
 
     // Repeat, while k < len
-    while (k < len) {
-        // Let elementK be the result of ? Get(O, ! ToString(k)).
-        Value elementK = O->getIndexedPropertyValue(state, Value(k), O);
-        // If SameValueZero(searchElement, elementK) is true, return true.
-        if (elementK.equalsToByTheSameValueZeroAlgorithm(state, searchElement)) {
-            return Value(true);
-        }
-        // Increase k by 1.
-        k++;
+    //   Let elementK be the result of ? Get(O, ! ToString(k)).
+    //   If SameValueZero(searchElement, elementK) is true, return true.
+    //   Increase k by 1.
+    // NOTE: elements past a shrunk length read as undefined, which only matches an undefined searchElement
+    size_t currentLength = std::min(static_cast<size_t>(O->arrayLength()), len);
+    if (O->indexOfElement(searchElement, k, currentLength, true) >= 0) {
+        return Value(true);
+    }
+    if (searchElement.isUndefined() && std::max(k, currentLength) < len) {
+        return Value(true);
     }
 
     // Return false.
@@ -873,16 +753,13 @@ static void setTypedArrayFromTypedArray(ExecutionState& state, TypedArrayObject*
     } else {
         // Else,
         // Repeat, while targetByteIndex < limit,
-        while (targetByteIndex < limit) {
-            // Let value be GetValueFromBuffer(srcBuffer, srcByteIndex, srcType, true, unordered).
-            Value value = srcBuffer->getValueFromBuffer(state, srcByteIndex, srcType);
-            // Perform SetValueInBuffer(targetBuffer, targetByteIndex, targetType, value, true, unordered).
-            targetBuffer->setValueInBuffer(state, targetByteIndex, targetType, value);
-            // Set srcByteIndex to srcByteIndex + srcElementSize.
-            srcByteIndex += srcElementSize;
-            // Set targetByteIndex to targetByteIndex + targetElementSize.
-            targetByteIndex += targetElementSize;
-        }
+        //   Let value be GetValueFromBuffer(srcBuffer, srcByteIndex, srcType, true, unordered).
+        //   Perform SetValueInBuffer(targetBuffer, targetByteIndex, targetType, value, true, unordered).
+        //   Set srcByteIndex to srcByteIndex + srcElementSize.
+        //   Set targetByteIndex to targetByteIndex + targetElementSize.
+        // NOTE: srcBuffer was cloned above when it shares memory with targetBuffer
+        TypedArrayObject::convertElements(state, srcType, srcBuffer->data() + srcByteIndex, targetType,
+                                          targetBuffer->data() + static_cast<size_t>(targetByteIndex), srcLength);
     }
     // Return unused.
 }
@@ -1014,39 +891,19 @@ static Value builtinTypedArraySort(ExecutionState& state, Value thisValue, size_
     // Let len be the value of O’s [[ArrayLength]] internal slot.
     uint64_t len = O->arrayLength();
     bool defaultSort = (argc == 0) || cmpfn.isUndefined();
-    // [defaultSort, &cmpfn, &state, &buffer]
+    if (defaultSort) {
+        O->sortByDefaultOrder();
+        return O;
+    }
+    // [&cmpfn, &state]
     O->sort(state, len, [&](const Value& x, const Value& y) -> bool {
         ASSERT((x.isNumber() || x.isBigInt()) && (y.isNumber() || y.isBigInt()));
-        if (!defaultSort) {
-            Value args[] = { x, y };
-            double v = Object::call(state, cmpfn, Value(), 2, args).toNumber(state);
-            if (std::isnan(v)) {
-                return false;
-            }
-            return (v < 0);
-        } else {
-            if (LIKELY(x.isNumber())) {
-                double xNum = x.asNumber();
-                double yNum = y.asNumber();
-
-                // 22.2.3.25.3-10
-                if (std::isnan(xNum)) {
-                    return false;
-                }
-
-                if (std::isnan(yNum)) {
-                    return true;
-                }
-
-                if (xNum == 0.0 && xNum == yNum) {
-                    return std::signbit(xNum);
-                }
-
-                return xNum <= yNum;
-            } else {
-                return x.asBigInt()->lessThanEqual(y.asBigInt());
-            }
-        } });
+        Value args[] = { x, y };
+        double v = Object::call(state, cmpfn, Value(), 2, args).toNumber(state);
+        if (std::isnan(v)) {
+            return false;
+        }
+        return (v < 0); });
 
     return O;
 }
@@ -1069,39 +926,23 @@ static Value builtinTypedArrayToSorted(ExecutionState& state, Value thisValue, s
     Value arg[1] = { Value(len) };
     TypedArrayObject* A = typedArrayCreateSameType(state, O, 1, arg).asObject()->asTypedArrayObject();
 
-    // [defaultSort, &cmpfn, &state, &buffer]
+    if (defaultSort) {
+        if (len) {
+            memcpy(A->rawBuffer(), O->rawBuffer(), len * O->elementSize());
+            A->sortByDefaultOrder();
+        }
+        return A;
+    }
+
+    // [&cmpfn, &state]
     O->toSorted(state, A, len, [&](const Value& x, const Value& y) -> bool {
         ASSERT((x.isNumber() || x.isBigInt()) && (y.isNumber() || y.isBigInt()));
-        if (!defaultSort) {
-            Value args[] = { x, y };
-            double v = Object::call(state, cmpfn, Value(), 2, args).toNumber(state);
-            if (std::isnan(v)) {
-                return false;
-            }
-            return (v < 0);
-        } else {
-            if (LIKELY(x.isNumber())) {
-                double xNum = x.asNumber();
-                double yNum = y.asNumber();
-
-                // 22.2.3.25.3-10
-                if (std::isnan(xNum)) {
-                    return false;
-                }
-
-                if (std::isnan(yNum)) {
-                    return true;
-                }
-
-                if (xNum == 0.0 && xNum == yNum) {
-                    return std::signbit(xNum);
-                }
-
-                return xNum <= yNum;
-            } else {
-                return x.asBigInt()->lessThanEqual(y.asBigInt());
-            }
-        } });
+        Value args[] = { x, y };
+        double v = Object::call(state, cmpfn, Value(), 2, args).toNumber(state);
+        if (std::isnan(v)) {
+            return false;
+        }
+        return (v < 0); });
 
     return A;
 }
@@ -1314,16 +1155,17 @@ static Value builtinTypedArrayFill(ExecutionState& state, Value thisValue, size_
     len = O->arrayLength();
 
     // Set endIndex to min(endIndex, len).
-    double index = std::min(endIndex, len);
+    endIndex = std::min(endIndex, len);
     // Let k be startIndex.
-    auto k = startIndex;
     // Repeat, while k < endIndex,
-    while (k < endIndex) {
-        // Let Pk be ! ToString(𝔽(k)).
-        // b. Perform ! Set(O, Pk, value, true).
-        // c. Set k to k + 1.
-        O->setIndexedPropertyThrowsException(state, Value(k), value);
-        k++;
+    //   Let Pk be ! ToString(𝔽(k)).
+    //   Perform ! Set(O, Pk, value, true).
+    //   Set k to k + 1.
+    // NOTE: value is already numeric, so converting it once and broadcasting the bytes is equivalent
+    if (startIndex < endIndex) {
+        uint8_t element[8];
+        TypedArrayHelper::numberToRawBytes(state, typedArrayType, value, element);
+        O->fillElements(startIndex, endIndex, element);
     }
     // return O.
     return O;
@@ -1836,6 +1678,8 @@ static Value builtinTypedArraySlice(ExecutionState& state, Value thisValue, size
         auto srcType = O->typedArrayType();
         // Let targetType be TypedArrayElementType(A).
         auto targetType = A->typedArrayType();
+        bool isSrcBigIntArray = srcType == TypedArrayType::BigInt64 || srcType == TypedArrayType::BigUint64;
+        bool isTargetBigIntArray = targetType == TypedArrayType::BigInt64 || targetType == TypedArrayType::BigUint64;
         // If srcType is targetType, then
         if (srcType == targetType) {
             // NOTE: The transfer must be performed in a manner that preserves the bit-level encoding of the source data.
@@ -1852,18 +1696,27 @@ static Value builtinTypedArraySlice(ExecutionState& state, Value thisValue, size
             // Let targetByteIndex be A.[[ByteOffset]].
             auto targetByteIndex = A->byteOffset();
             // Let endByteIndex be targetByteIndex + (countBytes × elementSize).
-            auto endByteIndex = targetByteIndex + (countBytes * elementSize);
+            size_t byteCount = countBytes * elementSize;
             // Repeat, while targetByteIndex < endByteIndex,
-            while (targetByteIndex < endByteIndex) {
-                // Let value be GetValueFromBuffer(srcBuffer, srcByteIndex, uint8, true, unordered).
-                Value value = srcBuffer->getValueFromBuffer(state, srcByteIndex, TypedArrayType::Uint8);
-                // Perform SetValueInBuffer(targetBuffer, targetByteIndex, uint8, value, true, unordered).
-                targetBuffer->setValueInBuffer(state, targetByteIndex, TypedArrayType::Uint8, value);
-                // Set srcByteIndex to srcByteIndex + 1.
-                srcByteIndex++;
-                // Set targetByteIndex to targetByteIndex + 1.
-                targetByteIndex++;
+            //   Let value be GetValueFromBuffer(srcBuffer, srcByteIndex, uint8, true, unordered).
+            //   Perform SetValueInBuffer(targetBuffer, targetByteIndex, uint8, value, true, unordered).
+            //   Set srcByteIndex to srcByteIndex + 1.
+            //   Set targetByteIndex to targetByteIndex + 1.
+            uint8_t* src = srcBuffer->data() + static_cast<size_t>(srcByteIndex);
+            uint8_t* dst = targetBuffer->data() + targetByteIndex;
+            if (srcBuffer != targetBuffer || dst <= src || dst >= src + byteCount) {
+                memmove(dst, src, byteCount);
+            } else {
+                // a species constructor can return a view ahead of O on the same buffer;
+                // the ascending byte order is observable there
+                for (size_t i = 0; i < byteCount; i++) {
+                    dst[i] = src[i];
+                }
             }
+        } else if (O->buffer() != A->buffer() && isSrcBigIntArray == isTargetBigIntArray) {
+            // numeric conversion between distinct buffers; the per element Get and Set below are not observable
+            TypedArrayObject::convertElements(state, srcType, O->rawBuffer() + static_cast<size_t>(startIndex) * O->elementSize(),
+                                              targetType, A->rawBuffer(), static_cast<size_t>(countBytes));
         } else {
             // Else,
             // Let n be 0.
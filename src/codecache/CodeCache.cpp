@@ -32,12 +32,17 @@
 
 // file libraries
 #include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
 #include <sys/stat.h>
 #include <sys/file.h>
+#include <sys/mman.h>
 #include <unistd.h>
 
 #define CODE_CACHE_FILE_DIR "/Escargot-cache/"
 #define CODE_CACHE_LIST_FILE_NAME "cache_list"
+#define CODE_CACHE_LOCK_FILE_NAME "cache_lock"
+#define CODE_CACHE_BUNDLE_MAGIC 0x314c444e42435345ULL // "ESCBNDL1" in little endian
 
 namespace Escargot {
 
@@ -49,32 +54,52 @@ static std::string createCacheFilePath(const std::string& cacheDirPath, const Co
     return ss.str();
 }
 
+// a private name next to the target, so rename() publishes the file atomically
+static std::string createTempFilePath(const std::string& filePath)
+{
+    std::stringstream ss;
+    ss << filePath << '.' << getpid() << ".tmp";
+    return ss.str();
+}
+
 void CodeCache::CodeCacheContext::reset()
 {
     m_cacheFilePath.clear();
     m_cacheEntry.reset();
 
-    if (m_cacheFile) {
-        fclose(m_cacheFile);
-        m_cacheFile = nullptr;
-    }
+    // mapped image is owned by CodeCache::m_mappedFiles
+    m_cacheData = nullptr;
+    m_cacheDataSize = 0;
 
     if (m_cacheStringTable) {
         delete m_cacheStringTable;
         m_cacheStringTable = nullptr;
     }
-    m_cacheDataOffset = 0;
+
+    if (m_writeJob) {
+        delete m_writeJob;
+        m_writeJob = nullptr;
+    }
 }
 
 CodeCache::CodeCache(const char* baseCacheDir)
     : m_cacheWriter(nullptr)
     , m_cacheReader(nullptr)
+    , m_bundleMode(false)
+    , m_statusBeforeBundle(Status::NONE)
+    , m_currentBundleData(nullptr)
     , m_cacheDirFD(-1)
+    , m_cacheLockFD(-1)
     , m_enabled(false)
     , m_shouldLoadFunctionOnScriptLoading(CODE_CACHE_SHOULD_LOAD_FUNCTIONS_ON_SCRIPT_LOADING)
     , m_status(Status::NONE)
     , m_minSourceLength(CODE_CACHE_MIN_SOURCE_LENGTH)
     , m_maxCacheCount(CODE_CACHE_MAX_CACHE_COUNT)
+    , m_cacheListRefreshTime(0)
+#if defined(ENABLE_THREADING)
+    , m_isWriting(false)
+    , m_shouldStopWriter(false)
+#endif
 {
     initialize(baseCacheDir);
 }
@@ -84,6 +109,15 @@ CodeCache::~CodeCache()
     clear();
 }
 
+CodeCacheHash CodeCache::computeSourceHash(String* source)
+{
+    // seeded by the build ID, so caches of another build never match
+    const StringBufferAccessData& accessData = source->bufferAccessData();
+    const uint8_t charSize = accessData.has8BitContent ? 1 : 2;
+    CodeCacheHash hash = CodeCacheHash::compute(&charSize, sizeof(charSize), CodeCacheHash::buildID());
+    return CodeCacheHash::compute(accessData.buffer, accessData.length * charSize, hash);
+}
+
 void CodeCache::initialize(const char* baseCacheDir)
 {
     ASSERT(!m_enabled);
@@ -144,14 +178,25 @@ bool CodeCache::tryInitCacheDir()
     }
 
     // lock cache directory
+    // every process using the cache holds a shared lock, and only a process
+    // that can upgrade it to an exclusive one may clear the directory
     ASSERT(m_cacheDirFD != -1);
-    if (flock(m_cacheDirFD, LOCK_EX | LOCK_NB) == -1) {
+    if (flock(m_cacheDirFD, LOCK_SH | LOCK_NB) == -1) {
         ESCARGOT_LOG_ERROR("[CodeCache] cache directory (%s) lock failed\n", m_cacheDirPath.data());
         close(m_cacheDirFD);
         m_cacheDirFD = -1;
         return false;
     }
 
+    // writers are serialized by an exclusive lock on a separate file
+    std::string lockFilePath = m_cacheDirPath + CODE_CACHE_LOCK_FILE_NAME;
+    if ((m_cacheLockFD = open(lockFilePath.data(), O_RDWR | O_CREAT, 0644)) == -1) {
+        ESCARGOT_LOG_ERROR("[CodeCache] can't open the cache lock file %s\n", lockFilePath.data());
+        // release the shared lock taken above so that no other process is kept from clearing the directory
+        unLockAndCloseCacheDir();
+        return false;
+    }
+
     return true;
 }
 
@@ -160,44 +205,46 @@ bool CodeCache::tryInitCacheList()
     ASSERT(m_cacheList.size() == 0);
     ASSERT(m_cacheDirPath.length());
 
-    std::string listFilePath = m_cacheDirPath + CODE_CACHE_LIST_FILE_NAME;
+    return readCacheList(m_cacheList, m_cacheListStamp);
+}
 
-    struct stat statFile;
-    if (stat(listFilePath.data(), &statFile) != 0) {
-        // there is no list file
-        // cache has not been saved or all files might be removed
-        return true;
-    }
+bool CodeCache::readCacheList(CodeCacheListMap& list, CacheListStamp& stamp)
+{
+    ASSERT(list.size() == 0);
 
-    // check file permission
-    if (!S_ISREG(statFile.st_mode) || !(statFile.st_mode & S_IRUSR) || !(statFile.st_mode & S_IWUSR)) {
-        ESCARGOT_LOG_ERROR("[CodeCache] limited cache file (%s) permission\n", listFilePath.data());
-        return false;
-    }
+    std::string listFilePath = m_cacheDirPath + CODE_CACHE_LIST_FILE_NAME;
 
-    // open list file
+    // the list file is only ever replaced by rename(), so an opened file is
+    // a complete snapshot and can be read without taking any lock
     FILE* listFile = fopen(listFilePath.data(), "rb");
     if (!listFile) {
+        if (errno == ENOENT) {
+            // there is no list file
+            // cache has not been saved or all files might be removed
+            stamp = CacheListStamp();
+            return true;
+        }
         ESCARGOT_LOG_ERROR("[CodeCache] can't open the cache list file %s\n", listFilePath.data());
         return false;
     }
 
-    // check Escargot version
-    size_t cacheVerHash;
-    if (UNLIKELY(fread(&cacheVerHash, sizeof(size_t), 1, listFile) != 1)) {
+    // check file permission
+    struct stat statFile;
+    if (fstat(fileno(listFile), &statFile) != 0 || !S_ISREG(statFile.st_mode) || !(statFile.st_mode & S_IRUSR) || !(statFile.st_mode & S_IWUSR)) {
+        ESCARGOT_LOG_ERROR("[CodeCache] limited cache file (%s) permission\n", listFilePath.data());
+        fclose(listFile);
+        return false;
+    }
+
+    // check Escargot build
+    CodeCacheHash cacheBuildID;
+    if (UNLIKELY(fread(&cacheBuildID, sizeof(CodeCacheHash), 1, listFile) != 1)) {
         ESCARGOT_LOG_ERROR("[CodeCache] fread of %s failed\n", listFilePath.data());
         fclose(listFile);
         return false;
     }
-#ifdef ESCARGOT_BUILD
-    std::string currentVer = ESCARGOT_BUILD;
-#else
-    std::string currentVer = ESCARGOT_VERSION;
-#endif
-    ASSERT(currentVer.length() > 0);
-    size_t currentVerHash = std::hash<std::string>{}(currentVer);
-    if (UNLIKELY(currentVerHash != cacheVerHash)) {
-        ESCARGOT_LOG_ERROR("[CodeCache] Different Escargot version (current: %zu / cache: %zu), clear cache\n", currentVerHash, cacheVerHash);
+    if (UNLIKELY(cacheBuildID != CodeCacheHash::buildID())) {
+        ESCARGOT_LOG_ERROR("[CodeCache] Different Escargot build, clear cache\n");
         fclose(listFile);
         return false;
     }
@@ -210,23 +257,222 @@ bool CodeCache::tryInitCacheList()
         return false;
     }
 
+    CodeCacheHash checksum = cacheBuildID;
     for (size_t i = 0; i < listSize; i++) {
         CodeCacheEntryChunk entryChunk;
         if (UNLIKELY(fread(&entryChunk, sizeof(CodeCacheEntryChunk), 1, listFile) != 1)) {
             ESCARGOT_LOG_ERROR("[CodeCache] fread of %s failed\n", listFilePath.data());
             fclose(listFile);
+            list.clear();
             return false;
         }
+        checksum = CodeCacheHash::compute(&entryChunk, sizeof(CodeCacheEntryChunk), checksum);
+
+        ASSERT(list.find(entryChunk.m_index) == list.end());
+        list.insert(std::make_pair(entryChunk.m_index, entryChunk.m_entry));
+    }
 
-        setCacheEntry(entryChunk);
+    // the list is trusted only as a whole
+    CodeCacheHash listChecksum;
+    if (UNLIKELY(fread(&listChecksum, sizeof(CodeCacheHash), 1, listFile) != 1 || listChecksum != checksum)) {
+        ESCARGOT_LOG_ERROR("[CodeCache] corrupted cache list file %s\n", listFilePath.data());
+        fclose(listFile);
+        list.clear();
+        return false;
     }
 
+    stamp.m_inode = statFile.st_ino;
+    stamp.m_modifiedTime = statFile.st_mtime;
+    stamp.m_size = statFile.st_size;
+
     fclose(listFile);
     return true;
 }
 
+CodeCache::CacheListStamp CodeCache::statCacheList()
+{
+    std::string listFilePath = m_cacheDirPath + CODE_CACHE_LIST_FILE_NAME;
+    CacheListStamp stamp;
+    struct stat statFile;
+    if (stat(listFilePath.data(), &statFile) == 0) {
+        stamp.m_inode = statFile.st_ino;
+        stamp.m_modifiedTime = statFile.st_mtime;
+        stamp.m_size = statFile.st_size;
+    }
+    return stamp;
+}
+
+bool CodeCache::refreshCacheList()
+{
+    ASSERT(m_enabled);
+
+    if (statCacheList() == m_cacheListStamp) {
+        return true;
+    }
+
+    // another process has published a new list
+    CodeCacheListMap newList;
+    CacheListStamp newStamp;
+    if (UNLIKELY(!readCacheList(newList, newStamp))) {
+        return false;
+    }
+
+    m_cacheList.swap(newList);
+    m_cacheListStamp = newStamp;
+    return true;
+}
+
+bool CodeCache::enqueueWriteJob(CodeCacheWriteJob* job)
+{
+#if defined(ENABLE_THREADING)
+    {
+        std::lock_guard<std::mutex> guard(m_writeQueueMutex);
+        if (m_writeQueue.size() >= CODE_CACHE_MAX_PENDING_WRITE_COUNT) {
+            // never let the executing thread wait for the disk, the entry is just not cached
+            delete job;
+            return false;
+        }
+
+        m_writeQueue.push_back(job);
+        if (!m_writerThread.joinable()) {
+            m_writerThread = std::thread(&CodeCache::runWriterThread, this);
+        }
+    }
+    m_writeQueueCondition.notify_all();
+#else
+    writeJob(job);
+    delete job;
+#endif
+    return true;
+}
+
+#if defined(ENABLE_THREADING)
+void CodeCache::runWriterThread()
+{
+    std::unique_lock<std::mutex> lock(m_writeQueueMutex);
+    while (true) {
+        m_writeQueueCondition.wait(lock, [this]() {
+            return !m_writeQueue.empty() || m_shouldStopWriter;
+        });
+
+        if (m_writeQueue.empty()) {
+            // stop requested and every queued entry has been written
+            break;
+        }
+
+        CodeCacheWriteJob* job = m_writeQueue.front();
+        m_writeQueue.pop_front();
+        m_isWriting = true;
+        lock.unlock();
+
+        writeJob(job);
+        delete job;
+
+        lock.lock();
+        m_isWriting = false;
+        m_writeQueueCondition.notify_all();
+    }
+}
+#endif
+
+void CodeCache::stopWriterThread()
+{
+#if defined(ENABLE_THREADING)
+    if (!m_writerThread.joinable()) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(m_writeQueueMutex);
+        m_shouldStopWriter = true;
+    }
+    m_writeQueueCondition.notify_all();
+    m_writerThread.join();
+    m_shouldStopWriter = false;
+#endif
+}
+
+void CodeCache::flush()
+{
+#if defined(ENABLE_THREADING)
+    std::unique_lock<std::mutex> lock(m_writeQueueMutex);
+    m_writeQueueCondition.wait(lock, [this]() {
+        return m_writeQueue.empty() && !m_isWriting;
+    });
+#endif
+}
+
+void CodeCache::writeJob(CodeCacheWriteJob* job)
+{
+    ASSERT(m_cacheLockFD != -1);
+    const CodeCacheIndex& cacheIndex = job->m_cacheIndex;
+
+#if defined(ENABLE_THREADING)
+    // only the writer thread waits for other processes
+    int lockOperation = LOCK_EX;
+#else
+    int lockOperation = LOCK_EX | LOCK_NB;
+#endif
+    if (flock(m_cacheLockFD, lockOperation) == -1) {
+        // another process is writing now, give up caching this entry
+        return;
+    }
+
+    // the new list is written on top of the latest one so that entries stored
+    // by other processes are kept, and an entry stored meanwhile is not stored twice.
+    // no other process publishes while the lock file is held, so the list is built
+    // and written aside and m_cacheListMutex is only taken to copy and swap it
+    CodeCacheListMap list;
+    CacheListStamp stamp = statCacheList();
+    bool isLatest;
+    {
+#if defined(ENABLE_THREADING)
+        std::lock_guard<std::mutex> guard(m_cacheListMutex);
+#endif
+        isLatest = stamp == m_cacheListStamp;
+        if (isLatest) {
+            list = m_cacheList;
+        }
+    }
+
+    if (!isLatest && UNLIKELY(!readCacheList(list, stamp))) {
+        flock(m_cacheLockFD, LOCK_UN);
+        return;
+    }
+
+    bool shouldSwap = !isLatest;
+    CodeCacheEntry entry;
+    if (list.find(cacheIndex) == list.end() && writeCacheDataFile(job, entry)) {
+        // write time stamp
+        m_cacheLRUList[cacheIndex.scriptID()] = fastTickCount();
+
+        if (LIKELY(addCacheEntry(list, cacheIndex, entry) && writeCacheList(list, stamp))) {
+            shouldSwap = true;
+        } else {
+            ESCARGOT_LOG_ERROR("[CodeCache] can't publish the cache entry of %s\n", createCacheFilePath(m_cacheDirPath, cacheIndex).data());
+            // the published list is picked up again by the next refresh
+            shouldSwap = false;
+        }
+    }
+
+    if (shouldSwap) {
+#if defined(ENABLE_THREADING)
+        std::lock_guard<std::mutex> guard(m_cacheListMutex);
+#endif
+        m_cacheList.swap(list);
+        m_cacheListStamp = stamp;
+    }
+
+    flock(m_cacheLockFD, LOCK_UN);
+}
+
 void CodeCache::unLockAndCloseCacheDir()
 {
+    if (m_cacheLockFD != -1) {
+        close(m_cacheLockFD);
+        m_cacheLockFD = -1;
+    }
+
     if (m_cacheDirFD != -1) {
         if (flock(m_cacheDirFD, LOCK_UN) == -1) {
             // exception case - unlock failed
@@ -255,6 +501,11 @@ void CodeCache::clearCacheDir()
             continue;
         }
 
+        // the lock file stays, other processes may open it at any time
+        if (!strcmp(entry->d_name, CODE_CACHE_LOCK_FILE_NAME)) {
+            continue;
+        }
+
         std::string entryPath(path);
         entryPath += entry->d_name;
 
@@ -282,12 +533,22 @@ void CodeCache::clearCacheDir()
 
 void CodeCache::clear()
 {
+    // write out queued entries before the directory lock is released
+    stopWriterThread();
+
     m_currentContext.reset();
+    unmapAllCacheFiles();
+
+    for (size_t i = 0; i < m_bundleJobs.size(); i++) {
+        delete m_bundleJobs[i];
+    }
+    m_bundleJobs.clear();
 
     unLockAndCloseCacheDir();
 
     m_cacheDirPath.clear();
     m_cacheList.clear();
+    m_cacheListStamp = CacheListStamp();
     m_cacheLRUList.clear();
 
     if (m_cacheWriter) {
@@ -308,13 +569,28 @@ void CodeCache::clearAll()
 {
     // clear CodeCache and all cache files
     ASSERT(m_status == Status::FAILED || m_status == Status::NONE);
-    clearCacheDir();
+    stopWriterThread();
+    // cache files are removed only when no other process is using them,
+    // otherwise caching is just disabled for this process
+    if (m_cacheDirFD != -1 && flock(m_cacheDirFD, LOCK_EX | LOCK_NB) == 0) {
+        // the shared lock was dropped while upgrading, so another process may have
+        // cleared the directory and published a valid list in the meantime
+        bool stillInvalid = true;
+        if (!(statCacheList() == m_cacheListStamp)) {
+            CodeCacheListMap currentList;
+            CacheListStamp currentStamp;
+            stillInvalid = !readCacheList(currentList, currentStamp);
+        }
+        if (stillInvalid) {
+            clearCacheDir();
+        }
+    }
     clear();
 }
 
 void CodeCache::reset()
 {
-    ASSERT(m_enabled);
+    ASSERT(m_enabled || m_bundleMode);
 
     // reset current CodeCache infos
     m_currentContext.reset();
@@ -329,25 +605,25 @@ void CodeCache::setCacheEntry(const CodeCacheEntryChunk& entryChunk)
     m_cacheList.insert(std::make_pair(entryChunk.m_index, entryChunk.m_entry));
 }
 
-bool CodeCache::addCacheEntry(const CodeCacheIndex& cacheIndex, const CodeCacheEntry& entry)
+bool CodeCache::addCacheEntry(CodeCacheListMap& list, const CodeCacheIndex& cacheIndex, const CodeCacheEntry& entry)
 {
     ASSERT(m_enabled);
 
 #ifndef NDEBUG
-    auto iter = m_cacheList.find(cacheIndex);
-    ASSERT(iter == m_cacheList.end());
+    auto iter = list.find(cacheIndex);
+    ASSERT(iter == list.end());
 #endif
     if (m_cacheLRUList.size() == m_maxCacheCount) {
-        if (UNLIKELY(!removeLRUCacheEntry())) {
+        if (UNLIKELY(!removeLRUCacheEntry(list))) {
             return false;
         }
     }
 
-    m_cacheList.insert(std::make_pair(cacheIndex, entry));
+    list.insert(std::make_pair(cacheIndex, entry));
     return true;
 }
 
-bool CodeCache::removeLRUCacheEntry()
+bool CodeCache::removeLRUCacheEntry(CodeCacheListMap& list)
 {
     ASSERT(m_enabled);
     ASSERT(m_cacheLRUList.size() == m_maxCacheCount);
@@ -375,16 +651,18 @@ bool CodeCache::removeLRUCacheEntry()
     size_t eraseReturn = m_cacheLRUList.erase(lruIndex);
     ASSERT(eraseReturn == 1 && m_cacheLRUList.size() == m_maxCacheCount - 1);
 
-    for (auto iter = m_cacheList.begin(); iter != m_cacheList.end();) {
+    for (auto iter = list.begin(); iter != list.end();) {
         if (iter->first.scriptID() == lruIndex) {
-            iter = m_cacheList.erase(iter);
+            iter = list.erase(iter);
         } else {
             iter++;
         }
     }
 
 #ifndef NDEBUG
-    ESCARGOT_LOG_INFO("[CodeCache] removeLRUCacheEntry %zu_%zu done\n", lruIndex.m_srcHash, lruIndex.m_srcLength);
+    std::string lruHash;
+    lruIndex.m_srcHash.appendHexString(lruHash);
+    ESCARGOT_LOG_INFO("[CodeCache] removeLRUCacheEntry %s_%zu done\n", lruHash.data(), lruIndex.m_srcLength);
 #endif
 
     return true;
@@ -394,10 +672,14 @@ bool CodeCache::removeCacheFile(const CodeCacheIndex::ScriptID& scriptID)
 {
     ASSERT(m_enabled);
     ASSERT(m_cacheDirPath.length());
-    ASSERT(scriptID.m_srcHash && scriptID.m_srcLength);
+    ASSERT(scriptID.m_srcHash.isValid() && scriptID.m_srcLength);
+
+    // a mapping of the removed file is kept until it is remapped, as this may run
+    // on the writer thread; the file ID of a new entry never matches it
 
     std::string filePath = createCacheFilePath(m_cacheDirPath, CodeCacheIndex(scriptID.m_srcHash, scriptID.m_srcLength, 0));
-    if (remove(filePath.data()) != 0) {
+    if (remove(filePath.data()) != 0 && errno != ENOENT) {
+        // the file may have been evicted by another process already
         ESCARGOT_LOG_ERROR("[CodeCache] can`t remove a cache file %s\n", filePath.data());
         return false;
     }
@@ -408,6 +690,75 @@ bool CodeCache::removeCacheFile(const CodeCacheIndex::ScriptID& scriptID)
     return true;
 }
 
+const CodeCache::MappedCacheFile* CodeCache::mapCacheFile(const CodeCacheIndex::ScriptID& scriptID, const std::string& filePath, uint64_t fileID, size_t requiredSize)
+{
+    auto iter = m_mappedFiles.find(scriptID);
+    if (iter != m_mappedFiles.end()) {
+        if (LIKELY(iter->second.m_fileID == fileID && iter->second.m_size >= requiredSize)) {
+            return &iter->second;
+        }
+        // function caches have been appended since the file was mapped,
+        // or the file has been replaced
+        unmapCacheFile(scriptID);
+    }
+
+    int fd = open(filePath.data(), O_RDONLY);
+    if (UNLIKELY(fd < 0)) {
+        ESCARGOT_LOG_ERROR("[CodeCache] can't open the cache data file %s\n", filePath.data());
+        return nullptr;
+    }
+
+    struct stat st;
+    if (UNLIKELY(fstat(fd, &st) != 0 || (uint64_t)st.st_ino != fileID)) {
+        // evicted and stored again by another process after the entry was listed
+        close(fd);
+        m_status = Status::STALE;
+        return nullptr;
+    }
+
+    if (UNLIKELY((size_t)st.st_size < requiredSize || st.st_size == 0)) {
+        ESCARGOT_LOG_ERROR("[CodeCache] invalid size of the cache data file %s\n", filePath.data());
+        close(fd);
+        return nullptr;
+    }
+
+    // read-only shared pages come straight from the page cache,
+    // so every process loading the same script shares one copy of the image
+    void* data = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (UNLIKELY(data == MAP_FAILED)) {
+        ESCARGOT_LOG_ERROR("[CodeCache] can't map the cache data file %s\n", filePath.data());
+        return nullptr;
+    }
+
+    MappedCacheFile& mappedFile = m_mappedFiles[scriptID];
+    mappedFile.m_data = static_cast<char*>(data);
+    mappedFile.m_size = st.st_size;
+    mappedFile.m_fileID = fileID;
+    return &mappedFile;
+}
+
+void CodeCache::unmapCacheFile(const CodeCacheIndex::ScriptID& scriptID)
+{
+    auto iter = m_mappedFiles.find(scriptID);
+    if (iter == m_mappedFiles.end()) {
+        return;
+    }
+
+    ASSERT(m_currentContext.m_cacheData != iter->second.m_data);
+    munmap(iter->second.m_data, iter->second.m_size);
+    m_mappedFiles.erase(iter);
+}
+
+void CodeCache::unmapAllCacheFiles()
+{
+    ASSERT(!m_currentContext.m_cacheData);
+    for (auto iter = m_mappedFiles.begin(); iter != m_mappedFiles.end(); iter++) {
+        munmap(iter->second.m_data, iter->second.m_size);
+    }
+    m_mappedFiles.clear();
+}
+
 std::pair<bool, CodeCacheEntry> CodeCache::searchCache(const CodeCacheIndex& cacheIndex)
 {
     ASSERT(m_enabled && cacheIndex.isValid());
@@ -415,7 +766,23 @@ std::pair<bool, CodeCacheEntry> CodeCache::searchCache(const CodeCacheIndex& cac
     CodeCacheEntry entry;
     bool cacheHit = false;
 
+#if defined(ENABLE_THREADING)
+    std::lock_guard<std::mutex> guard(m_cacheListMutex);
+#endif
     auto iter = m_cacheList.find(cacheIndex);
+    if (iter == m_cacheList.end() && m_status == Status::READY) {
+        // lock-free lookup of entries published by other processes
+        // entries of this process are listed at once, so the list file is
+        // checked at most once per interval to keep misses cheap
+        uint64_t currentTime = fastTickCount();
+        if (currentTime - m_cacheListRefreshTime >= CODE_CACHE_LIST_REFRESH_INTERVAL) {
+            m_cacheListRefreshTime = currentTime;
+            if (refreshCacheList()) {
+                iter = m_cacheList.find(cacheIndex);
+            }
+        }
+    }
+
     if (iter != m_cacheList.end()) {
         cacheHit = true;
         entry = iter->second;
@@ -482,9 +849,10 @@ bool CodeCache::loadFunctionCache(Context* context, const CodeCacheIndex& cacheI
 
 bool CodeCache::storeGlobalCache(Context* context, const CodeCacheIndex& cacheIndex, InterpretedCodeBlock* topCodeBlock, CodeBlockCacheInfo* codeBlockCacheInfo, Node* programNode, bool inWith)
 {
-    ASSERT(m_enabled && cacheIndex.isValid());
+    ASSERT((m_enabled || isWritingBundle()) && cacheIndex.isValid());
 
     if (m_status != Status::READY) {
+        topCodeBlock->m_byteCodeBlock = ByteCodeGenerator::generateByteCode(context, topCodeBlock, programNode, inWith, false);
         return false;
     }
 
@@ -508,7 +876,7 @@ bool CodeCache::storeGlobalCache(Context* context, const CodeCacheIndex& cacheIn
     bool result = postCacheWriting(cacheIndex);
 #ifndef NDEBUG
     if (result) {
-        ESCARGOT_LOG_INFO("[CodeCache] Store CodeCache Done (%s)\n", topCodeBlock->script()->srcName()->toUTF8StringData().data());
+        ESCARGOT_LOG_INFO("[CodeCache] Store CodeCache Queued (%s)\n", topCodeBlock->script()->srcName()->toUTF8StringData().data());
     }
 #endif
     return result;
@@ -516,9 +884,10 @@ bool CodeCache::storeGlobalCache(Context* context, const CodeCacheIndex& cacheIn
 
 bool CodeCache::storeFunctionCache(Context* context, const CodeCacheIndex& cacheIndex, InterpretedCodeBlock* codeBlock, Node* functionNode)
 {
-    ASSERT(m_enabled && cacheIndex.isValid());
+    ASSERT((m_enabled || isWritingBundle()) && cacheIndex.isValid());
 
     if (m_status != Status::READY) {
+        codeBlock->m_byteCodeBlock = ByteCodeGenerator::generateByteCode(context, codeBlock, functionNode);
         return false;
     }
 
@@ -538,13 +907,361 @@ bool CodeCache::storeFunctionCache(Context* context, const CodeCacheIndex& cache
     bool result = postCacheWriting(cacheIndex);
 #ifndef NDEBUG
     if (result) {
-        ESCARGOT_LOG_INFO("[CodeCache] Store CodeCache Done (%s: index %zu size %zu)\n", codeBlock->script()->srcName()->toNonGCUTF8StringData().data(),
+        ESCARGOT_LOG_INFO("[CodeCache] Store CodeCache Queued (%s: index %zu size %zu)\n", codeBlock->script()->srcName()->toNonGCUTF8StringData().data(),
                           codeBlock->functionStart().index, codeBlock->src().length());
     }
 #endif
     return result;
 }
 
+void CodeCache::ensureReaderWriter()
+{
+    // created together with the cache directory, which bundles do not depend on
+    if (!m_cacheWriter) {
+        m_cacheWriter = new CodeCacheWriter();
+    }
+    if (!m_cacheReader) {
+        m_cacheReader = new CodeCacheReader();
+    }
+}
+
+void CodeCache::beginBundleWriting()
+{
+    ASSERT(!m_bundleMode && m_status != Status::IN_PROGRESS);
+    ASSERT(m_bundleJobs.empty());
+
+    ensureReaderWriter();
+    m_bundleMode = true;
+    m_statusBeforeBundle = m_status;
+    m_status = Status::READY;
+}
+
+bool CodeCache::endBundleWriting(std::vector<char>& bundle)
+{
+    ASSERT(isWritingBundle());
+
+    bundle.clear();
+
+    // the global entry is stored first, so its CodeBlock tree starts at offset 0 of the data
+    bool result = m_bundleJobs.size() && m_bundleJobs[0]->m_cacheIndex.m_functionIndex == SIZE_MAX;
+    if (LIKELY(result)) {
+        std::vector<CodeCacheEntryChunk> chunks;
+        chunks.reserve(m_bundleJobs.size());
+        size_t dataSize = 0;
+        for (size_t i = 0; i < m_bundleJobs.size(); i++) {
+            CodeCacheWriteJob* job = m_bundleJobs[i];
+            CodeCacheEntryChunk chunk;
+            chunk.m_index = job->m_cacheIndex;
+            layoutCacheEntry(job, dataSize, chunk.m_entry);
+            chunks.push_back(chunk);
+
+            for (size_t j = 0; j < job->m_sections.size(); j++) {
+                dataSize += job->m_sections[j].m_data.size();
+            }
+        }
+
+        // sorted for the binary search of findBundleEntry()
+        std::sort(chunks.begin(), chunks.end(), [](const CodeCacheEntryChunk& a, const CodeCacheEntryChunk& b) -> bool {
+            return a.m_index.m_functionIndex < b.m_index.m_functionIndex;
+        });
+
+        BundleHeader header;
+        header.m_magic = CODE_CACHE_BUNDLE_MAGIC;
+        header.m_buildID = CodeCacheHash::buildID();
+        header.m_srcHash = m_bundleJobs[0]->m_cacheIndex.m_srcHash;
+        header.m_srcLength = m_bundleJobs[0]->m_cacheIndex.m_srcLength;
+        header.m_entryCount = chunks.size();
+        header.m_checksum = CodeCacheHash::compute(chunks.data(), chunks.size() * sizeof(CodeCacheEntryChunk), header.m_buildID);
+
+        bundle.reserve(sizeof(BundleHeader) + chunks.size() * sizeof(CodeCacheEntryChunk) + dataSize);
+        bundle.insert(bundle.end(), reinterpret_cast<const char*>(&header), reinterpret_cast<const char*>(&header) + sizeof(BundleHeader));
+        bundle.insert(bundle.end(), reinterpret_cast<const char*>(chunks.data()), reinterpret_cast<const char*>(chunks.data() + chunks.size()));
+        for (size_t i = 0; i < m_bundleJobs.size(); i++) {
+            const CodeCacheWriteJob* job = m_bundleJobs[i];
+            for (size_t j = 0; j < job->m_sections.size(); j++) {
+                bundle.insert(bundle.end(), job->m_sections[j].m_data.begin(), job->m_sections[j].m_data.end());
+            }
+        }
+    }
+
+    for (size_t i = 0; i < m_bundleJobs.size(); i++) {
+        delete m_bundleJobs[i];
+    }
+    m_bundleJobs.clear();
+
+    m_status = m_statusBeforeBundle;
+    m_bundleMode = false;
+    return result;
+}
+
+bool CodeCache::mergeBundles(const std::vector<std::vector<char>>& parts, std::vector<char>& bundle)
+{
+    bundle.clear();
+    if (UNLIKELY(parts.empty())) {
+        return false;
+    }
+
+    // every part holds the same global entry, only the one of the first part is kept
+    struct Section {
+        const char* m_data;
+        size_t m_size;
+    };
+    std::vector<CodeCacheEntryChunk> chunks;
+    std::vector<Section> sections;
+    BundleHeader header;
+    size_t dataSize = 0;
+    for (size_t i = 0; i < parts.size(); i++) {
+        const std::vector<char>& part = parts[i];
+        BundleHeader partHeader;
+        if (UNLIKELY(part.size() < sizeof(BundleHeader))) {
+            return false;
+        }
+        memcpy(&partHeader, part.data(), sizeof(BundleHeader));
+        if (UNLIKELY(partHeader.m_magic != CODE_CACHE_BUNDLE_MAGIC || partHeader.m_buildID != CodeCacheHash::buildID()
+                     || partHeader.m_entryCount > (part.size() - sizeof(BundleHeader)) / sizeof(CodeCacheEntryChunk))) {
+            return false;
+        }
+        if (i == 0) {
+            header = partHeader;
+        } else if (UNLIKELY(partHeader.m_srcHash != header.m_srcHash || partHeader.m_srcLength != header.m_srcLength)) {
+            return false;
+        }
+
+        const char* partChunks = part.data() + sizeof(BundleHeader);
+        const char* partData = partChunks + partHeader.m_entryCount * sizeof(CodeCacheEntryChunk);
+        size_t partDataSize = part.data() + part.size() - partData;
+        // chunks are sorted by function index, so the global entry is the last one.
+        // it is moved first to keep its CodeBlock tree at offset 0 of the data
+        for (size_t k = 0; k < partHeader.m_entryCount; k++) {
+            size_t j = (i == 0) ? (k + partHeader.m_entryCount - 1) % partHeader.m_entryCount : k;
+            CodeCacheEntryChunk chunk;
+            memcpy(&chunk, partChunks + j * sizeof(CodeCacheEntryChunk), sizeof(CodeCacheEntryChunk));
+            bool isGlobal = chunk.m_index.m_functionIndex == SIZE_MAX;
+            if (UNLIKELY(isGlobal != (i == 0 && k == 0))) {
+                if (isGlobal) {
+                    continue;
+                }
+                // the first part has no global entry
+                return false;
+            }
+
+            // sections are moved one by one. the entry checksum only covers their contents
+            for (size_t t = 0; t < (size_t)CodeCacheType::CACHE_TYPE_NUM; t++) {
+                CodeCacheMetaInfo& meta = chunk.m_entry.m_metaInfos[t];
+                if (meta.cacheType == CodeCacheType::CACHE_INVALID) {
+                    continue;
+                }
+                size_t dataOffset = meta.cacheType == CodeCacheType::CACHE_CODEBLOCK ? 0 : meta.dataOffset;
+                if (UNLIKELY(dataOffset > partDataSize || meta.dataSize > partDataSize - dataOffset)) {
+                    return false;
+                }
+                if (meta.cacheType == CodeCacheType::CACHE_CODEBLOCK) {
+                    ASSERT(isGlobal && dataSize == 0);
+                } else {
+                    meta.dataOffset = dataSize;
+                }
+                Section section = { partData + dataOffset, meta.dataSize };
+                sections.push_back(section);
+                dataSize += meta.dataSize;
+            }
+            chunks.push_back(chunk);
+        }
+    }
+
+    std::sort(chunks.begin(), chunks.end(), [](const CodeCacheEntryChunk& a, const CodeCacheEntryChunk& b) -> bool {
+        return a.m_index.m_functionIndex < b.m_index.m_functionIndex;
+    });
+
+    header.m_entryCount = chunks.size();
+    header.m_checksum = CodeCacheHash::compute(chunks.data(), chunks.size() * sizeof(CodeCacheEntryChunk), header.m_buildID);
+
+    bundle.reserve(sizeof(BundleHeader) + chunks.size() * sizeof(CodeCacheEntryChunk) + dataSize);
+    bundle.insert(bundle.end(), reinterpret_cast<const char*>(&header), reinterpret_cast<const char*>(&header) + sizeof(BundleHeader));
+    bundle.insert(bundle.end(), reinterpret_cast<const char*>(chunks.data()), reinterpret_cast<const char*>(chunks.data() + chunks.size()));
+    for (size_t i = 0; i < sections.size(); i++) {
+        bundle.insert(bundle.end(), sections[i].m_data, sections[i].m_data + sections[i].m_size);
+    }
+    return true;
+}
+
+bool CodeCache::loadBundle(Context* context, const char* bundleData, size_t bundleSize, Script* script, bool verifySourceHash)
+{
+    ASSERT(!m_bundleMode);
+
+    if (UNLIKELY(m_status == Status::IN_PROGRESS)) {
+        return false;
+    }
+
+    // the entry list is checked once here, functions are looked up later without checking again
+    BundleHeader header;
+    if (UNLIKELY(!bundleData || bundleSize < sizeof(BundleHeader))) {
+        ESCARGOT_LOG_ERROR("[CodeCache] invalid bundle of %s\n", script->srcName()->toNonGCUTF8StringData().data());
+        return false;
+    }
+    memcpy(&header, bundleData, sizeof(BundleHeader));
+
+    if (UNLIKELY(header.m_magic != CODE_CACHE_BUNDLE_MAGIC || header.m_buildID != CodeCacheHash::buildID())) {
+        ESCARGOT_LOG_ERROR("[CodeCache] bundle of %s is made by another Escargot build\n", script->srcName()->toNonGCUTF8StringData().data());
+        return false;
+    }
+
+    // the source is hashed only on request, by default it may stay unloaded until a function needs it
+    if (UNLIKELY(header.m_srcLength != script->sourceCode()->length()
+                 || (verifySourceHash && computeSourceHash(script->sourceCode()) != header.m_srcHash))) {
+        ESCARGOT_LOG_ERROR("[CodeCache] bundle of %s is made from another source\n", script->srcName()->toNonGCUTF8StringData().data());
+        return false;
+    }
+
+    if (UNLIKELY(header.m_entryCount > (bundleSize - sizeof(BundleHeader)) / sizeof(CodeCacheEntryChunk)
+                 || CodeCacheHash::compute(bundleData + sizeof(BundleHeader), header.m_entryCount * sizeof(CodeCacheEntryChunk), header.m_buildID) != header.m_checksum)) {
+        ESCARGOT_LOG_ERROR("[CodeCache] corrupted bundle of %s\n", script->srcName()->toNonGCUTF8StringData().data());
+        return false;
+    }
+
+    // a truncated bundle is rejected here instead of when one of its functions is first called
+    size_t dataStart = sizeof(BundleHeader) + header.m_entryCount * sizeof(CodeCacheEntryChunk);
+    size_t dataSize = bundleSize - dataStart;
+    for (size_t i = 0; i < header.m_entryCount; i++) {
+        CodeCacheEntryChunk chunk;
+        memcpy(&chunk, bundleData + sizeof(BundleHeader) + i * sizeof(CodeCacheEntryChunk), sizeof(CodeCacheEntryChunk));
+        for (size_t t = 0; t < (size_t)CodeCacheType::CACHE_TYPE_NUM; t++) {
+            const CodeCacheMetaInfo& meta = chunk.m_entry.m_metaInfos[t];
+            if (meta.cacheType == CodeCacheType::CACHE_INVALID) {
+                continue;
+            }
+            size_t dataOffset = meta.cacheType == CodeCacheType::CACHE_CODEBLOCK ? 0 : meta.dataOffset;
+            if (UNLIKELY(dataOffset > dataSize || meta.dataSize > dataSize - dataOffset)) {
+                ESCARGOT_LOG_ERROR("[CodeCache] bundle of %s is truncated\n", script->srcName()->toNonGCUTF8StringData().data());
+                return false;
+            }
+        }
+    }
+
+    CodeCacheEntry entry;
+    if (UNLIKELY(!findBundleEntry(bundleData, SIZE_MAX, entry))) {
+        ESCARGOT_LOG_ERROR("[CodeCache] bundle of %s has no global code\n", script->srcName()->toNonGCUTF8StringData().data());
+        return false;
+    }
+
+    if (UNLIKELY(!loadBundleEntry(context, bundleData, bundleSize, entry, script, nullptr))) {
+        return false;
+    }
+
+    script->m_sourceCodeHashValue = header.m_srcHash;
+    if (header.m_entryCount > 1) {
+        // functions are looked up in the bundle when they are first called
+        script->m_bundleData = bundleData;
+        script->m_bundleSize = bundleSize;
+    }
+
+    ESCARGOT_LOG_INFO("[CodeCache] Load Bundle Done (%s)\n", script->srcName()->toUTF8StringData().data());
+    return true;
+}
+
+bool CodeCache::loadBundleFunction(Context* context, InterpretedCodeBlock* codeBlock, const char* bundleData, size_t bundleSize)
+{
+    Script* script = codeBlock->script();
+    ASSERT(!!bundleData);
+
+    if (UNLIKELY(m_bundleMode || m_status == Status::IN_PROGRESS)) {
+        return false;
+    }
+
+    CodeCacheEntry entry;
+    if (!findBundleEntry(bundleData, codeBlock->functionStart().index, entry)) {
+        return false;
+    }
+
+    bool result = loadBundleEntry(context, bundleData, bundleSize, entry, nullptr, codeBlock);
+#ifndef NDEBUG
+    if (result) {
+        ESCARGOT_LOG_INFO("[CodeCache] Load Bundle Done (%s: index %zu size %zu)\n", script->srcName()->toNonGCUTF8StringData().data(),
+                          codeBlock->functionStart().index, codeBlock->src().length());
+    }
+#endif
+    return result;
+}
+
+bool CodeCache::findBundleEntry(const char* bundleData, size_t functionIndex, CodeCacheEntry& entry)
+{
+    BundleHeader header;
+    memcpy(&header, bundleData, sizeof(BundleHeader));
+
+    // the embedder may hand over an unaligned buffer, so each chunk is copied out
+    const char* chunks = bundleData + sizeof(BundleHeader);
+    size_t low = 0;
+    size_t high = header.m_entryCount;
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        CodeCacheEntryChunk chunk;
+        memcpy(&chunk, chunks + mid * sizeof(CodeCacheEntryChunk), sizeof(CodeCacheEntryChunk));
+        if (chunk.m_index.m_functionIndex == functionIndex) {
+            entry = chunk.m_entry;
+            return true;
+        }
+        if (chunk.m_index.m_functionIndex < functionIndex) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return false;
+}
+
+bool CodeCache::loadBundleEntry(Context* context, const char* bundleData, size_t bundleSize, const CodeCacheEntry& entry, Script* script, InterpretedCodeBlock* codeBlock)
+{
+    ASSERT(!!script != !!codeBlock);
+
+    BundleHeader header;
+    memcpy(&header, bundleData, sizeof(BundleHeader));
+    size_t dataStart = sizeof(BundleHeader) + header.m_entryCount * sizeof(CodeCacheEntryChunk);
+    ASSERT(dataStart <= bundleSize);
+
+    ensureReaderWriter();
+    m_bundleMode = true;
+    m_currentBundleData = bundleData;
+    m_statusBeforeBundle = m_status;
+    m_status = Status::IN_PROGRESS;
+
+    // named after the script only for logging
+    m_currentContext.m_cacheFilePath = "bundle:";
+    m_currentContext.m_cacheFilePath += (script ? script : codeBlock->script())->srcName()->toNonGCUTF8StringData().data();
+    m_currentContext.m_cacheEntry = entry;
+    m_currentContext.m_cacheData = bundleData + dataStart;
+    m_currentContext.m_cacheDataSize = bundleSize - dataStart;
+
+    bool result = false;
+    if (LIKELY(verifyCacheData(entry))) {
+        try {
+            m_currentContext.m_cacheStringTable = loadCacheStringTable(context);
+            if (script) {
+                InterpretedCodeBlock* topCodeBlock = loadCodeBlockTree(context, script);
+                ByteCodeBlock* topByteCodeBlock = loadByteCodeBlock(context, topCodeBlock);
+                if (LIKELY(m_status == Status::FINISH)) {
+                    ASSERT(!!topCodeBlock && !!topByteCodeBlock);
+                    script->m_topCodeBlock = topCodeBlock;
+                    topCodeBlock->m_byteCodeBlock = topByteCodeBlock;
+                    result = true;
+                }
+            } else {
+                ByteCodeBlock* block = loadByteCodeBlock(context, codeBlock);
+                if (LIKELY(m_status == Status::FINISH)) {
+                    codeBlock->m_byteCodeBlock = block;
+                    result = true;
+                }
+            }
+        } catch (CodeCacheReader::Error& error) {
+            result = false;
+        }
+    }
+
+    m_currentContext.reset();
+    m_status = m_statusBeforeBundle;
+    m_currentBundleData = nullptr;
+    m_bundleMode = false;
+    return result;
+}
+
 void CodeCache::prepareCacheLoading(Context* context, const CodeCacheIndex& cacheIndex, const CodeCacheEntry& entry)
 {
     ASSERT(m_enabled && m_status == Status::READY);
@@ -557,20 +1274,54 @@ void CodeCache::prepareCacheLoading(Context* context, const CodeCacheIndex& cach
 
     m_currentContext.m_cacheFilePath = createCacheFilePath(m_cacheDirPath, cacheIndex);
     m_currentContext.m_cacheEntry = entry;
-    FILE* dataFile = fopen(m_currentContext.m_cacheFilePath.data(), "rb");
-    if (UNLIKELY(!dataFile)) {
-        ESCARGOT_LOG_ERROR("[CodeCache] can't open the cache data file %s\n", m_currentContext.m_cacheFilePath.data());
+
+    // the entry records where each part of its image lives in the data file
+    size_t requiredSize = 0;
+    for (size_t i = 0; i < (size_t)CodeCacheType::CACHE_TYPE_NUM; i++) {
+        const CodeCacheMetaInfo& metaInfo = entry.m_metaInfos[i];
+        if (metaInfo.cacheType == CodeCacheType::CACHE_INVALID) {
+            continue;
+        }
+        size_t dataOffset = metaInfo.cacheType == CodeCacheType::CACHE_CODEBLOCK ? 0 : metaInfo.dataOffset;
+        requiredSize = std::max(requiredSize, dataOffset + metaInfo.dataSize);
+    }
+
+    const MappedCacheFile* mappedFile = mapCacheFile(cacheIndex.scriptID(), m_currentContext.m_cacheFilePath, entry.m_dataFileID, requiredSize);
+    if (UNLIKELY(!mappedFile)) {
+        if (m_status == Status::STALE) {
+            // drop the outdated entries of this script
+#if defined(ENABLE_THREADING)
+            std::lock_guard<std::mutex> guard(m_cacheListMutex);
+#endif
+            for (auto iter = m_cacheList.begin(); iter != m_cacheList.end();) {
+                if (iter->first.scriptID() == cacheIndex.scriptID()) {
+                    iter = m_cacheList.erase(iter);
+                } else {
+                    iter++;
+                }
+            }
+            // no longer a copy of the published list
+            m_cacheListStamp = CacheListStamp();
+        } else {
+            m_status = Status::FAILED;
+        }
+        return;
+    }
+    m_currentContext.m_cacheData = mappedFile->m_data;
+    m_currentContext.m_cacheDataSize = mappedFile->m_size;
+
+    if (UNLIKELY(!verifyCacheData(entry))) {
+        // never decode data which differs from what was written
         m_status = Status::FAILED;
         return;
     }
-    m_currentContext.m_cacheFile = dataFile;
     m_currentContext.m_cacheStringTable = loadCacheStringTable(context);
 }
 
 void CodeCache::prepareCacheWriting(const CodeCacheIndex& cacheIndex)
 {
-    ASSERT(m_enabled && m_status == Status::READY);
-    ASSERT(m_cacheDirPath.length());
+    ASSERT((m_enabled || isWritingBundle()) && m_status == Status::READY);
+    ASSERT(m_cacheDirPath.length() || isWritingBundle());
     ASSERT(!m_currentContext.m_cacheFilePath.length());
     ASSERT(!m_currentContext.m_cacheStringTable);
 
@@ -578,13 +1329,7 @@ void CodeCache::prepareCacheWriting(const CodeCacheIndex& cacheIndex)
 
     m_currentContext.m_cacheFilePath = createCacheFilePath(m_cacheDirPath, cacheIndex);
     m_currentContext.m_cacheStringTable = new CacheStringTable();
-    FILE* dataFile = fopen(m_currentContext.m_cacheFilePath.data(), "ab");
-    if (UNLIKELY(!dataFile)) {
-        ESCARGOT_LOG_ERROR("[CodeCache] can't open the cache data file %s\n", m_currentContext.m_cacheFilePath.data());
-        m_status = Status::FAILED;
-        return;
-    }
-    m_currentContext.m_cacheFile = dataFile;
+    m_currentContext.m_writeJob = new CodeCacheWriteJob(cacheIndex);
 }
 
 bool CodeCache::postCacheLoading()
@@ -598,6 +1343,12 @@ bool CodeCache::postCacheLoading()
         return true;
     }
 
+    if (m_status == Status::STALE) {
+        // the cache itself is fine, only this entry was outdated
+        m_status = Status::READY;
+        return false;
+    }
+
     // failed to load cache
     clearAll();
     m_status = Status::READY;
@@ -606,27 +1357,28 @@ bool CodeCache::postCacheLoading()
 
 bool CodeCache::postCacheWriting(const CodeCacheIndex& cacheIndex)
 {
-    ASSERT(m_enabled);
+    ASSERT(m_enabled || m_bundleMode);
+    ASSERT(!!m_currentContext.m_writeJob);
 
+    bool result = false;
     if (LIKELY(m_status == Status::FINISH)) {
-        // write time stamp
-        m_cacheLRUList[cacheIndex.scriptID()] = fastTickCount();
-
-        if (addCacheEntry(cacheIndex, m_currentContext.m_cacheEntry)) {
-            if (writeCacheList()) {
-                reset();
-                m_status = Status::READY;
-
-                return true;
-            }
+        // files are written and published by the writer thread
+        CodeCacheWriteJob* job = m_currentContext.m_writeJob;
+        m_currentContext.m_writeJob = nullptr;
+        if (isWritingBundle()) {
+            // collected until endBundleWriting()
+            m_bundleJobs.push_back(job);
+            result = true;
+        } else {
+            result = enqueueWriteJob(job);
         }
     }
 
-    // failed to write cache
+    // nothing has been written to the cache directory on failure,
+    // so only this entry is dropped
     reset();
-    clearAll();
     m_status = Status::READY;
-    return false;
+    return result;
 }
 
 void CodeCache::storeStringTable()
@@ -658,7 +1410,7 @@ void CodeCache::storeCodeBlockTree(InterpretedCodeBlock* topCodeBlock, CodeBlock
     }
 
     ASSERT(!!codeBlockCacheInfo);
-    ASSERT(m_currentContext.m_cacheDataOffset == 0);
+    ASSERT(m_currentContext.m_writeJob && m_currentContext.m_writeJob->m_sections.empty());
     ASSERT(!!m_currentContext.m_cacheStringTable);
     ASSERT(!!topCodeBlock);
 
@@ -789,7 +1541,8 @@ InterpretedCodeBlock* CodeCache::loadCodeBlockTree(Context* context, Script* scr
     }
 
     // load bytecode of functions
-    if (m_shouldLoadFunctionOnScriptLoading) {
+    // functions of a bundle are decoded lazily from the bundle itself
+    if (m_shouldLoadFunctionOnScriptLoading && !m_bundleMode) {
         loadAllByteCodeBlockOfFunctions(context, tempCodeBlockVector, script);
     }
 
@@ -841,9 +1594,9 @@ void CodeCache::loadAllByteCodeBlockOfFunctions(Context* context, std::vector<In
 {
     // load CodeBlock of functions during loading of global code
     ASSERT(m_enabled && m_status == Status::IN_PROGRESS);
-    ASSERT(m_currentContext.m_cacheFilePath.length() && m_currentContext.m_cacheFile);
+    ASSERT(m_currentContext.m_cacheFilePath.length() && m_currentContext.m_cacheData);
 
-    size_t srcHash = script->sourceCodeHashValue();
+    CodeCacheHash srcHash = script->sourceCodeHashValue();
     size_t srcLength = script->sourceCode()->length();
 
     // hold the current context
@@ -854,8 +1607,12 @@ void CodeCache::loadAllByteCodeBlockOfFunctions(Context* context, std::vector<In
         InterpretedCodeBlock* codeBlock = codeBlockVector[i];
         ASSERT(script == codeBlock->script());
         auto result = searchCache(CodeCacheIndex(srcHash, srcLength, codeBlock->functionStart().index));
-        if (result.first) {
+        if (result.first && result.second.m_dataFileID == previousContext.m_cacheEntry.m_dataFileID) {
             CodeCacheEntry& cacheEntry = result.second;
+            if (UNLIKELY(!verifyCacheData(cacheEntry))) {
+                // leave this function to be compiled from source
+                continue;
+            }
 
             // init context
             m_currentContext.m_cacheEntry = cacheEntry;
@@ -891,129 +1648,237 @@ void CodeCache::loadAllByteCodeBlockOfFunctions(Context* context, std::vector<In
     m_currentContext = previousContext;
 }
 
-bool CodeCache::writeCacheList()
+bool CodeCache::writeCacheList(const CodeCacheListMap& list, CacheListStamp& stamp)
 {
     ASSERT(m_enabled);
     ASSERT(m_cacheDirPath.length());
 
+    // readers look up the list without locking, so it is written aside and replaced at once
     std::string cacheListFilePath = m_cacheDirPath + CODE_CACHE_LIST_FILE_NAME;
-    FILE* listFile = fopen(cacheListFilePath.data(), "wb");
+    std::string tempListFilePath = createTempFilePath(cacheListFilePath);
+    FILE* listFile = fopen(tempListFilePath.data(), "wb");
     if (UNLIKELY(!listFile)) {
-        ESCARGOT_LOG_ERROR("[CodeCache] can't open the cache list file %s\n", cacheListFilePath.data());
+        ESCARGOT_LOG_ERROR("[CodeCache] can't open the cache list file %s\n", tempListFilePath.data());
         return false;
     }
 
-    // first write Escargot version
-    // must select the same version string as loadCacheList()
-#ifdef ESCARGOT_BUILD
-    std::string version = ESCARGOT_BUILD;
-#else
-    std::string version = ESCARGOT_VERSION;
-#endif
-    ASSERT(version.length() > 0);
-    size_t versionHash = std::hash<std::string>{}(version);
-    if (UNLIKELY(fwrite(&versionHash, sizeof(size_t), 1, listFile) != 1)) {
+    // first write Escargot build ID
+    const CodeCacheHash& buildID = CodeCacheHash::buildID();
+    if (UNLIKELY(fwrite(&buildID, sizeof(CodeCacheHash), 1, listFile) != 1)) {
         ESCARGOT_LOG_ERROR("[CodeCache] fwrite of %s failed\n", cacheListFilePath.data());
         fclose(listFile);
+        unlink(tempListFilePath.data());
         return false;
     }
 
-    size_t listSize = m_cacheList.size();
+    size_t listSize = list.size();
     // write the number of cache entries
     if (UNLIKELY(fwrite(&listSize, sizeof(size_t), 1, listFile) != 1)) {
         ESCARGOT_LOG_ERROR("[CodeCache] fwrite of %s failed\n", cacheListFilePath.data());
         fclose(listFile);
+        unlink(tempListFilePath.data());
         return false;
     }
 
     size_t entryCount = 0;
-    auto iter = m_cacheList.begin();
+    CodeCacheHash checksum = buildID;
+    auto iter = list.begin();
     while (entryCount < listSize) {
-        ASSERT(iter != m_cacheList.end());
+        ASSERT(iter != list.end());
 
         CodeCacheEntryChunk entryChunk(iter->first, iter->second);
         if (UNLIKELY(fwrite(&entryChunk, sizeof(CodeCacheEntryChunk), 1, listFile) != 1)) {
             ESCARGOT_LOG_ERROR("[CodeCache] fwrite of %s failed\n", cacheListFilePath.data());
             fclose(listFile);
+            unlink(tempListFilePath.data());
             return false;
         }
+        checksum = CodeCacheHash::compute(&entryChunk, sizeof(CodeCacheEntryChunk), checksum);
 
         entryCount++;
         iter++;
     }
-    ASSERT(iter == m_cacheList.end());
+    ASSERT(iter == list.end());
+
+    // checksum of the whole list goes last
+    if (UNLIKELY(fwrite(&checksum, sizeof(CodeCacheHash), 1, listFile) != 1)) {
+        ESCARGOT_LOG_ERROR("[CodeCache] fwrite of %s failed\n", cacheListFilePath.data());
+        fclose(listFile);
+        unlink(tempListFilePath.data());
+        return false;
+    }
 
     fflush(listFile);
     // FIXME frequent fsync calls can slow down the overall performance
     /* for performance issue, fsync is skipped for now
     fsync(fileno(listFile));
     */
+
+    // remember the published list, it needs no reloading until another process replaces it
+    struct stat statFile;
+    bool hasStat = fstat(fileno(listFile), &statFile) == 0;
     fclose(listFile);
+
+    if (UNLIKELY(rename(tempListFilePath.data(), cacheListFilePath.data()) != 0)) {
+        ESCARGOT_LOG_ERROR("[CodeCache] can't publish the cache list file %s\n", cacheListFilePath.data());
+        unlink(tempListFilePath.data());
+        return false;
+    }
+
+    stamp = CacheListStamp();
+    if (LIKELY(hasStat)) {
+        stamp.m_inode = statFile.st_ino;
+        stamp.m_modifiedTime = statFile.st_mtime;
+        stamp.m_size = statFile.st_size;
+    }
     return true;
 }
 
 bool CodeCache::writeCacheData(CodeCacheType type, size_t extraCount)
 {
-    ASSERT(m_enabled);
+    ASSERT(m_enabled || m_bundleMode);
     ASSERT(type == CodeCacheType::CACHE_CODEBLOCK || type == CodeCacheType::CACHE_BYTECODE || type == CodeCacheType::CACHE_STRING);
-    ASSERT(!!m_currentContext.m_cacheFilePath.length());
-    ASSERT(!!m_currentContext.m_cacheFile);
+    ASSERT(!!m_currentContext.m_writeJob);
 
-    FILE* dataFile = m_currentContext.m_cacheFile;
+    // snapshot the serialized data, the file offsets are decided by the writer thread
+    CodeCacheWriteJob::Section section;
+    section.m_type = type;
+    // extraCount represents the total count of CodeBlocks used only for CodeBlockTree caching
+    section.m_extraCount = extraCount;
+    section.m_data.assign(m_cacheWriter->bufferData(), m_cacheWriter->bufferData() + m_cacheWriter->bufferSize());
+    m_currentContext.m_writeJob->m_sections.push_back(std::move(section));
 
-    // meta info
-    CodeCacheMetaInfo meta(type, m_currentContext.m_cacheDataOffset, m_cacheWriter->bufferSize());
-    if (type == CodeCacheType::CACHE_CODEBLOCK) {
-        ASSERT(m_currentContext.m_cacheDataOffset == 0);
-        // extraCount represents the total count of CodeBlocks used only for CodeBlockTree caching
-        meta.codeBlockCount = extraCount;
-    }
+    m_cacheWriter->clearBuffer();
+    return true;
+}
 
-    // record correct position for function
-    if (type != CodeCacheType::CACHE_CODEBLOCK && m_currentContext.m_cacheDataOffset == 0) {
-        meta.dataOffset = m_currentContext.m_cacheDataOffset = ftell(dataFile);
+void CodeCache::layoutCacheEntry(const CodeCacheWriteJob* job, size_t dataOffset, CodeCacheEntry& entry)
+{
+    // sections are placed back to back in file order from dataOffset
+    for (size_t i = 0; i < job->m_sections.size(); i++) {
+        const CodeCacheWriteJob::Section& section = job->m_sections[i];
+        CodeCacheMetaInfo meta(section.m_type, dataOffset, section.m_data.size());
+        if (section.m_type == CodeCacheType::CACHE_CODEBLOCK) {
+            ASSERT(dataOffset == 0);
+            meta.codeBlockCount = section.m_extraCount;
+        }
+        entry.m_metaInfos[(size_t)section.m_type] = meta;
+        dataOffset += section.m_data.size();
     }
 
-    m_currentContext.m_cacheEntry.m_metaInfos[(size_t)type] = meta;
+    // verified by verifyCacheData() before anything is decoded
+    entry.m_checksum = CodeCacheHash();
+    for (size_t type = 0; type < (size_t)CodeCacheType::CACHE_TYPE_NUM; type++) {
+        for (size_t i = 0; i < job->m_sections.size(); i++) {
+            const CodeCacheWriteJob::Section& section = job->m_sections[i];
+            if ((size_t)section.m_type == type) {
+                entry.m_checksum = CodeCacheHash::compute(section.m_data.data(), section.m_data.size(), entry.m_checksum);
+            }
+        }
+    }
+}
 
-    // write cache data
-    if (UNLIKELY(fwrite(m_cacheWriter->bufferData(), sizeof(char), m_cacheWriter->bufferSize(), dataFile) != m_cacheWriter->bufferSize())) {
-        ESCARGOT_LOG_ERROR("[CodeCache] fwrite of %s failed\n", m_currentContext.m_cacheFilePath.data());
-        m_cacheWriter->clearBuffer();
+bool CodeCache::writeCacheDataFile(CodeCacheWriteJob* job, CodeCacheEntry& entry)
+{
+    ASSERT(m_enabled);
+    ASSERT(job->m_sections.size());
+
+    std::string filePath = createCacheFilePath(m_cacheDirPath, job->m_cacheIndex);
+    std::string tempFilePath;
+    FILE* dataFile;
+    if (job->m_cacheIndex.m_functionIndex == SIZE_MAX) {
+        // a new image of the script is written aside and published by rename(),
+        // so that other processes never map a partially written file
+        tempFilePath = createTempFilePath(filePath);
+        dataFile = fopen(tempFilePath.data(), "wb");
+    } else {
+        // function caches are appended under the writer lock,
+        // readers only access the ranges listed before
+        dataFile = fopen(filePath.data(), "ab");
+    }
+    if (UNLIKELY(!dataFile)) {
+        ESCARGOT_LOG_ERROR("[CodeCache] can't open the cache data file %s\n", filePath.data());
         return false;
     }
 
+    struct stat statFile;
+    bool result = fstat(fileno(dataFile), &statFile) == 0;
+    if (LIKELY(result)) {
+        entry.m_dataFileID = statFile.st_ino;
+
+        // nobody else appends while the writer lock is held
+        layoutCacheEntry(job, statFile.st_size, entry);
+        for (size_t i = 0; i < job->m_sections.size(); i++) {
+            const CodeCacheWriteJob::Section& section = job->m_sections[i];
+            if (UNLIKELY(fwrite(section.m_data.data(), sizeof(char), section.m_data.size(), dataFile) != section.m_data.size())) {
+                ESCARGOT_LOG_ERROR("[CodeCache] fwrite of %s failed\n", filePath.data());
+                result = false;
+                break;
+            }
+        }
+    }
+
     fflush(dataFile);
     // FIXME frequent fsync calls can slow down the overall performance
     /* for performance issue, fsync is skipped for now
     fsync(fileno(dataFile));
     */
+    fclose(dataFile);
 
-    m_currentContext.m_cacheDataOffset += m_cacheWriter->bufferSize();
-    m_cacheWriter->clearBuffer();
-    return true;
+    if (tempFilePath.length()) {
+        // publish the data file before the list that refers to it
+        if (UNLIKELY(!result || rename(tempFilePath.data(), filePath.data()) != 0)) {
+            ESCARGOT_LOG_ERROR("[CodeCache] can't publish the cache data file %s\n", filePath.data());
+            unlink(tempFilePath.data());
+            return false;
+        }
+    }
+
+    return result;
 }
 
 bool CodeCache::readCacheData(CodeCacheMetaInfo& metaInfo)
 {
-    ASSERT(m_enabled);
+    ASSERT(m_enabled || m_bundleMode);
     ASSERT(metaInfo.cacheType == CodeCacheType::CACHE_CODEBLOCK || metaInfo.cacheType == CodeCacheType::CACHE_BYTECODE || metaInfo.cacheType == CodeCacheType::CACHE_STRING);
     ASSERT(!!m_currentContext.m_cacheFilePath.length());
-    ASSERT(!!m_currentContext.m_cacheFile);
+    ASSERT(!!m_currentContext.m_cacheData);
 
     size_t dataOffset = metaInfo.cacheType == CodeCacheType::CACHE_CODEBLOCK ? 0 : metaInfo.dataOffset;
-    FILE* dataFile = m_currentContext.m_cacheFile;
-
-    if (UNLIKELY(fseek(dataFile, dataOffset, SEEK_SET) != 0)) {
-        ESCARGOT_LOG_ERROR("[CodeCache] can't seek the cache data file %s\n", m_currentContext.m_cacheFilePath.data());
+    if (UNLIKELY(dataOffset > m_currentContext.m_cacheDataSize || metaInfo.dataSize > m_currentContext.m_cacheDataSize - dataOffset)) {
+        ESCARGOT_LOG_ERROR("[CodeCache] load cache data of %s failed\n", m_currentContext.m_cacheFilePath.data());
         return false;
     }
 
-    if (UNLIKELY(!m_cacheReader->loadData(dataFile, metaInfo.dataSize))) {
-        ESCARGOT_LOG_ERROR("[CodeCache] load cache data of %s failed\n", m_currentContext.m_cacheFilePath.data());
-        return false;
+    // the reader decodes directly from the mapped pages without copying
+    m_cacheReader->loadData(m_currentContext.m_cacheData + dataOffset, metaInfo.dataSize);
+    return true;
+}
+
+bool CodeCache::verifyCacheData(const CodeCacheEntry& entry)
+{
+    ASSERT(m_enabled || m_bundleMode);
+    ASSERT(!!m_currentContext.m_cacheData);
+
+    // hash every section in the same order as writeCacheDataFile()
+    CodeCacheHash checksum;
+    for (size_t i = 0; i < (size_t)CodeCacheType::CACHE_TYPE_NUM; i++) {
+        const CodeCacheMetaInfo& metaInfo = entry.m_metaInfos[i];
+        if (metaInfo.cacheType == CodeCacheType::CACHE_INVALID) {
+            continue;
+        }
+        size_t dataOffset = metaInfo.cacheType == CodeCacheType::CACHE_CODEBLOCK ? 0 : metaInfo.dataOffset;
+        if (UNLIKELY(dataOffset > m_currentContext.m_cacheDataSize || metaInfo.dataSize > m_currentContext.m_cacheDataSize - dataOffset)) {
+            ESCARGOT_LOG_ERROR("[CodeCache] cache data of %s is truncated\n", m_currentContext.m_cacheFilePath.data());
+            return false;
+        }
+        checksum = CodeCacheHash::compute(m_currentContext.m_cacheData + dataOffset, metaInfo.dataSize, checksum);
     }
 
+    if (UNLIKELY(checksum != entry.m_checksum)) {
+        ESCARGOT_LOG_ERROR("[CodeCache] checksum mismatch of %s\n", m_currentContext.m_cacheFilePath.data());
+        return false;
+    }
     return true;
 }
 
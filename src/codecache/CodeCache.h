@@ -23,6 +23,7 @@
 #if defined(ENABLE_CODE_CACHE)
 
 #include <sstream>
+#include "codecache/CodeCacheHash.h"
 
 #ifndef OS_POSIX
 #error "Code Cache does not support OS other than POSIX"
@@ -40,6 +41,15 @@
 #define CODE_CACHE_SHOULD_LOAD_FUNCTIONS_ON_SCRIPT_LOADING false
 #endif
 
+#ifndef CODE_CACHE_MAX_PENDING_WRITE_COUNT
+#define CODE_CACHE_MAX_PENDING_WRITE_COUNT 32
+#endif
+
+// min interval (ms) between checks of the list file on cache misses
+#ifndef CODE_CACHE_LIST_REFRESH_INTERVAL
+#define CODE_CACHE_LIST_REFRESH_INTERVAL 100
+#endif
+
 namespace Escargot {
 
 class Script;
@@ -93,25 +103,24 @@ struct CodeCacheMetaInfo {
 };
 
 struct CodeCacheIndex {
-    size_t m_srcHash; // hash value of source code
+    CodeCacheHash m_srcHash; // content hash of source code seeded by CodeCacheHash::buildID
     size_t m_srcLength; // length of source code
     size_t m_functionIndex; // index of function start position (SIZE_MAX for global code)
 
     struct ScriptID {
-        size_t m_srcHash;
+        CodeCacheHash m_srcHash;
         size_t m_srcLength;
 
         ScriptID()
-            : m_srcHash(0)
-            , m_srcLength(0)
+            : m_srcLength(0)
         {
         }
 
-        ScriptID(size_t srcHash, size_t srcLength)
+        ScriptID(const CodeCacheHash& srcHash, size_t srcLength)
             : m_srcHash(srcHash)
             , m_srcLength(srcLength)
         {
-            ASSERT(srcHash && srcLength);
+            ASSERT(srcHash.isValid() && srcLength);
         }
 
         bool operator==(const ScriptID& src) const
@@ -121,13 +130,12 @@ struct CodeCacheIndex {
     };
 
     CodeCacheIndex()
-        : m_srcHash(0)
-        , m_srcLength(0)
+        : m_srcLength(0)
         , m_functionIndex(0)
     {
     }
 
-    CodeCacheIndex(size_t srcHash, size_t srcLength, size_t funcIndex)
+    CodeCacheIndex(const CodeCacheHash& srcHash, size_t srcLength, size_t funcIndex)
         : m_srcHash(srcHash)
         , m_srcLength(srcLength)
         , m_functionIndex(funcIndex)
@@ -143,12 +151,14 @@ struct CodeCacheIndex {
 
     bool isValid() const
     {
-        return m_srcHash && m_srcLength;
+        return m_srcHash.isValid() && m_srcLength;
     }
 
     void createCacheFileName(std::stringstream& ss) const
     {
-        ss << m_srcHash;
+        std::string hash;
+        m_srcHash.appendHexString(hash);
+        ss << hash;
         ss << '_';
         ss << m_srcLength;
     }
@@ -166,7 +176,7 @@ template <>
 struct hash<Escargot::CodeCacheIndex> {
     size_t operator()(Escargot::CodeCacheIndex const& x) const
     {
-        return x.m_srcHash + x.m_functionIndex;
+        return x.m_srcHash.m_low + x.m_functionIndex;
     }
 };
 
@@ -182,7 +192,7 @@ template <>
 struct hash<Escargot::CodeCacheIndex::ScriptID> {
     size_t operator()(Escargot::CodeCacheIndex::ScriptID const& x) const
     {
-        return x.m_srcHash;
+        return x.m_srcHash.m_low;
     }
 };
 
@@ -200,6 +210,7 @@ namespace Escargot {
 
 struct CodeCacheEntry {
     CodeCacheEntry()
+        : m_dataFileID(0)
     {
     }
 
@@ -208,8 +219,12 @@ struct CodeCacheEntry {
         for (size_t i = 0; i < (size_t)CodeCacheType::CACHE_TYPE_NUM; i++) {
             m_metaInfos[i].cacheType = CodeCacheType::CACHE_INVALID;
         }
+        m_dataFileID = 0;
+        m_checksum = CodeCacheHash();
     }
     CodeCacheMetaInfo m_metaInfos[(size_t)CodeCacheType::CACHE_TYPE_NUM];
+    uint64_t m_dataFileID; // inode of the data file the offsets refer to
+    CodeCacheHash m_checksum; // of the data of every section in CodeCacheType order
 };
 
 class CodeCache {
@@ -222,13 +237,33 @@ public:
         IN_PROGRESS,
         FINISH,
         FAILED,
+        STALE, // data file was replaced by another process
+    };
+
+    // serialized image of one cache entry
+    // the executing thread only snapshots the data, files are written by the writer thread
+    struct CodeCacheWriteJob {
+        struct Section {
+            CodeCacheType m_type;
+            size_t m_extraCount;
+            std::vector<char> m_data;
+        };
+
+        explicit CodeCacheWriteJob(const CodeCacheIndex& cacheIndex)
+            : m_cacheIndex(cacheIndex)
+        {
+        }
+
+        CodeCacheIndex m_cacheIndex;
+        std::vector<Section> m_sections; // in file order
     };
 
     struct CodeCacheContext {
         CodeCacheContext()
-            : m_cacheFile(nullptr)
+            : m_cacheData(nullptr)
+            , m_cacheDataSize(0)
             , m_cacheStringTable(nullptr)
-            , m_cacheDataOffset(0)
+            , m_writeJob(nullptr)
         {
         }
 
@@ -236,9 +271,10 @@ public:
 
         std::string m_cacheFilePath; // current cache data file path
         CodeCacheEntry m_cacheEntry; // current cache entry
-        FILE* m_cacheFile; // current cache data file
+        const char* m_cacheData; // mapped image of current cache data file (loading only)
+        size_t m_cacheDataSize; // size of m_cacheData
         CacheStringTable* m_cacheStringTable; // current CacheStringTable
-        size_t m_cacheDataOffset; // current offset in cache data file
+        CodeCacheWriteJob* m_writeJob; // serialized sections of current cache entry (writing only)
     };
 
     struct CodeCacheEntryChunk {
@@ -256,10 +292,56 @@ public:
         CodeCacheEntry m_entry;
     };
 
+    // identity of the cache list file, to notice when another process has replaced it
+    struct CacheListStamp {
+        CacheListStamp()
+            : m_inode(0)
+            , m_modifiedTime(0)
+            , m_size(0)
+        {
+        }
+
+        bool operator==(const CacheListStamp& src) const
+        {
+            return m_inode == src.m_inode && m_modifiedTime == src.m_modifiedTime && m_size == src.m_size;
+        }
+
+        uint64_t m_inode;
+        uint64_t m_modifiedTime;
+        uint64_t m_size;
+    };
+
+    // head of a precompiled bundle, followed by the entry chunks sorted by function index
+    // and the data of every entry. offsets of the entries are relative to the data
+    struct BundleHeader {
+        uint64_t m_magic;
+        CodeCacheHash m_buildID;
+        CodeCacheHash m_srcHash;
+        uint64_t m_srcLength;
+        uint64_t m_entryCount;
+        CodeCacheHash m_checksum; // of the entry chunks
+    };
+
+    // read-only shared mapping of a cache data file
+    // kept alive across loads so that each function is decoded lazily from the same pages
+    struct MappedCacheFile {
+        MappedCacheFile()
+            : m_data(nullptr)
+            , m_size(0)
+            , m_fileID(0)
+        {
+        }
+
+        char* m_data;
+        size_t m_size;
+        uint64_t m_fileID;
+    };
+
     CodeCache(const char* baseCacheDir);
     ~CodeCache();
 
     bool enabled() const { return m_enabled; }
+    static CodeCacheHash computeSourceHash(String* source);
     std::pair<bool, CodeCacheEntry> searchCache(const CodeCacheIndex& cacheIndex);
 
     bool loadGlobalCache(Context* context, const CodeCacheIndex& cacheIndex, const CodeCacheEntry& entry, Script* script);
@@ -268,6 +350,19 @@ public:
     bool storeFunctionCache(Context* context, const CodeCacheIndex& cacheIndex, InterpretedCodeBlock* codeBlock, Node* functionNode);
 
     void clear();
+    // block until every queued cache entry has been written
+    void flush();
+
+    // bundles are written and loaded regardless of the cache directory
+    // while writing a bundle, stored entries are collected instead of written to the directory
+    void beginBundleWriting();
+    bool endBundleWriting(std::vector<char>& bundle);
+    // join bundles of the same source which hold different functions (see ScriptParser::compileScriptBundle)
+    static bool mergeBundles(const std::vector<std::vector<char>>& parts, std::vector<char>& bundle);
+    bool isWritingBundle() const { return m_bundleMode && !m_currentBundleData; }
+    bool loadBundle(Context* context, const char* bundleData, size_t bundleSize, Script* script, bool verifySourceHash);
+    // load a function of the script of codeBlock from its bundle, or from a bundle compiled for it in parallel
+    bool loadBundleFunction(Context* context, InterpretedCodeBlock* codeBlock, const char* bundleData, size_t bundleSize);
 
     size_t minSourceLength();
     void setMinSourceLength(size_t s);
@@ -283,34 +378,77 @@ private:
 
     typedef std::unordered_map<CodeCacheIndex, CodeCacheEntry, std::hash<CodeCacheIndex>, std::equal_to<CodeCacheIndex>, std::allocator<std::pair<CodeCacheIndex const, CodeCacheEntry>>> CodeCacheListMap;
     CodeCacheListMap m_cacheList;
+    CacheListStamp m_cacheListStamp;
+#if defined(ENABLE_THREADING)
+    std::mutex m_cacheListMutex; // guards m_cacheList and m_cacheListStamp against the writer thread
+#endif
     typedef std::unordered_map<CodeCacheIndex::ScriptID, uint64_t, std::hash<CodeCacheIndex::ScriptID>, std::equal_to<CodeCacheIndex::ScriptID>, std::allocator<std::pair<CodeCacheIndex::ScriptID const, uint64_t>>> CodeCacheLRUList; /* <Hash, TimeStamp> */
+    // LRU state is per-process: only scripts written by this process are tracked,
+    // so maxCacheCount bounds what each process adds and entries written by
+    // other processes are never evicted here
     CodeCacheLRUList m_cacheLRUList;
+    typedef std::unordered_map<CodeCacheIndex::ScriptID, MappedCacheFile, std::hash<CodeCacheIndex::ScriptID>, std::equal_to<CodeCacheIndex::ScriptID>, std::allocator<std::pair<CodeCacheIndex::ScriptID const, MappedCacheFile>>> MappedCacheFileMap;
+    MappedCacheFileMap m_mappedFiles;
 
     CodeCacheWriter* m_cacheWriter;
     CodeCacheReader* m_cacheReader;
 
-    int m_cacheDirFD; // CodeCache directory file descriptor
+    bool m_bundleMode; // writing or loading a bundle
+    Status m_statusBeforeBundle;
+    std::vector<CodeCacheWriteJob*> m_bundleJobs;
+    const char* m_currentBundleData; // bundle being loaded
+
+    int m_cacheDirFD; // CodeCache directory file descriptor (shared lock held while in use)
+    int m_cacheLockFD; // lock file descriptor serializing writers across processes
     bool m_enabled; // CodeCache enabled
     bool m_shouldLoadFunctionOnScriptLoading;
     Status m_status; // current caching status
 
     size_t m_minSourceLength;
     size_t m_maxCacheCount;
+    uint64_t m_cacheListRefreshTime; // last check of the list file on a cache miss
+
+#if defined(ENABLE_THREADING)
+    std::thread m_writerThread;
+    std::mutex m_writeQueueMutex;
+    std::condition_variable m_writeQueueCondition;
+    std::deque<CodeCacheWriteJob*> m_writeQueue;
+    bool m_isWriting; // writer thread is handling a job taken out of m_writeQueue
+    bool m_shouldStopWriter;
+#endif
 
     void initialize(const char* baseCacheDir);
     bool tryInitCacheDir();
     bool tryInitCacheList();
+    bool readCacheList(CodeCacheListMap& list, CacheListStamp& stamp);
+    CacheListStamp statCacheList();
+    bool refreshCacheList();
+
+    bool enqueueWriteJob(CodeCacheWriteJob* job);
+#if defined(ENABLE_THREADING)
+    void runWriterThread();
+#endif
+    void stopWriterThread();
+    void writeJob(CodeCacheWriteJob* job);
     void unLockAndCloseCacheDir();
     void clearCacheDir();
 
     void clearAll();
     void reset();
     void setCacheEntry(const CodeCacheEntryChunk& entryChunk);
-    bool addCacheEntry(const CodeCacheIndex& cacheIndex, const CodeCacheEntry& entry);
+    bool addCacheEntry(CodeCacheListMap& list, const CodeCacheIndex& cacheIndex, const CodeCacheEntry& entry);
 
-    bool removeLRUCacheEntry();
+    bool removeLRUCacheEntry(CodeCacheListMap& list);
     bool removeCacheFile(const CodeCacheIndex::ScriptID& scriptID);
 
+    const MappedCacheFile* mapCacheFile(const CodeCacheIndex::ScriptID& scriptID, const std::string& filePath, uint64_t fileID, size_t requiredSize);
+    void unmapCacheFile(const CodeCacheIndex::ScriptID& scriptID);
+    void unmapAllCacheFiles();
+
+    void ensureReaderWriter();
+    static bool findBundleEntry(const char* bundleData, size_t functionIndex, CodeCacheEntry& entry);
+    bool loadBundleEntry(Context* context, const char* bundleData, size_t bundleSize, const CodeCacheEntry& entry, Script* script, InterpretedCodeBlock* codeBlock);
+
     void prepareCacheLoading(Context* context, const CodeCacheIndex& cacheIndex, const CodeCacheEntry& entry);
     bool postCacheLoading();
     CacheStringTable* loadCacheStringTable(Context* context);
@@ -327,9 +465,12 @@ private:
     void storeCodeBlockTreeNode(InterpretedCodeBlock* codeBlock, size_t& nodeCount);
     InterpretedCodeBlock* loadCodeBlockTreeNode(Script* script);
 
-    bool writeCacheList();
+    bool writeCacheList(const CodeCacheListMap& list, CacheListStamp& stamp);
     bool writeCacheData(CodeCacheType type, size_t extraCount = 0);
+    static void layoutCacheEntry(const CodeCacheWriteJob* job, size_t dataOffset, CodeCacheEntry& entry);
+    bool writeCacheDataFile(CodeCacheWriteJob* job, CodeCacheEntry& entry);
     bool readCacheData(CodeCacheMetaInfo& metaInfo);
+    bool verifyCacheData(const CodeCacheEntry& entry);
 };
 } // namespace Escargot
 
@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2026-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#if defined(ENABLE_CODE_CACHE)
+
+#include "Escargot.h"
+#include "codecache/CodeCacheHash.h"
+
+namespace Escargot {
+
+static inline uint64_t rotateLeft(uint64_t x, int r)
+{
+    return (x << r) | (x >> (64 - r));
+}
+
+static inline uint64_t finalMix(uint64_t k)
+{
+    k ^= k >> 33;
+    k *= 0xff51afd7ed558ccdULL;
+    k ^= k >> 33;
+    k *= 0xc4ceb9fe1a85ec53ULL;
+    k ^= k >> 33;
+    return k;
+}
+
+CodeCacheHash CodeCacheHash::compute(const void* data, size_t size, const CodeCacheHash& seed)
+{
+    const uint64_t c1 = 0x87c37b91114253d5ULL;
+    const uint64_t c2 = 0x4cf5ad432745937fULL;
+
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    const size_t blockCount = size / 16;
+    uint64_t h1 = seed.m_low;
+    uint64_t h2 = seed.m_high;
+
+    for (size_t i = 0; i < blockCount; i++) {
+        uint64_t k1, k2;
+        memcpy(&k1, bytes + i * 16, sizeof(uint64_t));
+        memcpy(&k2, bytes + i * 16 + 8, sizeof(uint64_t));
+
+        k1 *= c1;
+        k1 = rotateLeft(k1, 31);
+        k1 *= c2;
+        h1 ^= k1;
+        h1 = rotateLeft(h1, 27);
+        h1 += h2;
+        h1 = h1 * 5 + 0x52dce729;
+
+        k2 *= c2;
+        k2 = rotateLeft(k2, 33);
+        k2 *= c1;
+        h2 ^= k2;
+        h2 = rotateLeft(h2, 31);
+        h2 += h1;
+        h2 = h2 * 5 + 0x38495ab5;
+    }
+
+    const uint8_t* tail = bytes + blockCount * 16;
+    const size_t tailSize = size & 15;
+    uint64_t k1 = 0;
+    uint64_t k2 = 0;
+    for (size_t i = 0; i < tailSize; i++) {
+        if (i < 8) {
+            k1 ^= static_cast<uint64_t>(tail[i]) << (i * 8);
+        } else {
+            k2 ^= static_cast<uint64_t>(tail[i]) << ((i - 8) * 8);
+        }
+    }
+    if (tailSize > 8) {
+        k2 *= c2;
+        k2 = rotateLeft(k2, 33);
+        k2 *= c1;
+        h2 ^= k2;
+    }
+    if (tailSize > 0) {
+        k1 *= c1;
+        k1 = rotateLeft(k1, 31);
+        k1 *= c2;
+        h1 ^= k1;
+    }
+
+    h1 ^= size;
+    h2 ^= size;
+    h1 += h2;
+    h2 += h1;
+    h1 = finalMix(h1);
+    h2 = finalMix(h2);
+    h1 += h2;
+    h2 += h1;
+
+    return CodeCacheHash(h1, h2);
+}
+
+static CodeCacheHash computeBuildID()
+{
+    // must select the same version string on every process sharing the cache
+#ifdef ESCARGOT_BUILD
+    std::string str = ESCARGOT_BUILD;
+#else
+    std::string str = ESCARGOT_VERSION;
+#endif
+#ifndef NDEBUG
+    str += ";debug";
+#endif
+#if defined(ESCARGOT_DEBUGGER)
+    str += ";debugger";
+#endif
+#if defined(ENABLE_TCO)
+    str += ";tco";
+#endif
+    const uint32_t byteOrderMark = 0x01020304;
+    const size_t layout[] = { CODE_CACHE_FORMAT_VERSION, sizeof(void*), sizeof(size_t), sizeof(double) };
+
+    CodeCacheHash result = CodeCacheHash::compute(str.data(), str.length(), CodeCacheHash());
+    result = CodeCacheHash::compute(&byteOrderMark, sizeof(byteOrderMark), result);
+    return CodeCacheHash::compute(layout, sizeof(layout), result);
+}
+
+const CodeCacheHash& CodeCacheHash::buildID()
+{
+    // also read by the writer thread, so rely on thread-safe static initialization
+    static const CodeCacheHash id = computeBuildID();
+    return id;
+}
+
+void CodeCacheHash::appendHexString(std::string& str) const
+{
+    static const char digits[] = "0123456789abcdef";
+    const uint64_t parts[] = { m_high, m_low };
+    for (size_t i = 0; i < 2; i++) {
+        for (int shift = 60; shift >= 0; shift -= 4) {
+            str += digits[(parts[i] >> shift) & 0xf];
+        }
+    }
+}
+
+} // namespace Escargot
+
+#endif // ENABLE_CODE_CACHE
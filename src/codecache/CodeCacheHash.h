@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2026-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#ifndef __CodeCacheHash__
+#define __CodeCacheHash__
+
+#if defined(ENABLE_CODE_CACHE)
+
+namespace Escargot {
+
+// bump when the layout of cache files changes
+#define CODE_CACHE_FORMAT_VERSION 2
+
+// 128-bit non-cryptographic hash (MurmurHash3 x64_128)
+// used as the key of cached scripts and as the checksum of cache data
+struct CodeCacheHash {
+    CodeCacheHash()
+        : m_low(0)
+        , m_high(0)
+    {
+    }
+
+    CodeCacheHash(uint64_t low, uint64_t high)
+        : m_low(low)
+        , m_high(high)
+    {
+    }
+
+    bool isValid() const
+    {
+        return m_low || m_high;
+    }
+
+    bool operator==(const CodeCacheHash& src) const
+    {
+        return m_low == src.m_low && m_high == src.m_high;
+    }
+
+    bool operator!=(const CodeCacheHash& src) const
+    {
+        return !operator==(src);
+    }
+
+    // chain a hash by passing the previous result as seed
+    static CodeCacheHash compute(const void* data, size_t size, const CodeCacheHash& seed);
+    // identifies the engine build and the flags which change the cache layout
+    static const CodeCacheHash& buildID();
+
+    // 32 hex digits
+    void appendHexString(std::string& str) const;
+
+    uint64_t m_low;
+    uint64_t m_high;
+};
+
+} // namespace Escargot
+
+#endif // ENABLE_CODE_CACHE
+
+#endif
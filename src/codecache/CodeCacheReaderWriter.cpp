@@ -663,35 +663,6 @@ void CodeCacheWriter::storeByteCodeStream(ByteCodeBlock* block)
     }
 }
 
-void CodeCacheReader::CacheBuffer::resize(size_t size)
-{
-    ASSERT(!m_buffer && m_capacity == 0 && m_index == 0);
-
-    m_buffer = static_cast<char*>(malloc(size));
-    m_capacity = size;
-}
-
-void CodeCacheReader::CacheBuffer::reset()
-{
-    if (m_buffer) {
-        free(m_buffer);
-        m_buffer = nullptr;
-    }
-    m_capacity = 0;
-    m_index = 0;
-}
-
-bool CodeCacheReader::loadData(FILE* file, size_t size)
-{
-    m_buffer.resize(size);
-    if (UNLIKELY(fread((void*)bufferData(), sizeof(char), size, file) != size)) {
-        clearBuffer();
-        return false;
-    }
-
-    return true;
-}
-
 InterpretedCodeBlock* CodeCacheReader::loadInterpretedCodeBlock(Context* context, Script* script)
 {
     ASSERT(!!context);
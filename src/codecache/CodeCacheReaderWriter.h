@@ -244,16 +244,22 @@ public:
         {
         }
 
-        ~CacheBuffer()
-        {
-            reset();
-        }
-
-        char* data() const { return m_buffer; }
+        // the buffer is a read-only view (e.g. a mapped cache file), never owned
+        const char* data() const { return m_buffer; }
         size_t size() const { return m_index; }
         size_t index() const { return m_index; }
-        void resize(size_t size);
-        void reset();
+        void setData(const char* data, size_t size)
+        {
+            ASSERT(!m_buffer && m_capacity == 0 && m_index == 0);
+            m_buffer = data;
+            m_capacity = size;
+        }
+        void reset()
+        {
+            m_buffer = nullptr;
+            m_capacity = 0;
+            m_index = 0;
+        }
 
         template <typename IntegralType>
         IntegralType get()
@@ -319,7 +325,7 @@ public:
         }
 
     private:
-        char* m_buffer;
+        const char* m_buffer;
         size_t m_capacity;
         size_t m_index;
     };
@@ -346,10 +352,10 @@ public:
         return m_stringTable;
     }
 
-    char* bufferData() { return m_buffer.data(); }
+    const char* bufferData() { return m_buffer.data(); }
     size_t bufferIndex() const { return m_buffer.index(); }
     void clearBuffer() { m_buffer.reset(); }
-    bool loadData(FILE*, size_t);
+    void loadData(const char* data, size_t size) { m_buffer.setData(data, size); }
 
     InterpretedCodeBlock* loadInterpretedCodeBlock(Context* context, Script* script);
     ByteCodeBlock* loadByteCodeBlock(Context* context, InterpretedCodeBlock* topCodeBlock);
@@ -66,7 +66,6 @@ enum HeapObjectKind : unsigned {
     ArrayBufferObjectKind,
     WeakRefObjectKind,
     FinalizationRegistryObjectItemKind,
-    WeakMapObjectDataItemKind,
 #endif
     NumberOfKind,
 };
@@ -5008,7 +5008,12 @@ NEVER_INLINE void InterpreterSlowPath::executionPauseOperation(ExecutionState& s
         Value ret = yieldIndex == REGISTER_LIMIT ? Value() : registerFile[yieldIndex];
 
         if (code->m_yieldData.m_needsToWrapYieldValueWithIterResultObject) {
-            ret = IteratorObject::createIterResultObject(state, ret, false);
+            ExecutionPauser* executionPauser = state.executionPauser();
+            if (executionPauser->m_resumedWithoutIterResult) {
+                executionPauser->m_yieldedUnwrappedValue = true;
+            } else {
+                ret = IteratorObject::createIterResultObject(state, ret, false);
+            }
         }
 
         size_t nextProgramCounter = programCounter - (size_t)codeBuffer + sizeof(ExecutionPause) + code->m_yieldData.m_tailDataLength;
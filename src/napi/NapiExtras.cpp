@@ -191,51 +191,52 @@ ESCARGOT_NAPI_EXPORT napi_status node_api_create_property_key_utf16(napi_env env
 
 // Also declared (js_native_api.h) but unimplemented - dlopen'd by
 // test_string's addon right alongside node_api_create_property_key_utf16
-// above. StringRef::createExternalFrom* (EscargotPublic.h) has no deleter
-// callback parameter of its own, unlike e.g. BackingStoreRef's - but since
-// the returned StringRef is itself an ordinary GC-heap pointer, a finalizer
-// can still be attached to *it* directly via Memory::gcRegisterFinalizer,
-// exactly as if it were an object (see napi_wrap/napi_create_external's
-// identical pattern - NapiFunctions.cpp/NapiArrayBuffer.cpp), invoking
-// finalize_callback for the caller's original buffer once the wrapping
-// string is collected. This actually avoids copying `str` (`*copied =
-// false`), unlike this milestone's earlier always-copy shortcut: some
-// addons - e.g. test_string/test_string.c's create_external_latin1/
-// create_external_utf16 helpers - specifically assert `copied` comes back
-// false and treat a copy as a test failure.
+// above. Both map directly onto StringRef::createExternalFrom*'s finalizer
+// overloads (EscargotPublic.h), which wrap `str` without copying it
+// (`*copied = false`) and hand it back to finalize_callback once the string
+// is collected - some addons (e.g. test_string/test_string.c's
+// create_external_latin1/create_external_utf16 helpers) specifically assert
+// `copied` comes back false and treat a copy as a test failure. Going
+// through the public API (rather than a bare Memory::gcRegisterFinalizer on
+// the result, as this file did before) also gets the buffer counted in
+// Memory::externalStringSize.
 struct ExternalStringFinalizeData {
     napi_env env;
     node_api_basic_finalize finalizeCb;
-    void* nativeData;
     void* finalizeHint;
 };
 
-static void NapiExternalStringFinalizer(void* self, void* data)
+static void NapiExternalStringFinalizer(void* buffer, void* data)
 {
     ExternalStringFinalizeData* finalizeData = reinterpret_cast<ExternalStringFinalizeData*>(data);
-    finalizeData->finalizeCb(finalizeData->env, finalizeData->nativeData, finalizeData->finalizeHint);
+    finalizeData->finalizeCb(finalizeData->env, buffer, finalizeData->finalizeHint);
     delete finalizeData;
 }
 
+static ExternalStringFinalizeData* NewExternalStringFinalizeData(napi_env env, node_api_basic_finalize finalizeCallback, void* finalizeHint)
+{
+    if (finalizeCallback == nullptr) {
+        return nullptr;
+    }
+    ExternalStringFinalizeData* finalizeData = new ExternalStringFinalizeData();
+    finalizeData->env = env;
+    finalizeData->finalizeCb = finalizeCallback;
+    finalizeData->finalizeHint = finalizeHint;
+    return finalizeData;
+}
+
 ESCARGOT_NAPI_EXPORT napi_status node_api_create_external_string_latin1(napi_env env, char* str, size_t length, node_api_basic_finalize finalize_callback, void* finalize_hint, napi_value* result, bool* copied)
 {
     if (result == nullptr) {
         return SetLastError(env, napi_invalid_arg);
     }
     size_t stringLength = (length == NAPI_AUTO_LENGTH) ? strlen(str) : length;
-    StringRef* strRef = StringRef::createExternalFromLatin1(reinterpret_cast<const unsigned char*>(str), stringLength);
-    *result = ToNapi(strRef);
+    ExternalStringFinalizeData* finalizeData = NewExternalStringFinalizeData(env, finalize_callback, finalize_hint);
+    *result = ToNapi(StringRef::createExternalFromLatin1(reinterpret_cast<const unsigned char*>(str), stringLength,
+                                                         finalizeData ? NapiExternalStringFinalizer : nullptr, finalizeData));
     if (copied != nullptr) {
         *copied = false;
     }
-    if (finalize_callback != nullptr) {
-        ExternalStringFinalizeData* finalizeData = new ExternalStringFinalizeData();
-        finalizeData->env = env;
-        finalizeData->finalizeCb = finalize_callback;
-        finalizeData->nativeData = str;
-        finalizeData->finalizeHint = finalize_hint;
-        Memory::gcRegisterFinalizer(strRef, NapiExternalStringFinalizer, finalizeData);
-    }
     return napi_ok;
 }
 
@@ -245,19 +246,12 @@ ESCARGOT_NAPI_EXPORT napi_status node_api_create_external_string_utf16(napi_env
         return SetLastError(env, napi_invalid_arg);
     }
     size_t stringLength = (length == NAPI_AUTO_LENGTH) ? std::char_traits<char16_t>::length(str) : length;
-    StringRef* strRef = StringRef::createExternalFromUTF16(str, stringLength);
-    *result = ToNapi(strRef);
+    ExternalStringFinalizeData* finalizeData = NewExternalStringFinalizeData(env, finalize_callback, finalize_hint);
+    *result = ToNapi(StringRef::createExternalFromUTF16(str, stringLength,
+                                                        finalizeData ? NapiExternalStringFinalizer : nullptr, finalizeData));
     if (copied != nullptr) {
         *copied = false;
     }
-    if (finalize_callback != nullptr) {
-        ExternalStringFinalizeData* finalizeData = new ExternalStringFinalizeData();
-        finalizeData->env = env;
-        finalizeData->finalizeCb = finalize_callback;
-        finalizeData->nativeData = str;
-        finalizeData->finalizeHint = finalize_hint;
-        Memory::gcRegisterFinalizer(strRef, NapiExternalStringFinalizer, finalizeData);
-    }
     return napi_ok;
 }
 
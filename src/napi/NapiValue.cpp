@@ -30,6 +30,7 @@
 #include <cmath>
 #include <cstdint>
 #include <cstring>
+#include <simdutf.h>
 
 namespace Escargot {
 namespace Napi {
@@ -302,8 +303,17 @@ ESCARGOT_NAPI_EXPORT napi_status napi_get_value_string_latin1(napi_env env, napi
     }
 
     size_t copied = std::min(length, bufsize - 1);
-    for (size_t i = 0; i < copied; i++) {
-        buf[i] = static_cast<char>(str->charAt(i) & 0xFF);
+    StringRef::StringBufferAccessDataRef data = str->stringBufferAccessData();
+    if (data.has8BitContent) {
+        memcpy(buf, data.buffer, copied);
+    } else {
+        const char16_t* src = static_cast<const char16_t*>(data.buffer);
+        // simdutf rejects code units above 0xFF; those are truncated to their low byte instead
+        if (copied && !simdutf::convert_utf16_to_latin1(src, copied, buf)) {
+            for (size_t i = 0; i < copied; i++) {
+                buf[i] = static_cast<char>(src[i] & 0xFF);
+            }
+        }
     }
     buf[copied] = '\0';
     if (result != nullptr) {
@@ -341,8 +351,13 @@ ESCARGOT_NAPI_EXPORT napi_status napi_get_value_string_utf16(napi_env env, napi_
     }
 
     size_t copied = std::min(length, bufsize - 1);
-    for (size_t i = 0; i < copied; i++) {
-        buf[i] = str->charAt(i);
+    StringRef::StringBufferAccessDataRef data = str->stringBufferAccessData();
+    if (data.has8BitContent) {
+        size_t converted = simdutf::convert_latin1_to_utf16(static_cast<const char*>(data.buffer), copied, buf);
+        ASSERT(converted == copied);
+        UNUSED_VARIABLE(converted);
+    } else {
+        memcpy(buf, data.buffer, copied * sizeof(char16_t));
     }
     buf[copied] = u'\0';
     if (result != nullptr) {
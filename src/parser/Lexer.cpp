@@ -745,6 +745,10 @@ void Scanner::skipSingleLine()
 
 void Scanner::skipSingleLineComment(void)
 {
+    if (this->sourceCodeAccessData.has8BitContent) {
+        this->index += StringSearch::findFirstOf(this->source8BitAt(this->index), this->length - this->index, '\n', '\r', '\n', '\r');
+    }
+
     while (!this->eof()) {
         char16_t ch = this->peekCharWithoutEOF();
         ++this->index;
@@ -763,7 +767,15 @@ void Scanner::skipSingleLineComment(void)
 
 void Scanner::skipMultiLineComment(void)
 {
+    const bool is8Bit = this->sourceCodeAccessData.has8BitContent;
     while (!this->eof()) {
+        if (is8Bit) {
+            this->index += StringSearch::findFirstOf(this->source8BitAt(this->index), this->length - this->index, '\n', '\r', '*', '*');
+            if (this->eof()) {
+                break;
+            }
+        }
+
         char16_t ch = this->peekCharWithoutEOF();
         ++this->index;
 
@@ -830,6 +842,10 @@ Scanner::ScanIDResult Scanner::getIdentifier()
 {
     const size_t start = this->index;
     ++this->index;
+    if (this->sourceCodeAccessData.has8BitContent) {
+        // the loop below takes over at a backslash or a non-ASCII character
+        this->index += StringSearch::findNonASCIIIdentifierPart(this->source8BitAt(this->index), this->length - this->index);
+    }
     while (UNLIKELY(!this->eof())) {
         const char16_t ch = this->peekCharWithoutEOF();
         if (UNLIKELY(ch == 0x5C)) {
@@ -1549,8 +1565,16 @@ void Scanner::scanStringLiteral(Scanner::ScannerResult* token)
     ++this->index;
     bool octal = false;
     bool isPlainCase = true;
+    const bool is8Bit = this->sourceCodeAccessData.has8BitContent;
 
     while (LIKELY(!this->eof())) {
+        if (is8Bit) {
+            this->index += StringSearch::findFirstOf(this->source8BitAt(this->index), this->length - this->index, quote, '\\', '\n', '\r');
+            if (UNLIKELY(this->eof())) {
+                break;
+            }
+        }
+
         char16_t ch = this->peekCharWithoutEOF();
         ++this->index;
         if (ch == quote) {
@@ -587,6 +587,14 @@ public:
         return sourceCodeAccessData.charAt(idx);
     }
 
+    // 8-bit sources are skipped over in blocks with StringSearch.
+    // they have no surrogates and no line terminators besides CR and LF
+    ALWAYS_INLINE const LChar* source8BitAt(const size_t idx) const
+    {
+        ASSERT(sourceCodeAccessData.has8BitContent && idx <= this->length);
+        return reinterpret_cast<const LChar*>(sourceCodeAccessData.bufferAs8Bit) + idx;
+    }
+
     void skipSingleLine();
 
     // ECMA-262 11.4 Comments
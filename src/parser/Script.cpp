@@ -35,6 +35,9 @@
 #include "runtime/ScriptAsyncFunctionObject.h"
 #include "runtime/ModuleNamespaceObject.h"
 #include "parser/ast/AST.h"
+#if defined(ENABLE_CODE_CACHE)
+#include "codecache/CodeCache.h"
+#endif
 
 namespace Escargot {
 
@@ -80,6 +83,30 @@ Context* Script::context()
     return m_topCodeBlock->context();
 }
 
+#if defined(ENABLE_CODE_CACHE)
+const CodeCacheHash& Script::sourceCodeHashValue()
+{
+    if (UNLIKELY(!m_sourceCodeHashValue.isValid())) {
+        m_sourceCodeHashValue = CodeCache::computeSourceHash(m_sourceCode);
+    }
+    return m_sourceCodeHashValue;
+}
+
+#if defined(ENABLE_THREADING)
+void Script::setParallelCompileTask(ParallelCompileTask* task)
+{
+    ASSERT(!m_parallelCompileTask);
+    m_parallelCompileTask = task;
+    GC_REGISTER_FINALIZER_NO_ORDER(this, [](void* obj, void*) {
+        Script* self = (Script*)obj;
+        delete self->m_parallelCompileTask;
+        self->m_parallelCompileTask = nullptr;
+    },
+                                   nullptr, nullptr, nullptr);
+}
+#endif
+#endif
+
 Script* Script::loadModuleFromScript(ExecutionState& state, ModuleRequest& request)
 {
     Platform::LoadModuleResult result = Global::platform()->onLoadModule(context(), this, request.m_specifier, request.m_type);
@@ -22,6 +22,9 @@
 
 #include "runtime/PromiseObject.h"
 #include "runtime/Platform.h"
+#if defined(ENABLE_CODE_CACHE)
+#include "codecache/CodeCacheHash.h"
+#endif
 
 namespace Escargot {
 
@@ -30,6 +33,17 @@ class Context;
 class ModuleEnvironmentRecord;
 class ModuleNamespaceObject;
 
+#if defined(ENABLE_CODE_CACHE) && defined(ENABLE_THREADING)
+// functions of a script compiled into bundles on other threads while the script runs
+class ParallelCompileTask {
+public:
+    virtual ~ParallelCompileTask() {}
+    // bundle holding the function starting at functionStart if it is compiled already
+    // never blocks, returns nullptr while the function is not compiled or not selected
+    virtual const std::vector<char>* readyBundle(size_t functionStart) = 0;
+};
+#endif
+
 class Script : public gc {
     friend class ScriptParser;
     friend class GlobalObject;
@@ -167,12 +181,17 @@ public:
     Script(String* srcName, String* sourceCode, ModuleData* moduleData, size_t originLineOffset, bool canExecuteAgain
 #if defined(ENABLE_CODE_CACHE)
            ,
-           size_t sourceCodeHashValue = 0
+           const CodeCacheHash& sourceCodeHashValue = CodeCacheHash()
 #endif
            )
         : m_canExecuteAgain(canExecuteAgain && !moduleData)
 #if defined(ENABLE_CODE_CACHE)
         , m_sourceCodeHashValue(sourceCodeHashValue)
+        , m_bundleData(nullptr)
+        , m_bundleSize(0)
+#if defined(ENABLE_THREADING)
+        , m_parallelCompileTask(nullptr)
+#endif
 #endif
         , m_srcName(srcName)
         , m_sourceCode(sourceCode)
@@ -216,13 +235,19 @@ public:
     }
 
 #if defined(ENABLE_CODE_CACHE)
-    size_t sourceCodeHashValue()
+    const CodeCacheHash& sourceCodeHashValue();
+    const char* bundleData()
     {
-        if (UNLIKELY(m_sourceCodeHashValue == 0)) {
-            m_sourceCodeHashValue = m_sourceCode->hashValue<0, false>();
-        }
-        return m_sourceCodeHashValue;
+        return m_bundleData;
+    }
+#if defined(ENABLE_THREADING)
+    ParallelCompileTask* parallelCompileTask()
+    {
+        return m_parallelCompileTask;
     }
+    // the task is deleted with this script
+    void setParallelCompileTask(ParallelCompileTask* task);
+#endif
 #endif
 
     size_t moduleRequestsLength();
@@ -319,7 +344,12 @@ private:
 
     bool m_canExecuteAgain;
 #if defined(ENABLE_CODE_CACHE)
-    size_t m_sourceCodeHashValue;
+    CodeCacheHash m_sourceCodeHashValue;
+    const char* m_bundleData; // precompiled bundle holding the functions of this script (owned by the embedder)
+    size_t m_bundleSize;
+#if defined(ENABLE_THREADING)
+    ParallelCompileTask* m_parallelCompileTask;
+#endif
 #endif
     String* m_srcName;
     String* m_sourceCode;
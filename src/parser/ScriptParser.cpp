@@ -24,6 +24,7 @@
 #include "runtime/VMInstance.h"
 #include "interpreter/ByteCode.h"
 #include "parser/esprima_cpp/esprima.h"
+#include "parser/Lexer.h"
 #include "parser/ast/AST.h"
 #include "parser/CodeBlock.h"
 #include "runtime/Environment.h"
@@ -397,14 +398,16 @@ ScriptParser::InitializeScriptResult ScriptParser::initializeScript(String* orig
     CodeCacheIndex cacheIndex;
     CodeBlockCacheInfoHolder cacheInfoHolder;
     CodeCache* codeCache = m_context->vmInstance()->codeCache();
-    bool cacheable = codeCache->enabled() && needByteCodeGeneration && !isModule && !isEvalMode && srcName->length() && source->length() > codeCache->minSourceLength();
+    bool writingBundle = codeCache->isWritingBundle();
+    bool cacheable = (codeCache->enabled() || writingBundle) && needByteCodeGeneration && !isModule && !isEvalMode && srcName->length() && (writingBundle || source->length() > codeCache->minSourceLength());
 
     // Load caching
     if (cacheable) {
         ASSERT(!parentCodeBlock);
         // set m_functionIndex as SIZE_MAX for global code
-        cacheIndex = CodeCacheIndex(source->hashValue<0, false>(), source->length(), SIZE_MAX);
-        auto result = codeCache->searchCache(cacheIndex);
+        cacheIndex = CodeCacheIndex(CodeCache::computeSourceHash(source), source->length(), SIZE_MAX);
+        // a bundle always stores a new image
+        auto result = writingBundle ? std::make_pair(false, CodeCacheEntry()) : codeCache->searchCache(cacheIndex);
         if (result.first) {
             GC_disable();
 
@@ -548,6 +551,36 @@ void ScriptParser::generateFunctionByteCode(ExecutionState& state, InterpretedCo
 
 #if defined(ENABLE_CODE_CACHE)
     CodeCache* codeCache = m_context->vmInstance()->codeCache();
+
+    // Load from bundle
+    Script* script = codeBlock->script();
+    if (script->bundleData()) {
+        GC_disable();
+        bool loadingDone = codeCache->loadBundleFunction(m_context, codeBlock, script->m_bundleData, script->m_bundleSize);
+        GC_enable();
+
+        if (LIKELY(loadingDone)) {
+            return;
+        }
+        // not in the bundle, compile it from source
+    }
+
+#if defined(ENABLE_THREADING)
+    // Load from a bundle compiled in parallel, without waiting for it
+    if (script->parallelCompileTask()) {
+        const std::vector<char>* bundle = script->parallelCompileTask()->readyBundle(codeBlock->functionStart().index);
+        if (bundle) {
+            GC_disable();
+            bool loadingDone = codeCache->loadBundleFunction(m_context, codeBlock, bundle->data(), bundle->size());
+            GC_enable();
+
+            if (LIKELY(loadingDone)) {
+                return;
+            }
+        }
+    }
+#endif
+
     CodeCacheIndex cacheIndex;
     bool cacheable = codeCache->enabled() && codeBlock->src().length() > codeCache->minSourceLength();
 
@@ -639,6 +672,215 @@ Script* ScriptParser::initializeJSONModule(String* source, String* srcName)
     return script;
 }
 
+#if defined(ENABLE_CODE_CACHE)
+ScriptParser::InitializeScriptResult ScriptParser::compileScriptBundle(String* source, String* srcName, std::vector<char>& bundle, bool storeFunctions, size_t partIndex, size_t partCount, const std::vector<size_t>* functionStarts)
+{
+    ASSERT(partIndex < partCount);
+    CodeCache* codeCache = m_context->vmInstance()->codeCache();
+
+    codeCache->beginBundleWriting();
+    ScriptParser::InitializeScriptResult result = initializeScript(source, srcName, false);
+    if (result.script && storeFunctions) {
+        // every part stores the global code, which is the same in all parts
+        size_t functionOrdinal = 0;
+        GC_disable();
+        recursivelyStoreChildrenByteCode(result.script->topCodeBlock(), functionOrdinal, partIndex, partCount, functionStarts);
+        GC_enable();
+    }
+
+    if (!codeCache->endBundleWriting(bundle) && result.script) {
+        // the script itself is fine, it just could not be stored
+        ESCARGOT_LOG_ERROR("[CodeCache] can't make a bundle of %s\n", srcName->toNonGCUTF8StringData().data());
+    }
+    return result;
+}
+
+ScriptParser::InitializeScriptResult ScriptParser::initializeScriptFromBundle(const char* bundleData, size_t bundleSize, String* source, String* srcName, bool verifySourceHash)
+{
+    CodeCache* codeCache = m_context->vmInstance()->codeCache();
+
+    GC_disable();
+
+    Script* script = new Script(srcName, source, nullptr, 0, false);
+    bool loadingDone = codeCache->loadBundle(m_context, bundleData, bundleSize, script, verifySourceHash);
+
+    GC_enable();
+
+    ScriptParser::InitializeScriptResult result;
+    if (LIKELY(loadingDone)) {
+        result.script = script;
+    } else {
+        result.parseErrorCode = ErrorCode::None;
+        result.parseErrorMessage = new ASCIIStringFromExternalMemory("invalid bytecode bundle");
+    }
+    return result;
+}
+
+void ScriptParser::recursivelyStoreChildrenByteCode(InterpretedCodeBlock* parent, size_t& functionOrdinal, size_t partIndex, size_t partCount, const std::vector<size_t>* functionStarts)
+{
+    ASSERT(GC_is_disabled());
+
+    if (!parent->hasChildren()) {
+        return;
+    }
+
+    CodeCache* codeCache = m_context->vmInstance()->codeCache();
+    InterpretedCodeBlockVector& childrenVector = parent->children();
+    for (size_t i = 0; i < childrenVector.size(); i++) {
+        // the codeblock tree is the same in every VMInstance, so is the ordinal of each function
+        if (functionOrdinal++ % partCount != partIndex) {
+            continue;
+        }
+
+        InterpretedCodeBlock* codeBlock = childrenVector[i];
+        if (functionStarts && !std::binary_search(functionStarts->begin(), functionStarts->end(), codeBlock->functionStart().index)) {
+            continue;
+        }
+        CodeCacheIndex cacheIndex(codeBlock->script()->sourceCodeHashValue(), codeBlock->script()->sourceCode()->length(), codeBlock->functionStart().index);
+
+        // a function which fails here is left out of the bundle and reports its error when it is called
+        try {
+            FunctionNode* functionNode = esprima::parseSingleFunction(m_context, codeBlock);
+            codeCache->storeFunctionCache(m_context, cacheIndex, codeBlock, functionNode);
+        } catch (esprima::Error* orgError) {
+            delete orgError;
+        } catch (const char*) {
+        }
+
+        m_context->astAllocator().reset();
+    }
+
+    for (size_t i = 0; i < childrenVector.size(); i++) {
+        recursivelyStoreChildrenByteCode(childrenVector[i], functionOrdinal, partIndex, partCount, functionStarts);
+    }
+}
+
+static bool isASCIIIdentifierPart(char16_t c)
+{
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_' || c == '$';
+}
+
+static size_t skipWhiteSpace(String* source, size_t index)
+{
+    size_t length = source->length();
+    while (index < length && EscargotLexer::isWhiteSpaceOrLineTerminator(source->charAt(index))) {
+        index++;
+    }
+    return index;
+}
+
+// function expression called where it is defined, e.g. (function () {})(), (function () {}()) or !function () {}()
+static bool isImmediatelyInvoked(InterpretedCodeBlock* codeBlock)
+{
+    if (!codeBlock->isFunctionExpression() && !codeBlock->isArrowFunctionExpression()) {
+        return false;
+    }
+
+    String* source = codeBlock->script()->sourceCode();
+    size_t index = skipWhiteSpace(source, codeBlock->src().end());
+    if (index < source->length() && source->charAt(index) == ')') {
+        index = skipWhiteSpace(source, index + 1);
+    }
+    return index < source->length() && source->charAt(index) == '(';
+}
+
+// top-level function declarations whose name is called in the top-level code
+// the source is scanned without tokenizing, so a call in a string or comment selects the function too
+static void collectTopLevelCallees(InterpretedCodeBlock* topCodeBlock, std::vector<size_t>& functionStarts)
+{
+    if (!topCodeBlock->hasChildren()) {
+        return;
+    }
+
+    std::unordered_map<std::string, size_t> declarations;
+    InterpretedCodeBlockVector& children = topCodeBlock->children();
+    for (size_t i = 0; i < children.size(); i++) {
+        if (children[i]->isFunctionDeclaration()) {
+            declarations[children[i]->functionName().string()->toNonGCUTF8StringData()] = children[i]->functionStart().index;
+        }
+    }
+    if (declarations.empty()) {
+        return;
+    }
+
+    // children are in source order, their bodies are skipped
+    String* source = topCodeBlock->script()->sourceCode();
+    size_t length = source->length();
+    size_t childIndex = 0;
+    size_t index = 0;
+    while (index < length) {
+        if (childIndex < children.size() && index >= children[childIndex]->src().start()) {
+            index = std::max(index, children[childIndex]->src().end());
+            childIndex++;
+            continue;
+        }
+
+        char16_t c = source->charAt(index);
+        if (!isASCIIIdentifierPart(c) && c < 128) {
+            index++;
+            continue;
+        }
+
+        size_t start = index;
+        bool isASCII = true;
+        while (index < length && (isASCIIIdentifierPart(source->charAt(index)) || source->charAt(index) >= 128)) {
+            isASCII = isASCII && source->charAt(index) < 128;
+            index++;
+        }
+        // property accesses such as obj.name() are not calls of the declaration
+        if (!isASCII || (start > 0 && source->charAt(start - 1) == '.')) {
+            continue;
+        }
+
+        size_t next = skipWhiteSpace(source, index);
+        if (next < length && source->charAt(next) == '(') {
+            std::string name;
+            for (size_t i = start; i < index; i++) {
+                name.push_back((char)source->charAt(i));
+            }
+            auto iter = declarations.find(name);
+            if (iter != declarations.end()) {
+                functionStarts.push_back(iter->second);
+            }
+        }
+    }
+}
+
+static void recursivelyCollectHotFunctionStarts(InterpretedCodeBlock* parent, bool parentIsHot, const std::vector<size_t>& selected, std::vector<size_t>& functionStarts)
+{
+    if (!parent->hasChildren()) {
+        return;
+    }
+
+    InterpretedCodeBlockVector& children = parent->children();
+    for (size_t i = 0; i < children.size(); i++) {
+        InterpretedCodeBlock* codeBlock = children[i];
+        size_t start = codeBlock->functionStart().index;
+        // an IIFE runs early only when the code around it does
+        bool isHot = std::binary_search(selected.begin(), selected.end(), start) || (parentIsHot && isImmediatelyInvoked(codeBlock));
+        if (isHot) {
+            functionStarts.push_back(start);
+        }
+        recursivelyCollectHotFunctionStarts(codeBlock, isHot, selected, functionStarts);
+    }
+}
+
+void ScriptParser::collectHotFunctionStarts(Script* script, const std::vector<size_t>& profiledFunctionStarts, std::vector<size_t>& functionStarts)
+{
+    InterpretedCodeBlock* topCodeBlock = script->topCodeBlock();
+    ASSERT(!!topCodeBlock);
+
+    std::vector<size_t> selected(profiledFunctionStarts);
+    collectTopLevelCallees(topCodeBlock, selected);
+    std::sort(selected.begin(), selected.end());
+
+    functionStarts.clear();
+    recursivelyCollectHotFunctionStarts(topCodeBlock, true, selected, functionStarts);
+    std::sort(functionStarts.begin(), functionStarts.end());
+    functionStarts.erase(std::unique(functionStarts.begin(), functionStarts.end()), functionStarts.end());
+}
+#endif
+
 #ifdef ESCARGOT_DEBUGGER
 
 void ScriptParser::recursivelyGenerateChildrenByteCode(InterpretedCodeBlock* parent)
@@ -66,6 +66,20 @@ public:
 #if defined(ENABLE_CODE_CACHE)
     void setCodeBlockCacheInfo(CodeBlockCacheInfo* info);
     void deleteCodeBlockCacheInfo();
+
+    // compile the script into a bundle of code cache entries, with every function in it if storeFunctions is set
+    // with partCount > 1, only every partCount-th function starting from partIndex is stored,
+    // so that the parts can be compiled in parallel and joined by CodeCache::mergeBundles
+    // with functionStarts (sorted), only the functions starting at these source offsets are stored
+    InitializeScriptResult compileScriptBundle(String* source, String* srcName, std::vector<char>& bundle, bool storeFunctions, size_t partIndex = 0, size_t partCount = 1, const std::vector<size_t>* functionStarts = nullptr);
+    // bundleData should be kept alive while the loaded Script lives unless it only holds the global code.
+    // it is trusted input
+    // only the source length is checked unless verifySourceHash is set
+    InitializeScriptResult initializeScriptFromBundle(const char* bundleData, size_t bundleSize, String* source, String* srcName, bool verifySourceHash);
+
+    // start offsets (sorted) of the functions of a parsed script which are likely to run early:
+    // IIFEs, top-level function declarations called from the top-level code, and the profiled ones
+    static void collectHotFunctionStarts(Script* script, const std::vector<size_t>& profiledFunctionStarts, std::vector<size_t>& functionStarts);
 #endif
 
 private:
@@ -76,6 +90,10 @@ private:
     void dumpCodeBlockTree(InterpretedCodeBlock* topCodeBlock);
 #endif
 
+#if defined(ENABLE_CODE_CACHE)
+    void recursivelyStoreChildrenByteCode(InterpretedCodeBlock* parent, size_t& functionOrdinal, size_t partIndex, size_t partCount, const std::vector<size_t>* functionStarts);
+#endif
+
 #ifdef ESCARGOT_DEBUGGER
     void recursivelyGenerateChildrenByteCode(InterpretedCodeBlock* topCodeBlock);
     InitializeScriptResult initializeScriptWithDebugger(String* originSource, size_t originLineOffset, String* source, String* srcName, InterpretedCodeBlock* parentCodeBlock, bool isModule, bool isEvalMode, bool isEvalCodeInFunction, bool inWithOperation, bool strictFromOutside, bool allowSuperCall, bool allowSuperProperty, bool allowNewTarget);
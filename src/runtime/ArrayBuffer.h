@@ -113,10 +113,17 @@ public:
         }
     }
 
+    // resize of a resizable or growable buffer. stores backed by reserved address space
+    // allocate on growth, so the growth is treated like a new allocation of that size
+    void resizeBackingStore(size_t newByteLength);
+
     void* operator new(size_t size) = delete;
     void* operator new[](size_t size) = delete;
 
 protected:
+    // ArrayBuffer memory is invisible to GC, so collect first when the allocation is large compared to the GC heap
+    static void collectGarbageBeforeAllocation(size_t allocationSize);
+
     static void backingStoreObserver(Object* from, void* newAddress, size_t newByteLength)
     {
         reinterpret_cast<ArrayBuffer*>(from)->bufferUpdated(newAddress, newByteLength);
@@ -106,22 +106,38 @@ ArrayBufferObject::ArrayBufferObject(ExecutionState& state, BackingStore* backin
     updateBackingStore(backingStore);
 }
 
-void ArrayBufferObject::allocateBuffer(ExecutionState& state, size_t byteLength)
+void ArrayBuffer::collectGarbageBeforeAllocation(size_t allocationSize)
 {
-    detachArrayBuffer();
-
-    ASSERT(byteLength < ArrayBuffer::maxArrayBufferSize);
-
     const size_t ratio = std::max((size_t)GC_get_free_space_divisor() / 6, (size_t)1);
-    if (byteLength > (GC_get_heap_size() / ratio)) {
+    if (allocationSize > (GC_get_heap_size() / ratio)) {
         size_t n = 0;
-        size_t times = byteLength / (GC_get_heap_size() / ratio) / 3;
+        size_t times = allocationSize / (GC_get_heap_size() / ratio) / 3;
         do {
             GC_gcollect_and_unmap();
             n += 1;
         } while (n < times);
         GC_invoke_finalizers();
     }
+}
+
+void ArrayBuffer::resizeBackingStore(size_t newByteLength)
+{
+    ASSERT(isResizableArrayBuffer() && !isDetachedBuffer());
+    size_t oldAllocationSize = BackingStore::resizableAllocationSize(byteLength(), maxByteLength());
+    size_t newAllocationSize = BackingStore::resizableAllocationSize(newByteLength, maxByteLength());
+    if (oldAllocationSize < newAllocationSize) {
+        collectGarbageBeforeAllocation(newAllocationSize - oldAllocationSize);
+    }
+    m_backingStore->resize(newByteLength);
+}
+
+void ArrayBufferObject::allocateBuffer(ExecutionState& state, size_t byteLength)
+{
+    detachArrayBuffer();
+
+    ASSERT(byteLength < ArrayBuffer::maxArrayBufferSize);
+
+    collectGarbageBeforeAllocation(byteLength);
 
     updateBackingStore(BackingStore::createDefaultNonSharedBackingStore(byteLength));
 }
@@ -133,16 +149,7 @@ void ArrayBufferObject::allocateResizableBuffer(ExecutionState& state, size_t by
     ASSERT(byteLength <= maxByteLength);
     ASSERT(maxByteLength < ArrayBuffer::maxArrayBufferSize);
 
-    const size_t ratio = std::max((size_t)GC_get_free_space_divisor() / 6, (size_t)1);
-    if (maxByteLength > (GC_get_heap_size() / ratio)) {
-        size_t n = 0;
-        size_t times = maxByteLength / (GC_get_heap_size() / ratio) / 3;
-        do {
-            GC_gcollect_and_unmap();
-            n += 1;
-        } while (n < times);
-        GC_invoke_finalizers();
-    }
+    collectGarbageBeforeAllocation(BackingStore::resizableAllocationSize(byteLength, maxByteLength));
 
     updateBackingStore(BackingStore::createDefaultResizableNonSharedBackingStore(byteLength, maxByteLength));
 }
@@ -377,6 +377,112 @@ void ArrayObject::sort(ExecutionState& state, uint64_t length, const std::functi
     }
 }
 
+struct NativeSortEntry {
+    double m_number;
+    String* m_string;
+    Value m_value;
+};
+
+bool ArrayObject::sortFastModeElementsByNativeOrder(ExecutionState& state, const NativeSortOrder& order)
+{
+    ASSERT(isFastModeArray());
+    size_t length = arrayLength(state);
+    if (length < 2) {
+        return true;
+    }
+
+    // the second half is the merge sort scratch
+    NativeSortEntry* entries = (NativeSortEntry*)GC_MALLOC(sizeof(NativeSortEntry) * length * 2);
+    size_t keyCount = 0;
+    size_t undefinedCount = 0;
+    bool canSort = true;
+
+    for (size_t i = 0; i < length && canSort; i++) {
+        Value v = m_fastModeData[i];
+        if (v.isEmpty()) {
+            continue;
+        }
+        if (v.isUndefined()) {
+            undefinedCount++;
+            continue;
+        }
+
+        NativeSortEntry& entry = entries[keyCount++];
+        entry.m_value = v;
+        entry.m_string = nullptr;
+        entry.m_number = 0;
+        switch (order.m_kind) {
+        case NativeSortOrder::ByString:
+            // ToString of a primitive other than Symbol never reaches script
+            if (v.isObject() || v.isSymbol()) {
+                canSort = false;
+            } else {
+                entry.m_string = v.toString(state);
+            }
+            break;
+        case NativeSortOrder::ByNumber:
+            if (!v.isNumber() || std::isnan(v.asNumber())) {
+                canSort = false;
+            } else {
+                entry.m_number = v.asNumber();
+            }
+            break;
+        case NativeSortOrder::ByNumberProperty: {
+            canSort = false;
+            if (v.isObject() && v.asObject()->isInlineCacheable()) {
+                auto result = v.asObject()->getOwnProperty(state, ObjectPropertyName(order.m_propertyName));
+                if (result.hasValue() && result.isDataProperty() && !result.isDataAccessorProperty()) {
+                    Value key = result.value(state, v);
+                    if (key.isNumber() && !std::isnan(key.asNumber())) {
+                        entry.m_number = key.asNumber();
+                        canSort = true;
+                    }
+                }
+            }
+            break;
+        }
+        default:
+            RELEASE_ASSERT_NOT_REACHED();
+        }
+    }
+
+    if (!canSort) {
+        GC_FREE(entries);
+        return false;
+    }
+
+    if (order.m_kind == NativeSortOrder::ByString) {
+        mergeSort(entries, keyCount, entries + length, [](const NativeSortEntry& a, const NativeSortEntry& b, bool* lessOrEqualp) -> bool {
+            *lessOrEqualp = *a.m_string < *b.m_string;
+            return true;
+        });
+    } else if (order.m_isDescending) {
+        mergeSort(entries, keyCount, entries + length, [](const NativeSortEntry& a, const NativeSortEntry& b, bool* lessOrEqualp) -> bool {
+            *lessOrEqualp = b.m_number < a.m_number;
+            return true;
+        });
+    } else {
+        mergeSort(entries, keyCount, entries + length, [](const NativeSortEntry& a, const NativeSortEntry& b, bool* lessOrEqualp) -> bool {
+            *lessOrEqualp = a.m_number < b.m_number;
+            return true;
+        });
+    }
+
+    size_t i = 0;
+    for (; i < keyCount; i++) {
+        m_fastModeData[i] = entries[i].m_value;
+    }
+    for (size_t j = 0; j < undefinedCount; j++, i++) {
+        m_fastModeData[i] = Value();
+    }
+    for (; i < length; i++) {
+        m_fastModeData[i] = Value(Value::EmptyValue);
+    }
+
+    GC_FREE(entries);
+    return true;
+}
+
 void ArrayObject::toSorted(ExecutionState& state, Object* target, uint64_t length, const std::function<bool(const Value& a, const Value& b)>& comp)
 {
     ASSERT(target && target->isArrayObject() && target->length(state) == length);
@@ -90,6 +90,36 @@ public:
 
     static void iterateArrays(ExecutionState& state, HeapObjectIteratorCallback callback);
 
+    // orderings that Array.prototype.sort can run on precomputed keys: the
+    // default comparator (ToString of each element) and the recognized
+    // comparator shapes (a, b) => a - b, b - a, a.x - b.x and b.x - a.x
+    struct NativeSortOrder {
+        enum Kind : uint8_t {
+            ByString,
+            ByNumber,
+            ByNumberProperty,
+        };
+
+        NativeSortOrder(Kind kind = ByString, bool isDescending = false, AtomicString propertyName = AtomicString())
+            : m_kind(kind)
+            , m_isDescending(isDescending)
+            , m_propertyName(propertyName)
+        {
+        }
+
+        Kind m_kind;
+        bool m_isDescending;
+        AtomicString m_propertyName;
+    };
+
+    // sorts a fast-mode array by reading each element's key once, then
+    // merge sorting the keys natively. Undefined values and holes go to the
+    // end like SortCompare does. Returns false and leaves the array untouched
+    // when some element cannot produce its key without observable side
+    // effects (objects under ByString, non-numbers or NaN under ByNumber,
+    // accessors or exotic objects under ByNumberProperty).
+    bool sortFastModeElementsByNativeOrder(ExecutionState& state, const NativeSortOrder& order);
+
     // bulk-copies count elements from src[srcStart..] into this[dstStart..],
     // growing this array when needed; both arrays must be fast-mode. Source
     // holes are skipped (destination slots stay as they are), matching the
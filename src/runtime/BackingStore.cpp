@@ -23,6 +23,12 @@
 #include "runtime/Global.h"
 #include "runtime/Platform.h"
 
+#if defined(OS_POSIX)
+#include <sys/mman.h>
+#include <unistd.h>
+#define ENABLE_RESERVED_BACKING_STORE
+#endif
+
 namespace Escargot {
 
 static void backingStorePlatformDeleter(void* data, size_t length, void* deleterData)
@@ -32,6 +38,90 @@ static void backingStorePlatformDeleter(void* data, size_t length, void* deleter
     }
 }
 
+#if defined(ENABLE_RESERVED_BACKING_STORE)
+// resizable buffers at least this large reserve address space up to maxByteLength and
+// commit pages as they grow, so growth never moves data and costs only the added pages.
+// smaller ones keep using the Platform allocator
+static const size_t reservedBackingStoreMinimumSize = 1024 * 1024;
+
+static size_t roundUpToPageSize(size_t size)
+{
+    static size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    return (size + pageSize - 1) & ~(pageSize - 1);
+}
+
+// committed pages bypass the Platform allocator, so every change is reported to the Platform instead
+static void reportCommittedMemory(void* data, size_t oldByteLength, size_t newByteLength)
+{
+    size_t from = roundUpToPageSize(oldByteLength);
+    size_t to = roundUpToPageSize(newByteLength);
+    if (from != to) {
+        Global::platform()->onCommitArrayBufferObjectDataBuffer(data, from, to);
+    }
+}
+
+static void* reserveMemory(size_t byteLength, size_t maxByteLength)
+{
+    size_t reservedSize = roundUpToPageSize(maxByteLength);
+    void* data = mmap(nullptr, reservedSize, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (data == MAP_FAILED) {
+        return nullptr;
+    }
+    size_t committedSize = roundUpToPageSize(byteLength);
+    if (committedSize && mprotect(data, committedSize, PROT_READ | PROT_WRITE) != 0) {
+        munmap(data, reservedSize);
+        return nullptr;
+    }
+    reportCommittedMemory(data, 0, byteLength);
+    return data;
+}
+
+// bytes between the length and the end of the committed pages are always zero,
+// so growing only needs to open the pages past the old end
+static void commitReservedMemory(void* data, size_t oldByteLength, size_t newByteLength)
+{
+    ASSERT(oldByteLength <= newByteLength);
+    size_t from = roundUpToPageSize(oldByteLength);
+    size_t to = roundUpToPageSize(newByteLength);
+    if (from < to) {
+        int result = mprotect(static_cast<uint8_t*>(data) + from, to - from, PROT_READ | PROT_WRITE);
+        RELEASE_ASSERT(result == 0);
+    }
+}
+
+static void decommitReservedMemory(void* data, size_t oldByteLength, size_t newByteLength)
+{
+    ASSERT(newByteLength <= oldByteLength);
+    uint8_t* base = static_cast<uint8_t*>(data);
+    size_t from = roundUpToPageSize(newByteLength);
+    memset(base + newByteLength, 0, std::min(from, oldByteLength) - newByteLength);
+    size_t to = roundUpToPageSize(oldByteLength);
+    if (from < to) {
+        // mapping fresh pages over the range returns the old ones to the system
+        void* result = mmap(base + from, to - from, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE | MAP_FIXED, -1, 0);
+        RELEASE_ASSERT(result != MAP_FAILED);
+    }
+}
+
+// owners report their committed pages as released before calling this
+static void reservedMemoryDeleter(void* data, size_t length, void* deleterData)
+{
+    if (!!data) {
+        munmap(data, roundUpToPageSize(length));
+    }
+}
+#endif
+
+size_t BackingStore::resizableAllocationSize(size_t byteLength, size_t maxByteLength)
+{
+#if defined(ENABLE_RESERVED_BACKING_STORE)
+    if (maxByteLength >= reservedBackingStoreMinimumSize) {
+        return byteLength;
+    }
+#endif
+    return maxByteLength;
+}
+
 BackingStore* BackingStore::createDefaultNonSharedBackingStore(size_t byteLength)
 {
     return new NonSharedBackingStore(
@@ -41,10 +131,18 @@ BackingStore* BackingStore::createDefaultNonSharedBackingStore(size_t byteLength
 
 BackingStore* BackingStore::createDefaultResizableNonSharedBackingStore(size_t byteLength, size_t maxByteLength)
 {
-    // Resizable BackingStore is allocated by Platform only
+#if defined(ENABLE_RESERVED_BACKING_STORE)
+    if (maxByteLength >= reservedBackingStoreMinimumSize) {
+        void* data = reserveMemory(byteLength, maxByteLength);
+        if (LIKELY(!!data)) {
+            return new NonSharedBackingStore(data, byteLength, reservedMemoryDeleter, maxByteLength, true);
+        }
+    }
+#endif
+    // otherwise Resizable BackingStore is allocated by Platform only
     return new NonSharedBackingStore(
         Global::platform()->onMallocArrayBufferObjectDataBuffer(maxByteLength),
-        byteLength, backingStorePlatformDeleter, maxByteLength, true);
+        byteLength, backingStorePlatformDeleter, maxByteLength, false);
 }
 
 BackingStore* BackingStore::createNonSharedBackingStore(void* data, size_t byteLength, BackingStoreDeleterCallback deleter, void* callbackData)
@@ -57,20 +155,23 @@ NonSharedBackingStore::NonSharedBackingStore(void* data, size_t byteLength, Back
     , m_byteLength(byteLength)
     , m_deleter(deleter)
     , m_deleterData(callbackData)
+    , m_allocatedByteLength(byteLength)
     , m_isAllocatedByPlatform(isAllocatedByPlatform)
     , m_isResizable(false)
+    , m_isReserved(false)
 {
 }
 
-NonSharedBackingStore::NonSharedBackingStore(void* data, size_t byteLength, BackingStoreDeleterCallback deleter, size_t maxByteLength, bool isAllocatedByPlatform)
+NonSharedBackingStore::NonSharedBackingStore(void* data, size_t byteLength, BackingStoreDeleterCallback deleter, size_t maxByteLength, bool isReserved)
     : m_data(data)
     , m_byteLength(byteLength)
     , m_deleter(deleter)
     , m_maxByteLength(maxByteLength)
-    , m_isAllocatedByPlatform(isAllocatedByPlatform)
+    , m_allocatedByteLength(maxByteLength)
+    , m_isAllocatedByPlatform(!isReserved)
     , m_isResizable(true)
+    , m_isReserved(isReserved)
 {
-    ASSERT(isAllocatedByPlatform);
 }
 
 int NonSharedBackingStore::clearNonSharedBackingStore(void* obj)
@@ -87,7 +188,12 @@ int NonSharedBackingStore::clearNonSharedBackingStore(void* obj)
     if (!self->m_isResizable) {
         self->m_deleter(self->m_data, self->m_byteLength, self->m_deleterData);
     } else {
-        self->m_deleter(self->m_data, self->m_maxByteLength, nullptr);
+#if defined(ENABLE_RESERVED_BACKING_STORE)
+        if (self->m_isReserved) {
+            reportCommittedMemory(self->m_data, self->m_byteLength, 0);
+        }
+#endif
+        self->m_deleter(self->m_data, self->m_allocatedByteLength, nullptr);
     }
     // zero the vptr to mark as cleaned
     *(void**)self = nullptr;
@@ -103,6 +209,20 @@ void NonSharedBackingStore::resize(size_t newByteLength)
 {
     ASSERT(m_isResizable && newByteLength <= m_maxByteLength);
 
+#if defined(ENABLE_RESERVED_BACKING_STORE)
+    if (m_isReserved) {
+        if (m_byteLength < newByteLength) {
+            commitReservedMemory(m_data, m_byteLength, newByteLength);
+        } else {
+            decommitReservedMemory(m_data, m_byteLength, newByteLength);
+        }
+        reportCommittedMemory(m_data, m_byteLength, newByteLength);
+        m_byteLength = newByteLength;
+        bufferUpdated(m_data, m_byteLength);
+        return;
+    }
+#endif
+
     if (m_byteLength < newByteLength) {
         memset(static_cast<uint8_t*>(m_data) + m_byteLength, 0, newByteLength - m_byteLength);
     }
@@ -117,7 +237,43 @@ void NonSharedBackingStore::reallocate(size_t newByteLength)
         return;
     }
 
-    if (m_isAllocatedByPlatform) {
+#if defined(ENABLE_RESERVED_BACKING_STORE)
+    if (m_isReserved) {
+        if (newByteLength <= m_maxByteLength) {
+            // the reservation cannot move; stay within it
+            resize(newByteLength);
+            return;
+        }
+
+        // outgrown the reservation. move the contents into a platform allocation of newByteLength
+        void* newData = Global::platform()->onMallocArrayBufferObjectDataBuffer(newByteLength);
+        memcpy(newData, m_data, m_byteLength);
+        reportCommittedMemory(m_data, m_byteLength, 0);
+        m_deleter(m_data, m_allocatedByteLength, nullptr);
+        m_data = newData;
+        m_deleter = backingStorePlatformDeleter;
+        m_byteLength = newByteLength;
+        m_allocatedByteLength = newByteLength;
+        m_isAllocatedByPlatform = true;
+        m_isReserved = false;
+        bufferUpdated(m_data, newByteLength);
+        return;
+    }
+#endif
+
+    if (m_isResizable) {
+        // resize() may grow up to maxByteLength in place, so never allocate less than that
+        ASSERT(m_isAllocatedByPlatform);
+        size_t newAllocatedByteLength = std::max(newByteLength, m_maxByteLength);
+        if (newAllocatedByteLength != m_allocatedByteLength) {
+            m_data = Global::platform()->onReallocArrayBufferObjectDataBuffer(m_data, m_allocatedByteLength, newAllocatedByteLength);
+            m_allocatedByteLength = newAllocatedByteLength;
+        }
+        if (m_byteLength < newByteLength) {
+            memset(static_cast<uint8_t*>(m_data) + m_byteLength, 0, newByteLength - m_byteLength);
+        }
+        m_byteLength = newByteLength;
+    } else if (m_isAllocatedByPlatform) {
         m_data = Global::platform()->onReallocArrayBufferObjectDataBuffer(m_data, m_byteLength, newByteLength);
         m_byteLength = newByteLength;
     } else {
@@ -145,10 +301,18 @@ BackingStore* BackingStore::createDefaultSharedBackingStore(size_t byteLength)
 
 BackingStore* BackingStore::createDefaultGrowableSharedBackingStore(size_t byteLength, size_t maxByteLength)
 {
+#if defined(ENABLE_RESERVED_BACKING_STORE)
+    if (maxByteLength >= reservedBackingStoreMinimumSize) {
+        void* data = reserveMemory(byteLength, maxByteLength);
+        if (LIKELY(!!data)) {
+            return new SharedBackingStore(new GrowableSharedDataBlockInfo(data, byteLength, maxByteLength, reservedMemoryDeleter, true));
+        }
+    }
+#endif
     SharedDataBlockInfo* sharedInfo = new GrowableSharedDataBlockInfo(
         Global::platform()->onMallocArrayBufferObjectDataBuffer(maxByteLength),
         byteLength, maxByteLength,
-        backingStorePlatformDeleter);
+        backingStorePlatformDeleter, false);
     return new SharedBackingStore(sharedInfo);
 }
 
@@ -163,11 +327,7 @@ void SharedDataBlockInfo::deref()
 
     auto oldValue = m_refCount.fetch_sub(1);
     if (oldValue == 1) {
-        if (isGrowable()) {
-            m_deleter(m_data, maxByteLength(), nullptr);
-        } else {
-            m_deleter(m_data, m_byteLength, nullptr);
-        }
+        releaseData();
 
         m_data = nullptr;
         m_byteLength = 0;
@@ -201,6 +361,35 @@ int SharedBackingStore::clearSharedBackingStore(void* obj)
     return 0;
 }
 
+void GrowableSharedDataBlockInfo::grow(size_t newByteLength)
+{
+    ASSERT(newByteLength <= m_maxByteLength);
+#if defined(ENABLE_RESERVED_BACKING_STORE)
+    if (m_isReserved) {
+        // pages are opened before the new length is published to other threads.
+        // concurrent growers may open overlapping ranges, which is harmless. the committed size is
+        // reported against the length each grower replaced, so the reports add up to the final length
+        size_t oldByteLength = m_byteLength.load();
+        if (oldByteLength < newByteLength) {
+            commitReservedMemory(m_data, oldByteLength, newByteLength);
+        }
+        reportCommittedMemory(m_data, m_byteLength.exchange(newByteLength), newByteLength);
+        return;
+    }
+#endif
+    m_byteLength.store(newByteLength);
+}
+
+void GrowableSharedDataBlockInfo::releaseData()
+{
+#if defined(ENABLE_RESERVED_BACKING_STORE)
+    if (m_isReserved) {
+        reportCommittedMemory(m_data, m_byteLength, 0);
+    }
+#endif
+    m_deleter(m_data, m_maxByteLength, nullptr);
+}
+
 void SharedBackingStore::resize(size_t newByteLength)
 {
     ASSERT(m_sharedDataBlockInfo->hasValidReference());
@@ -113,6 +113,9 @@ public:
     static BackingStore* createDefaultNonSharedBackingStore(size_t byteLength);
     static BackingStore* createDefaultResizableNonSharedBackingStore(size_t byteLength, size_t maxByteLength);
     static BackingStore* createNonSharedBackingStore(void* data, size_t byteLength, BackingStoreDeleterCallback deleter, void* callbackData);
+    // memory taken up front by a default resizable/growable BackingStore;
+    // stores backed by reserved address space commit only byteLength
+    static size_t resizableAllocationSize(size_t byteLength, size_t maxByteLength);
 
 #if defined(ENABLE_THREADING)
     static BackingStore* createDefaultSharedBackingStore(size_t byteLength);
@@ -207,7 +210,7 @@ public:
 
 private:
     NonSharedBackingStore(void* data, size_t byteLength, BackingStoreDeleterCallback deleter, void* callbackData, bool isAllocatedByPlatform);
-    NonSharedBackingStore(void* data, size_t byteLength, BackingStoreDeleterCallback deleter, size_t maxByteLength, bool isAllocatedByPlatform);
+    NonSharedBackingStore(void* data, size_t byteLength, BackingStoreDeleterCallback deleter, size_t maxByteLength, bool isReserved);
 
     void* m_data;
     size_t m_byteLength;
@@ -216,8 +219,13 @@ private:
         void* m_deleterData;
         size_t m_maxByteLength;
     };
+    // size of the allocation (or reservation) behind m_data of a resizable store.
+    // it exceeds maxByteLength only after reallocate() has grown the store past it
+    size_t m_allocatedByteLength;
     bool m_isAllocatedByPlatform;
     bool m_isResizable;
+    // data is a PROT_NONE reservation of maxByteLength whose pages are committed on growth
+    bool m_isReserved;
 };
 
 #if defined(ENABLE_THREADING)
@@ -251,6 +259,12 @@ public:
         ASSERT_NOT_REACHED();
     }
 
+    // called by the last deref
+    virtual void releaseData()
+    {
+        m_deleter(m_data, m_byteLength, nullptr);
+    }
+
     void* data() const
     {
         ASSERT(hasValidReference());
@@ -291,9 +305,10 @@ protected:
 
 class GrowableSharedDataBlockInfo : public SharedDataBlockInfo {
 public:
-    GrowableSharedDataBlockInfo(void* data, size_t byteLength, size_t maxByteLength, BackingStoreDeleterCallback deleter)
+    GrowableSharedDataBlockInfo(void* data, size_t byteLength, size_t maxByteLength, BackingStoreDeleterCallback deleter, bool isReserved)
         : SharedDataBlockInfo(data, byteLength, deleter)
         , m_maxByteLength(maxByteLength)
+        , m_isReserved(isReserved)
     {
     }
 
@@ -307,15 +322,13 @@ public:
         return m_maxByteLength;
     }
 
-    virtual void grow(size_t newByteLength) override
-    {
-        ASSERT(newByteLength <= m_maxByteLength);
-        m_byteLength.store(newByteLength);
-    }
+    virtual void grow(size_t newByteLength) override;
+    virtual void releaseData() override;
 
 private:
     // defined once and never change
     const size_t m_maxByteLength;
+    const bool m_isReserved;
 };
 
 class SharedBackingStore : public BackingStore {
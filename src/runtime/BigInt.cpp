@@ -444,6 +444,18 @@ uint64_t BigInt::toUint64() const
     return d;
 }
 
+bool BigInt::fitsInt64() const
+{
+    int64_t d;
+    return bf_get_int64(&d, &m_bf, 0) == 0;
+}
+
+bool BigInt::fitsUint64() const
+{
+    uint64_t d;
+    return (!m_bf.sign || bf_is_zero(&m_bf)) && bf_get_uint64(&d, &m_bf, 0) == 0;
+}
+
 
 bool BigInt::equals(const BigInt* b) const
 {
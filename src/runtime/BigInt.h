@@ -95,6 +95,9 @@ public:
     double toNumber() const;
     int64_t toInt64() const;
     uint64_t toUint64() const;
+    // whether toInt64/toUint64 return the value without wrapping
+    bool fitsInt64() const;
+    bool fitsUint64() const;
 
     bool equals(const BigInt* b) const;
     bool equals(const BigIntData& b) const;
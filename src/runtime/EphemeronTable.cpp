@@ -0,0 +1,241 @@
+/*
+ * Copyright (c) 2026-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#include "Escargot.h"
+#include "EphemeronTable.h"
+#include "runtime/Object.h"
+#include "runtime/Symbol.h"
+#include "runtime/ThreadLocal.h"
+
+namespace Escargot {
+
+static MAY_THREAD_LOCAL size_t g_lastEphemeronTableId;
+
+static Optional<EphemeronValueList*> valueListOf(PointerValue* key)
+{
+    // must not allocate; this is also used while sweeping
+    if (key->isObject()) {
+        Object* obj = key->asObject();
+        if (obj->hasExtendedExtraData()) {
+            return obj->ensureExtendedExtraData()->m_ephemeronValues;
+        }
+        return nullptr;
+    }
+    return key->asSymbol()->ephemeronValues();
+}
+
+static EphemeronValueList* ensureValueList(PointerValue* key)
+{
+    if (key->isObject()) {
+        ObjectExtendedExtraData* e = key->asObject()->ensureExtendedExtraData();
+        if (!e->m_ephemeronValues) {
+            e->m_ephemeronValues = new EphemeronValueList();
+        }
+        return e->m_ephemeronValues.value();
+    }
+    Symbol* sym = key->asSymbol();
+    if (!sym->ephemeronValues()) {
+        sym->setEphemeronValues(new EphemeronValueList());
+    }
+    return sym->ephemeronValues().value();
+}
+
+EphemeronTable::EphemeronTable()
+    : m_id(++g_lastEphemeronTableId)
+    , m_deadKeyCount(0)
+{
+    if (UNLIKELY(!m_id)) {
+        // wrapped around; 0 marks a free entry
+        m_id = ++g_lastEphemeronTableId;
+    }
+    ThreadLocal::ephemeronTables().push_back(this);
+}
+
+void* EphemeronTable::operator new(size_t size)
+{
+    static MAY_THREAD_LOCAL bool typeInited = false;
+    static MAY_THREAD_LOCAL GC_descr descr;
+    if (!typeInited) {
+        GC_word desc[GC_BITMAP_SIZE(EphemeronTable)] = { 0 };
+        GC_set_bit(desc, GC_WORD_OFFSET(EphemeronTable, m_keys));
+        descr = GC_make_descriptor(desc, GC_WORD_LEN(EphemeronTable));
+        typeInited = true;
+    }
+    return GC_MALLOC_EXPLICITLY_TYPED(size, descr);
+}
+
+Optional<EphemeronValueList::Entry*> EphemeronTable::findEntry(PointerValue* key)
+{
+    auto list = valueListOf(key);
+    if (!list) {
+        return nullptr;
+    }
+    auto& entries = list->m_entries;
+    for (size_t i = 0; i < entries.size(); i++) {
+        auto& e = entries[i];
+        // the slot check rejects an entry left behind on a key that was swept
+        // from this table but kept alive by finalization
+        if (e.m_tableId == m_id && e.m_slot < m_keys.size() && m_keys[e.m_slot] == key) {
+            return &e;
+        }
+    }
+    return nullptr;
+}
+
+Optional<EncodedValue*> EphemeronTable::find(PointerValue* key)
+{
+    auto e = findEntry(key);
+    if (e) {
+        return &e->m_value;
+    }
+    return nullptr;
+}
+
+void EphemeronTable::set(PointerValue* key, const Value& value)
+{
+    auto e = findEntry(key);
+    if (e) {
+        e->m_value = value;
+        return;
+    }
+
+    // allocations below may run a GC. key and value are held by the caller,
+    // and the entry is published only after the slot is in place
+    EphemeronValueList* list = ensureValueList(key);
+    size_t slot = allocateSlot(key);
+
+    auto& entries = list->m_entries;
+    for (size_t i = 0; i < entries.size(); i++) {
+        auto& entry = entries[i];
+        if (!entry.m_tableId || (entry.m_tableId == m_id && (entry.m_slot >= m_keys.size() || m_keys[entry.m_slot] != key))) {
+            entry.m_slot = slot;
+            entry.m_value = value;
+            entry.m_tableId = m_id;
+            return;
+        }
+    }
+
+    EphemeronValueList::Entry newEntry;
+    newEntry.m_tableId = m_id;
+    newEntry.m_slot = slot;
+    newEntry.m_value = value;
+    entries.pushBack(newEntry);
+}
+
+bool EphemeronTable::remove(PointerValue* key)
+{
+    auto e = findEntry(key);
+    if (!e) {
+        return false;
+    }
+    m_keys[e->m_slot] = nullptr;
+    m_deadKeyCount++;
+    e->m_tableId = 0;
+    e->m_value = Value(Value::EmptyValue);
+    return true;
+}
+
+size_t EphemeronTable::allocateSlot(PointerValue* key)
+{
+    if (m_deadKeyCount >= compactionMinimum && m_deadKeyCount * 2 >= m_keys.size()) {
+        compact();
+    }
+    m_keys.pushBack(key);
+    return m_keys.size() - 1;
+}
+
+void EphemeronTable::compact()
+{
+    // no allocation here, so no GC can observe a half-moved table
+    size_t live = 0;
+    for (size_t i = 0; i < m_keys.size(); i++) {
+        PointerValue* key = m_keys[i];
+        if (!key) {
+            continue;
+        }
+        if (live != i) {
+            auto list = valueListOf(key);
+            if (list) {
+                auto& entries = list->m_entries;
+                for (size_t j = 0; j < entries.size(); j++) {
+                    if (entries[j].m_tableId == m_id && entries[j].m_slot == i) {
+                        entries[j].m_slot = live;
+                        break;
+                    }
+                }
+            }
+            m_keys[live] = key;
+        }
+        live++;
+    }
+    m_keys.resizeWithUninitializedValues(live);
+    m_deadKeyCount = 0;
+}
+
+void EphemeronTable::clearDeadKeys()
+{
+    for (size_t i = 0; i < m_keys.size(); i++) {
+        PointerValue* key = m_keys[i];
+        if (key && !GC_is_marked(key)) {
+            // the value list dies together with the key
+            m_keys[i] = nullptr;
+            m_deadKeyCount++;
+        }
+    }
+}
+
+void EphemeronTable::releaseValuesOnLiveKeys()
+{
+    // values of an unreachable table stay marked through surviving keys for this
+    // cycle; drop them so the next cycle can reclaim them
+    for (size_t i = 0; i < m_keys.size(); i++) {
+        PointerValue* key = m_keys[i];
+        if (!key || !GC_is_marked(key)) {
+            continue;
+        }
+        auto list = valueListOf(key);
+        if (!list) {
+            continue;
+        }
+        auto& entries = list->m_entries;
+        for (size_t j = 0; j < entries.size(); j++) {
+            if (entries[j].m_tableId == m_id) {
+                entries[j].m_tableId = 0;
+                entries[j].m_value = Value(Value::EmptyValue);
+            }
+        }
+    }
+}
+
+void EphemeronTable::sweep(EphemeronTableVector& tables)
+{
+    size_t live = 0;
+    for (size_t i = 0; i < tables.size(); i++) {
+        EphemeronTable* table = tables[i];
+        if (GC_is_marked(table)) {
+            table->clearDeadKeys();
+            tables[live++] = table;
+        } else {
+            table->releaseValuesOnLiveKeys();
+        }
+    }
+    tables.resize(live);
+}
+
+} // namespace Escargot
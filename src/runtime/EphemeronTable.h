@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2026-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#ifndef __EscargotEphemeronTable__
+#define __EscargotEphemeronTable__
+
+#include "runtime/Value.h"
+#include "util/Vector.h"
+
+namespace Escargot {
+
+class EphemeronTable;
+typedef std::vector<EphemeronTable*> EphemeronTableVector;
+
+// values of weak collection entries. the list hangs off the key (Object or Symbol),
+// so the GC reaches a value only through its key: a value which refers back to its
+// own key does not keep the entry alive. an entry with m_tableId == 0 is free
+struct EphemeronValueList : public gc {
+    struct Entry {
+        size_t m_tableId;
+        size_t m_slot; // index of the key in the owner table
+        EncodedValue m_value;
+    };
+
+    Vector<Entry, GCUtil::gc_malloc_allocator<Entry>> m_entries;
+};
+
+// key side of a WeakMap/WeakSet. keys are kept in GC_MALLOC_ATOMIC memory so the GC
+// does not trace them, and every table of the thread is swept once per GC cycle at
+// mark end (see ThreadLocal::ephemeronTables) instead of registering disappearing
+// links per entry. sweeping happens while the world is stopped, so it only clears
+// slots and entries in place and never allocates
+class EphemeronTable : public gc {
+public:
+    EphemeronTable();
+
+    Optional<EncodedValue*> find(PointerValue* key);
+    void set(PointerValue* key, const Value& value);
+    bool remove(PointerValue* key);
+
+    // called from the GC_EVENT_MARK_END listener
+    static void sweep(EphemeronTableVector& tables);
+
+    void* operator new(size_t size);
+    void* operator new[](size_t size) = delete;
+
+private:
+    static const size_t compactionMinimum = 16;
+
+    Optional<EphemeronValueList::Entry*> findEntry(PointerValue* key);
+    size_t allocateSlot(PointerValue* key);
+    void compact();
+    void clearDeadKeys();
+    void releaseValuesOnLiveKeys();
+
+    size_t m_id;
+    size_t m_deadKeyCount;
+    Vector<PointerValue*, GCUtil::gc_malloc_atomic_allocator<PointerValue*>> m_keys;
+};
+} // namespace Escargot
+
+#endif
@@ -26,6 +26,7 @@
 #include "runtime/EnvironmentRecord.h"
 #include "runtime/IteratorObject.h"
 #include "runtime/PromiseObject.h"
+#include "runtime/VMInstance.h"
 #include "interpreter/ByteCodeInterpreter.h"
 
 namespace Escargot {
@@ -65,13 +66,25 @@ ExecutionPauser::ExecutionPauser(ExecutionState& state, Object* sourceObject, Ex
     , m_byteCodeBlock(blk)
     , m_byteCodePosition(SIZE_MAX)
     , m_resumeByteCodePosition(SIZE_MAX)
+    , m_pausedCodeTailDataPosition(SIZE_MAX)
     , m_pauseValue(nullptr)
+    , m_canRecycleRegisterFile(false)
+    , m_resumedWithoutIterResult(false)
+    , m_yieldedUnwrappedValue(false)
 #ifdef ESCARGOT_DEBUGGER
     , m_savedStackTrace(nullptr)
 #endif /* ESCARGOT_DEBUGGER */
 {
 }
 
+void ExecutionPauser::releaseAfterCompletion(ExecutionState& state)
+{
+    if (m_canRecycleRegisterFile && m_registerFile) {
+        state.context()->vmInstance()->recyclePooledRegisterFile(m_registerFile, m_byteCodeBlock->m_requiredTotalRegisterNumber);
+    }
+    release();
+}
+
 
 Value ExecutionPauser::start(ExecutionState& state, ExecutionPauser* self, Object* source, const Value& resumeValue, bool isAbruptReturn, bool isAbruptThrow, StartFrom from)
 {
@@ -205,6 +218,10 @@ Value ExecutionPauser::start(ExecutionState& state, ExecutionPauser* self, Objec
             }
 
             if (from == StartFrom::Generator) {
+                if (self->m_resumedWithoutIterResult) {
+                    // GeneratorObject::resumeWithoutIterResult reads the generator state
+                    return result;
+                }
                 if (source->asGeneratorObject()->m_generatorState >= GeneratorObject::GeneratorState::CompletedReturn) {
                     return IteratorObject::createIterResultObject(state, result, true);
                 }
@@ -218,7 +235,9 @@ Value ExecutionPauser::start(ExecutionState& state, ExecutionPauser* self, Objec
             // normal execution end
             if (from == StartFrom::Generator) {
                 source->asGeneratorObject()->m_generatorState = GeneratorObject::GeneratorState::CompletedReturn;
-                result = IteratorObject::createIterResultObject(state, result, true);
+                if (!self->m_resumedWithoutIterResult) {
+                    result = IteratorObject::createIterResultObject(state, result, true);
+                }
             } else if (from == StartFrom::AsyncGenerator) {
                 source->asAsyncGeneratorObject()->m_asyncGeneratorState = AsyncGeneratorObject::Completed;
                 result = AsyncGeneratorObject::asyncGeneratorResolve(state, source->asAsyncGeneratorObject(), result, true);
@@ -228,11 +247,11 @@ Value ExecutionPauser::start(ExecutionState& state, ExecutionPauser* self, Objec
                 Object::call(state, self->m_promiseCapability.m_resolveFunction, Value(), 1, &argv);
                 result = self->m_promiseCapability.m_promise;
             }
-            self->release();
+            self->releaseAfterCompletion(state);
         }
     } catch (const Value& thrownValue) {
         auto promiseCapability = self->m_promiseCapability;
-        self->release();
+        self->releaseAfterCompletion(state);
         if (from == StartFrom::Generator) {
             ASSERT(from == StartFrom::Generator);
             source->asGeneratorObject()->m_generatorState = GeneratorObject::GeneratorState::CompletedThrow;
@@ -315,10 +334,15 @@ void ExecutionPauser::pause(ExecutionState& state, Value returnValue, size_t tai
     originalState->m_parent = nullptr;
     originalState->m_programCounter = nullptr;
 
-    self->m_pausedCode.clear();
-
     // some case(async generator), the function execution ended before pause
-    if (self->m_byteCodeBlock) {
+    // paused code only depends on the tail data, so it can be reused when pausing at the same place again (e.g. await in a loop)
+    if (!self->m_byteCodeBlock) {
+        self->m_pausedCode.clear();
+        self->m_pausedCodeTailDataPosition = SIZE_MAX;
+    } else if (self->m_pausedCodeTailDataPosition != tailDataPosition) {
+        self->m_pausedCode.clear();
+        self->m_pausedCodeTailDataPosition = tailDataPosition;
+
         // read & fill recursive statement self
         char* start = (char*)(tailDataPosition);
         char* end = (char*)(start + tailDataLength);
@@ -61,8 +61,11 @@ public:
         m_registerFile = nullptr;
         m_byteCodeBlock = nullptr;
         m_pausedCode.clear();
+        m_pausedCodeTailDataPosition = SIZE_MAX;
         m_pauseValue = nullptr;
         m_resumeValue = EncodedValue();
+        m_resumeValueStore = nullptr;
+        m_resumeStateStore = nullptr;
         m_promiseCapability.m_promise = nullptr;
         m_promiseCapability.m_resolveFunction = nullptr;
         m_promiseCapability.m_rejectFunction = nullptr;
@@ -75,6 +78,7 @@ public:
     };
 
     static Value start(ExecutionState& state, ExecutionPauser* self, Object* source, const Value& resumeValue, bool isAbruptReturn, bool isAbruptThrow, StartFrom from);
+    void releaseAfterCompletion(ExecutionState& state);
     static void pause(ExecutionState& state, Value returnValue, size_t tailDataPosition, size_t tailDataLength, size_t nextProgramCounter,
                       Optional<Value*> resumeValueStore, Optional<Value*> resumeStateStore, PauseReason reason);
 
@@ -101,11 +105,18 @@ private:
     Vector<char, GCUtil::gc_malloc_atomic_allocator<char>> m_pausedCode;
     size_t m_byteCodePosition; // this indicates where we should execute next in interpreter
     size_t m_resumeByteCodePosition; // this indicates where ResumeByteCode located in
+    size_t m_pausedCodeTailDataPosition; // tail data m_pausedCode was built from
     PauseValue* m_pauseValue;
     EncodedValue m_resumeValue;
     Optional<Value*> m_resumeValueStore;
     Optional<Value*> m_resumeStateStore;
     PromiseReaction::Capability m_promiseCapability; // async function needs this
+    // the register file came from VMInstance::allocatePooledRegisterFile and nothing else refers it after completion
+    // (generators and async functions. async generators can complete while an outer resume still runs on it)
+    bool m_canRecycleRegisterFile;
+    // set by GeneratorObject::resumeWithoutIterResult; yield and completion then leave the value unwrapped
+    bool m_resumedWithoutIterResult;
+    bool m_yieldedUnwrappedValue;
 #ifdef ESCARGOT_DEBUGGER
     Debugger::SavedStackTraceDataVector* m_savedStackTrace;
 #endif /* ESCARGOT_DEBUGGER */
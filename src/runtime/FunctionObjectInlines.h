@@ -130,7 +130,7 @@ public:
         Value* registerFile;
 
         if (std::is_same<FunctionObjectType, ScriptGeneratorFunctionObject>::value || std::is_same<FunctionObjectType, ScriptAsyncFunctionObject>::value || std::is_same<FunctionObjectType, ScriptAsyncGeneratorFunctionObject>::value) {
-            registerFile = (Value*)CustomAllocator<Value>().allocate(registerFileSize);
+            registerFile = ctx->vmInstance()->allocatePooledRegisterFile(registerFileSize);
         } else {
             // keep ByteCodeBlock pointer in registerFileBuffer
             registerFile = (Value*)alloca((registerFileSize) * sizeof(Value) + sizeof(size_t));
@@ -178,6 +178,7 @@ public:
             Object* generatorObject;
             if (std::is_same<FunctionObjectType, ScriptGeneratorFunctionObject>::value) {
                 GeneratorObject* gen = new GeneratorObject(state, proto, newState, registerFile, blk);
+                gen->executionPauser()->m_canRecycleRegisterFile = true;
                 newState->setPauseSource(gen->executionPauser());
                 ExecutionPauser::start(state, newState->pauseSource().value(), newState->pauseSource()->sourceObject(), Value(), false, false, ExecutionPauser::StartFrom::Generator);
                 generatorObject = gen;
@@ -198,6 +199,7 @@ public:
         if (std::is_same<FunctionObjectType, ScriptAsyncFunctionObject>::value) {
             newState = new ExtendedExecutionState(ctx, nullptr, lexEnv, argc, argv, isStrict);
             newState->setPauseSource(new ExecutionPauser(state, self, newState, registerFile, blk));
+            newState->pauseSource()->m_canRecycleRegisterFile = true;
             newState->pauseSource()->m_promiseCapability = PromiseObject::newPromiseCapability(*newState, newState->context()->globalObject()->promise());
         } else if (blk->needsExtendedExecutionState()) {
             newState = new (alloca(sizeof(ExtendedExecutionState))) ExtendedExecutionState(ctx, &state, lexEnv, argc, argv, isStrict);
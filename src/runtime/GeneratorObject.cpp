@@ -105,4 +105,32 @@ Value GeneratorObject::generatorResumeAbrupt(ExecutionState& state, const Value&
     gen->m_generatorState = GeneratorObject::GeneratorState::Executing;
     return ExecutionPauser::start(state, gen->executionPauser(), gen, value, type == GeneratorObject::GeneratorAbruptType::Return, type == GeneratorObject::GeneratorAbruptType::Throw, ExecutionPauser::Generator);
 }
+Value GeneratorObject::resumeWithoutIterResult(ExecutionState& state, bool& done, bool& isIterResult)
+{
+    generatorValidate(state, this);
+
+    if (m_generatorState >= GeneratorObject::GeneratorState::CompletedReturn) {
+        done = true;
+        isIterResult = false;
+        return Value();
+    }
+
+    ASSERT(m_generatorState == GeneratorObject::GeneratorState::SuspendedStart || m_generatorState == GeneratorObject::GeneratorState::SuspendedYield);
+
+    m_generatorState = GeneratorObject::GeneratorState::Executing;
+    m_executionPauser.m_resumedWithoutIterResult = true;
+    m_executionPauser.m_yieldedUnwrappedValue = false;
+    Value result;
+    try {
+        result = ExecutionPauser::start(state, &m_executionPauser, this, Value(), false, false, ExecutionPauser::Generator);
+    } catch (const Value& thrownValue) {
+        m_executionPauser.m_resumedWithoutIterResult = false;
+        throw thrownValue;
+    }
+    m_executionPauser.m_resumedWithoutIterResult = false;
+
+    done = m_generatorState >= GeneratorObject::GeneratorState::CompletedReturn;
+    isIterResult = !done && !m_executionPauser.m_yieldedUnwrappedValue;
+    return result;
+}
 } // namespace Escargot
@@ -68,6 +68,10 @@ public:
     static GeneratorObject* generatorValidate(ExecutionState& state, const Value& generator);
     static Value generatorResume(ExecutionState& state, const Value& generator, const Value& value);
     static Value generatorResumeAbrupt(ExecutionState& state, const Value& generator, const Value& value, GeneratorObject::GeneratorAbruptType type);
+    // same as generatorResume(undefined) without creating the IteratorResult object.
+    // done is set when the generator completed. otherwise the result is the yielded value,
+    // or the IteratorResult of the inner iterator which yield* passed through (isIterResult)
+    Value resumeWithoutIterResult(ExecutionState& state, bool& done, bool& isIterResult);
 
 private:
     static inline void fillGCDescriptor(GC_word* desc)
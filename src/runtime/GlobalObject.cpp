@@ -79,6 +79,17 @@ void GlobalObject::initializeBuiltins(ExecutionState& state)
     // m_objectPrototype has been initialized ahead of any other builtins
     ASSERT(!!m_objectPrototype);
 
+    /*
+       a later Context of a VMInstance starts from the global object structure of the first one,
+       so lazy builtins find their accessor in place and eager installers store their objects
+       through defineBuiltinProperty into the existing slots
+    */
+    VMInstance* instance = state.context()->vmInstance();
+    Optional<GlobalObjectLayoutCache*> layoutCache = instance->globalObjectLayoutCache();
+    if (layoutCache) {
+        applyLayoutCache(layoutCache.value());
+    }
+
     /*
        initialize all global builtin properties by calling initialize##objName method
        Object, Function and other prerequisite builtins are installed ahead
@@ -88,6 +99,73 @@ void GlobalObject::initializeBuiltins(ExecutionState& state)
 
     GLOBALOBJECT_BUILTIN_OBJECT_LIST(DECLARE_BUILTIN_INIT_FUNC, )
 #undef DECLARE_BUILTIN_INIT_FUNC
+
+    if (layoutCache) {
+        // every property should have been found in the cached layout
+        RELEASE_ASSERT(m_structure->propertyCount() == layoutCache->m_structure->propertyCount());
+    } else {
+        instance->setGlobalObjectLayoutCache(createLayoutCache());
+    }
+}
+
+void GlobalObject::applyLayoutCache(GlobalObjectLayoutCache* layoutCache)
+{
+    ASSERT(m_structure->propertyCount() == 0);
+
+    size_t propertyCount = layoutCache->m_structure->propertyCount();
+    m_structure = layoutCache->m_structure;
+    m_values.resizeWithUninitializedValues(0, propertyCount);
+    for (size_t i = 0; i < propertyCount; i++) {
+        m_values[i] = layoutCache->m_values[i];
+    }
+}
+
+GlobalObjectLayoutCache* GlobalObject::createLayoutCache()
+{
+    size_t propertyCount = m_structure->propertyCount();
+    GlobalObjectLayoutCache* layoutCache = new GlobalObjectLayoutCache();
+    layoutCache->m_structure = m_structure;
+    layoutCache->m_values.resizeWithUninitializedValues(0, propertyCount);
+    for (size_t i = 0; i < propertyCount; i++) {
+        Value v(m_values[i]);
+        // pointer values are objects of this Context, the eager installers of the next Context refill them.
+        // the internal data of native accessors is the empty value, which is kept as is
+        bool isContextObject = v.isPointerValue() && !v.isEmpty();
+        ASSERT(!isContextObject || m_structure->readProperty(i).m_descriptor.isPlainDataProperty());
+        layoutCache->m_values[i] = isContextObject ? Value() : v;
+    }
+
+    // the structure is shared from now on. a non-transition structure hands its
+    // property vector over to the next structure unless it is marked like this
+    m_structure->markReferencedByInlineCache();
+    return layoutCache;
+}
+
+void GlobalObject::defineBuiltinProperty(ExecutionState& state, const AtomicString& name, Object* builtin)
+{
+    auto findResult = m_structure->findProperty(ObjectStructurePropertyName(name));
+    if (findResult.first != SIZE_MAX) {
+        // present in the cached layout with the expected attributes
+        ASSERT(findResult.second.value()->m_descriptor.isPlainDataProperty() && !findResult.second.value()->m_descriptor.isEnumerable());
+        m_values[findResult.first] = Value(builtin);
+        return;
+    }
+
+    directDefineOwnProperty(state, ObjectPropertyName(name),
+                            ObjectPropertyDescriptor(builtin, (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::WritablePresent | ObjectPropertyDescriptor::ConfigurablePresent)));
+}
+
+void GlobalObject::redefineLazyBuiltinProperty(ExecutionState& state, const AtomicString& name, Object* builtin)
+{
+    // the accessor may have been deleted or replaced before the first access,
+    // e.g. when an intrinsic of this builtin is requested from another realm
+    auto findResult = m_structure->findProperty(ObjectStructurePropertyName(name));
+    if (findResult.first == SIZE_MAX || !findResult.second.value()->m_descriptor.isNativeAccessorProperty()) {
+        return;
+    }
+
+    redefineOwnProperty(state, ObjectPropertyName(name),
+                        ObjectPropertyDescriptor(builtin, (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::WritablePresent | ObjectPropertyDescriptor::ConfigurablePresent)));
 }
 
 Value builtinSpeciesGetter(ExecutionState& state, Value thisValue, size_t argc, Value* argv, Optional<Object*> newTarget)
@@ -1061,6 +1139,20 @@ void GlobalObject::installOthers(ExecutionState& state)
     // This property has the attributes { [[Writable]]: true, [[Enumerable]]: false, [[Configurable]]: true }.
     defineOwnProperty(state, ObjectPropertyName(strings->globalThis),
                       ObjectPropertyDescriptor(this, (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::WritablePresent | ObjectPropertyDescriptor::ConfigurablePresent)));
+}
+
+void GlobalObject::initializeDisposableStack(ExecutionState& state)
+{
+    ObjectPropertyNativeGetterSetterData* nativeData = new ObjectPropertyNativeGetterSetterData(true, false, true, [](ExecutionState& state, Object* self, const Value& receiver, const EncodedValue& privateDataFromObjectPrivateArea) -> Value {
+                                                                                                    ASSERT(self->isGlobalObject());
+                                                                                                    return self->asGlobalObject()->disposableStack(); }, nullptr);
+
+    defineNativeDataAccessorProperty(state, ObjectPropertyName(state.context()->staticStrings().DisposableStack), nativeData, Value(Value::EmptyValue));
+}
+
+void GlobalObject::installDisposableStack(ExecutionState& state)
+{
+    const StaticStrings* strings = &state.context()->staticStrings();
 
     m_disposableStack = new NativeFunctionObject(state, NativeFunctionInfo(strings->DisposableStack, builtinDisposableStackConstructor, 0), NativeFunctionObject::__ForBuiltinConstructor__);
     m_disposableStack->setGlobalIntrinsicObject(state, true);
@@ -1068,9 +1160,7 @@ void GlobalObject::installOthers(ExecutionState& state)
     m_disposableStackPrototype->setGlobalIntrinsicObject(state, true);
     m_disposableStack->setFunctionPrototype(state, m_disposableStackPrototype);
 
-    defineOwnProperty(state, ObjectPropertyName(strings->DisposableStack),
-                      ObjectPropertyDescriptor(m_disposableStack,
-                                               (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::WritablePresent | ObjectPropertyDescriptor::ConfigurablePresent)));
+    redefineLazyBuiltinProperty(state, strings->DisposableStack, m_disposableStack);
 
     m_disposableStackPrototype->defineOwnProperty(state, ObjectPropertyName(state.context()->vmInstance()->globalSymbols().toStringTag),
                                                   ObjectPropertyDescriptor(strings->DisposableStack.string(),
@@ -1107,6 +1197,20 @@ void GlobalObject::installOthers(ExecutionState& state)
         ObjectPropertyDescriptor desc(gs, ObjectPropertyDescriptor::ConfigurablePresent);
         m_disposableStackPrototype->directDefineOwnProperty(state, ObjectPropertyName(state, strings->disposed), desc);
     }
+}
+
+void GlobalObject::initializeAsyncDisposableStack(ExecutionState& state)
+{
+    ObjectPropertyNativeGetterSetterData* nativeData = new ObjectPropertyNativeGetterSetterData(true, false, true, [](ExecutionState& state, Object* self, const Value& receiver, const EncodedValue& privateDataFromObjectPrivateArea) -> Value {
+                                                                                                    ASSERT(self->isGlobalObject());
+                                                                                                    return self->asGlobalObject()->asyncDisposableStack(); }, nullptr);
+
+    defineNativeDataAccessorProperty(state, ObjectPropertyName(state.context()->staticStrings().AsyncDisposableStack), nativeData, Value(Value::EmptyValue));
+}
+
+void GlobalObject::installAsyncDisposableStack(ExecutionState& state)
+{
+    const StaticStrings* strings = &state.context()->staticStrings();
 
     m_asyncDisposableStack = new NativeFunctionObject(state, NativeFunctionInfo(strings->AsyncDisposableStack, builtinAsyncDisposableStackConstructor, 0), NativeFunctionObject::__ForBuiltinConstructor__);
     m_asyncDisposableStack->setGlobalIntrinsicObject(state, true);
@@ -1114,9 +1218,7 @@ void GlobalObject::installOthers(ExecutionState& state)
     m_asyncDisposableStackPrototype->setGlobalIntrinsicObject(state, true);
     m_asyncDisposableStack->setFunctionPrototype(state, m_asyncDisposableStackPrototype);
 
-    defineOwnProperty(state, ObjectPropertyName(strings->AsyncDisposableStack),
-                      ObjectPropertyDescriptor(m_asyncDisposableStack,
-                                               (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::WritablePresent | ObjectPropertyDescriptor::ConfigurablePresent)));
+    redefineLazyBuiltinProperty(state, strings->AsyncDisposableStack, m_asyncDisposableStack);
 
     m_asyncDisposableStackPrototype->defineOwnProperty(state, ObjectPropertyName(state.context()->vmInstance()->globalSymbols().toStringTag),
                                                        ObjectPropertyDescriptor(strings->AsyncDisposableStack.string(),
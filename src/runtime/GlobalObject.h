@@ -37,6 +37,9 @@ class FunctionObject;
     F(arrayIteratorPrototype, Object, objName)             \
     F(arrayIteratorPrototypeNext, FunctionObject, objName) \
     F(arrayPrototypeValues, FunctionObject, objName)
+#define GLOBALOBJECT_BUILTIN_ASYNCDISPOSABLESTACK(F, objName) \
+    F(asyncDisposableStack, FunctionObject, objName)          \
+    F(asyncDisposableStackPrototype, Object, objName)
 #define GLOBALOBJECT_BUILTIN_ASYNCFROMSYNCITERATOR(F, objName) \
     F(asyncFromSyncIteratorPrototype, Object, objName)
 #define GLOBALOBJECT_BUILTIN_ASYNCFUNCTION(F, objName) \
@@ -56,6 +59,9 @@ class FunctionObject;
 #define GLOBALOBJECT_BUILTIN_DATE(F, objName) \
     F(date, FunctionObject, objName)          \
     F(datePrototype, Object, objName)
+#define GLOBALOBJECT_BUILTIN_DISPOSABLESTACK(F, objName) \
+    F(disposableStack, FunctionObject, objName)          \
+    F(disposableStackPrototype, Object, objName)
 #define GLOBALOBJECT_BUILTIN_ERROR(F, objName)   \
     F(error, FunctionObject, objName)            \
     F(errorPrototype, Object, objName)           \
@@ -85,7 +91,8 @@ class FunctionObject;
 #define GLOBALOBJECT_BUILTIN_GENERATOR(F, objName) \
     F(generatorFunction, FunctionObject, objName)  \
     F(generator, Object, objName)                  \
-    F(generatorPrototype, Object, objName)
+    F(generatorPrototype, Object, objName)         \
+    F(generatorPrototypeNext, FunctionObject, objName)
 // INTL
 #if defined(ENABLE_ICU) && defined(ENABLE_INTL)
 #if defined(ENABLE_INTL_DISPLAYNAMES)
@@ -177,18 +184,14 @@ class FunctionObject;
     F(objectFreeze, FunctionObject, objName)    \
     F(objectPrototype, Object, objName)         \
     F(objectPrototypeToString, FunctionObject, objName)
-#define GLOBALOBJECT_BUILTIN_OTHERS(F, objName)      \
-    F(eval, FunctionObject, objName)                 \
-    F(parseInt, FunctionObject, objName)             \
-    F(parseFloat, FunctionObject, objName)           \
-    F(arrayToString, FunctionObject, objName)        \
-    F(asyncIteratorPrototype, Object, objName)       \
-    F(iteratorPrototype, Object, objName)            \
-    F(genericIteratorPrototype, Object, objName)     \
-    F(disposableStack, FunctionObject, objName)      \
-    F(disposableStackPrototype, Object, objName)     \
-    F(asyncDisposableStack, FunctionObject, objName) \
-    F(asyncDisposableStackPrototype, Object, objName)
+#define GLOBALOBJECT_BUILTIN_OTHERS(F, objName)  \
+    F(eval, FunctionObject, objName)             \
+    F(parseInt, FunctionObject, objName)         \
+    F(parseFloat, FunctionObject, objName)       \
+    F(arrayToString, FunctionObject, objName)    \
+    F(asyncIteratorPrototype, Object, objName)   \
+    F(iteratorPrototype, Object, objName)        \
+    F(genericIteratorPrototype, Object, objName)
 
 #define GLOBALOBJECT_BUILTIN_PROMISE(F, objName)  \
     F(promise, FunctionObject, objName)           \
@@ -340,6 +343,7 @@ class FunctionObject;
 #define GLOBALOBJECT_BUILTIN_OBJECT_LIST(F, ARG)         \
     F(ARRAYBUFFER, ArrayBuffer, ARG)                     \
     F(ARRAY, Array, ARG)                                 \
+    F(ASYNCDISPOSABLESTACK, AsyncDisposableStack, ARG)   \
     F(ASYNCFROMSYNCITERATOR, AsyncFromSyncIterator, ARG) \
     F(ASYNCFUNCTION, AsyncFunction, ARG)                 \
     F(ASYNCGENERATOR, AsyncGenerator, ARG)               \
@@ -347,6 +351,7 @@ class FunctionObject;
     F(BOOLEAN, Boolean, ARG)                             \
     F(DATAVIEW, DataView, ARG)                           \
     F(DATE, Date, ARG)                                   \
+    F(DISPOSABLESTACK, DisposableStack, ARG)             \
     F(ERROR, Error, ARG)                                 \
     F(FINALIZATIONREGISTRY, FinalizationRegistry, ARG)   \
     F(FUNCTION, Function, ARG)                           \
@@ -387,6 +392,13 @@ Value builtinSpeciesGetter(ExecutionState& state, Value thisValue, size_t argc,
 
 class IntlDateTimeFormatObject;
 
+// structure and non-object values of the global object after the first initializeBuiltins of a VMInstance.
+// object values are not kept, the installers of each Context store their own objects into the slots
+struct GlobalObjectLayoutCache : public gc {
+    ObjectStructure* m_structure;
+    ObjectPropertyValueVector m_values;
+};
+
 #if defined(ENABLE_EXTENDED_API)
 // for certain third-party cases, GlobalObject's prototype can be modified
 class GlobalObject : public PrototypeObject {
@@ -493,6 +505,11 @@ private:
     GLOBALOBJECT_BUILTIN_OBJECT_LIST(DECLARE_BUILTIN_MEMBER_FUNC, )
 #undef DECLARE_BUILTIN_MEMBER_FUNC
 
+    void applyLayoutCache(GlobalObjectLayoutCache* layoutCache);
+    GlobalObjectLayoutCache* createLayoutCache();
+    void defineBuiltinProperty(ExecutionState& state, const AtomicString& name, Object* builtin);
+    void redefineLazyBuiltinProperty(ExecutionState& state, const AtomicString& name, Object* builtin);
+
     template <typename TA, int elementSize>
     FunctionObject* installTypedArray(ExecutionState& state, AtomicString taName, Object** proto, FunctionObject* typedArrayFunction);
 };
@@ -27,6 +27,7 @@
 #include "runtime/ArrayObject.h"
 #include "runtime/SetObject.h"
 #include "runtime/ScriptAsyncFunctionObject.h"
+#include "runtime/GeneratorObject.h"
 #include "runtime/StringObject.h"
 #include "runtime/ArrayBuffer.h"
 
@@ -189,14 +190,18 @@ IteratorRecord* IteratorObject::getIterator(ExecutionState& state, const Value&
 
 void IteratorObject::tryMarkFastBuiltinIterator(ExecutionState& state, IteratorRecord* record)
 {
-    if (!record->m_iteratorSlot.value()->isIteratorObject()) {
-        return;
-    }
     Value nextMethod = record->m_nextMethod;
     if (!nextMethod.isPointerValue()) {
         return;
     }
     PointerValue* nm = nextMethod.asPointerValue();
+    if (record->m_iteratorSlot.value()->isGeneratorObject()) {
+        record->m_isFastGenerator = (nm == state.context()->globalObject()->generatorPrototypeNext());
+        return;
+    }
+    if (!record->m_iteratorSlot.value()->isIteratorObject()) {
+        return;
+    }
     IteratorObject* io = record->m_iteratorSlot.value()->asIteratorObject();
     GlobalObject* g = state.context()->globalObject();
     bool fast = false;
@@ -354,8 +359,26 @@ Optional<Value> IteratorObject::iteratorStepValue(ExecutionState& state, Iterato
         }
         return Optional<Value>(res.first);
     }
-    // Let result be ? IteratorStep(iteratorRecord).
-    auto result = iteratorStep(state, iteratorRecord);
+    Optional<Object*> result;
+    if (iteratorRecord->m_isFastGenerator) {
+        // calling the builtin next resumes the generator; only the IteratorResult object is skipped
+        bool done, isIterResult;
+        Value stepped = iteratorRecord->m_iteratorSlot.value()->asGeneratorObject()->resumeWithoutIterResult(state, done, isIterResult);
+        if (done) {
+            return NullOption;
+        }
+        if (!isIterResult) {
+            return Optional<Value>(stepped);
+        }
+        if (!stepped.isObject()) {
+            ErrorObject::throwBuiltinError(state, ErrorCode::TypeError, "result is not an object");
+        }
+        // yield* handed the inner IteratorResult through. read it as IteratorStep would
+        result = IteratorObject::iteratorComplete(state, stepped.asObject()) ? nullptr : stepped.asObject();
+    } else {
+        // Let result be ? IteratorStep(iteratorRecord).
+        result = iteratorStep(state, iteratorRecord);
+    }
     // If result is done, then
     if (!result) {
         // Return done.
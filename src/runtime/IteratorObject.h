@@ -51,6 +51,10 @@ public:
     // builtin. stepping via IteratorObject::advance() is then observably
     // identical to Call(nextMethod, iterator)
     bool m_isFastBuiltinIterator{ false };
+    // true when the iterator is a generator of the current realm whose next method is the
+    // untouched %GeneratorPrototype%.next. IteratorStepValue then resumes it directly and
+    // takes the yielded value without the IteratorResult object
+    bool m_isFastGenerator{ false };
     // the spec drops [[IteratedObject]] once the iteration ends, so an array
     // that grows afterwards must not resurrect the iteration
     bool m_directArrayDone{ false };
@@ -565,7 +565,7 @@ static void builtinJSONStringifyJO(ExecutionState& state, Object* value,
     String* seperator = strings->asciiTable[(size_t)','].string();
 
     product.appendChar('{');
-    LargeStringBuilder subProduct;
+    LargeStringBuilder subProduct(LargeStringBuilder::ContiguousBufferMode);
     for (size_t i = 0; i < len; i++) {
         auto strP = builtinJSONStringifyStr(state, k[i], value, strings, replacerFunc, stack, indent, gap, propertyListTouched, propertyList, subProduct);
         if (strP) {
@@ -837,7 +837,7 @@ Value JSON::stringify(ExecutionState& state, Value value, Value replacer, Value
     Object* wrapper = new Object(state);
     // 10
     wrapper->defineOwnProperty(state, ObjectPropertyName(state, String::emptyString()), ObjectPropertyDescriptor(value, ObjectPropertyDescriptor::AllPresent));
-    LargeStringBuilder product;
+    LargeStringBuilder product(LargeStringBuilder::ContiguousBufferMode);
     auto ret = builtinJSONStringifyStr(state, String::emptyString(), wrapper, strings, replacerFunc, stack, indent, gap, propertyListTouched, propertyList, product);
     if (ret) {
         return product.finalize(&state);
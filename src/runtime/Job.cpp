@@ -23,16 +23,21 @@
 #include "VMInstance.h"
 #include "SandBox.h"
 #include "runtime/FinalizationRegistryObject.h"
+#include "runtime/ScriptAsyncFunctionObject.h"
 
 namespace Escargot {
 
 SandBox::SandBoxResult PromiseReactionJob::run()
 {
-    Context* context = relatedContext();
+    return runReaction(relatedContext(), m_reaction, m_argument);
+}
+
+SandBox::SandBoxResult PromiseReactionJob::runReaction(Context* context, const PromiseReaction& reaction, const Value& argument)
+{
     ExecutionState state(context);
 
     if (UNLIKELY(context->vmInstance()->isPromiseHookRegistered())) {
-        Object* promiseTarget = m_reaction.m_capability.m_promise;
+        Object* promiseTarget = reaction.m_capability.m_promise;
         PromiseObject* promise = (promiseTarget && promiseTarget->isPromiseObject()) ? promiseTarget->asPromiseObject() : nullptr;
         context->vmInstance()->triggerPromiseHook(state, VMInstance::PromiseHookType::Before, promise, Value());
     }
@@ -42,25 +47,35 @@ SandBox::SandBoxResult PromiseReactionJob::run()
     ExecutionState* activeSavedStackTraceExecutionState = ESCARGOT_DEBUGGER_NO_STACK_TRACE_RESTORE;
     Debugger::SavedStackTraceDataVector* activeSavedStackTrace = nullptr;
 
-    if (debugger != nullptr && m_reaction.m_capability.m_savedStackTrace != nullptr) {
+    if (debugger != nullptr && reaction.m_capability.m_savedStackTrace != nullptr) {
         activeSavedStackTraceExecutionState = debugger->activeSavedStackTraceExecutionState();
         activeSavedStackTrace = debugger->activeSavedStackTrace();
-        debugger->setActiveSavedStackTrace(&state, m_reaction.m_capability.m_savedStackTrace);
+        debugger->setActiveSavedStackTrace(&state, reaction.m_capability.m_savedStackTrace);
     }
 #endif /* ESCARGOT_DEBUGGER */
 
     // https://www.ecma-international.org/ecma-262/10.0/#sec-promisereactionjob
+    struct ReactionData {
+        const PromiseReaction& m_reaction;
+        const Value& m_argument;
+    } reactionData = { reaction, argument };
+
     SandBox sandbox(context);
     SandBox::SandBoxResult result = sandbox.run(state, [](ExecutionState& state, void* data) -> Value {
-        PromiseReactionJob* self = reinterpret_cast<PromiseReactionJob*>(data);
+        ReactionData* self = reinterpret_cast<ReactionData*>(data);
+        if (self->m_reaction.isAwaitReaction()) {
+            ScriptAsyncFunctionObject::awaitResume(state, self->m_reaction, self->m_argument);
+            return Value();
+        }
+
         /* 25.4.2.1.4 Handler is "Identity" case */
-        if (self->m_reaction.m_handler == (Object*)1) {
+        if (self->m_reaction.hasReservedHandler(PromiseReaction::Identity)) {
             Value value[] = { self->m_argument };
             return Object::call(state, self->m_reaction.m_capability.m_resolveFunction, Value(), 1, value);
         }
 
         /* 25.4.2.1.5 Handler is "Thrower" case */
-        if (self->m_reaction.m_handler == (Object*)2) {
+        if (self->m_reaction.hasReservedHandler(PromiseReaction::Thrower)) {
             Value value[] = { self->m_argument };
             return Object::call(state, self->m_reaction.m_capability.m_rejectFunction, Value(), 1, value);
         }
@@ -83,7 +98,7 @@ SandBox::SandBoxResult PromiseReactionJob::run()
             }
         }
 
-        return res; }, this);
+        return res; }, &reactionData);
 
 #ifdef ESCARGOT_DEBUGGER
     if (activeSavedStackTraceExecutionState != ESCARGOT_DEBUGGER_NO_STACK_TRACE_RESTORE) {
@@ -92,7 +107,7 @@ SandBox::SandBoxResult PromiseReactionJob::run()
 #endif /* ESCARGOT_DEBUGGER */
 
     if (UNLIKELY(context->vmInstance()->isPromiseHookRegistered())) {
-        Object* promiseTarget = m_reaction.m_capability.m_promise;
+        Object* promiseTarget = reaction.m_capability.m_promise;
         PromiseObject* promise = (promiseTarget && promiseTarget->isPromiseObject()) ? promiseTarget->asPromiseObject() : nullptr;
         context->vmInstance()->triggerPromiseHook(state, VMInstance::PromiseHookType::After, promise, Value());
     }
@@ -60,6 +60,9 @@ public:
 
     SandBox::SandBoxResult run();
 
+    // JobQueue stores promise reactions inline and runs them through here without a PromiseReactionJob object
+    static SandBox::SandBoxResult runReaction(Context* relatedContext, const PromiseReaction& reaction, const Value& argument);
+
 private:
     PromiseReaction m_reaction;
     Value m_argument;
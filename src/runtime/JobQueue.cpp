@@ -28,17 +28,94 @@ namespace Escargot {
 
 void JobQueue::enqueueJob(Job* job)
 {
-    m_jobs.push_back(job);
+    JobRecord& record = pushRecord();
+    record.m_relatedContext = job->relatedContext();
+    record.m_job = job;
+}
+
+void JobQueue::enqueuePromiseReactionJob(Context* relatedContext, const PromiseReaction& reaction, const Value& argument)
+{
+    JobRecord& record = pushRecord();
+    record.m_relatedContext = relatedContext;
+    record.m_reaction = reaction;
+    record.m_argument = argument;
+}
+
+SandBox::SandBoxResult JobQueue::runNextJob()
+{
+    ASSERT(m_size);
+    // copy the record out first. running the job can enqueue more jobs and reallocate the buffer
+    JobRecord record = m_buffer[m_head];
+    m_buffer[m_head] = JobRecord();
+    m_head = (m_head + 1) & (m_capacity - 1);
+    m_size--;
+    releaseBufferIfNeeded();
+
+    if (record.m_job) {
+        return record.m_job->run();
+    }
+    return PromiseReactionJob::runReaction(record.m_relatedContext, record.m_reaction, record.m_argument);
 }
 
 void JobQueue::clearJobRelatedWithSpecificContext(Context* context)
 {
-    for (size_t i = 0; i < m_jobs.size();) {
-        if (m_jobs[i]->relatedContext() == context) {
-            m_jobs.erase(i);
-            continue;
+    size_t newSize = 0;
+    for (size_t i = 0; i < m_size; i++) {
+        JobRecord& record = recordAt(i);
+        if (record.m_relatedContext != context) {
+            if (newSize != i) {
+                recordAt(newSize) = record;
+            }
+            newSize++;
         }
-        i++;
+    }
+    for (size_t i = newSize; i < m_size; i++) {
+        recordAt(i) = JobRecord();
+    }
+    m_size = newSize;
+    releaseBufferIfNeeded();
+}
+
+JobQueue::JobRecord& JobQueue::pushRecord()
+{
+    if (UNLIKELY(m_size == m_capacity)) {
+        grow();
+    }
+    m_size++;
+    if (m_size > m_highWaterMark) {
+        m_highWaterMark = m_size;
+    }
+    return recordAt(m_size - 1);
+}
+
+void JobQueue::grow()
+{
+    size_t newCapacity = m_capacity ? m_capacity * 2 : JOB_QUEUE_INITIAL_CAPACITY;
+    ASSERT((newCapacity & (newCapacity - 1)) == 0);
+    JobRecord* newBuffer = reinterpret_cast<JobRecord*>(GC_MALLOC(sizeof(JobRecord) * newCapacity));
+    for (size_t i = 0; i < m_size; i++) {
+        new (&newBuffer[i]) JobRecord(recordAt(i));
+    }
+    for (size_t i = m_size; i < newCapacity; i++) {
+        new (&newBuffer[i]) JobRecord();
+    }
+
+    if (m_buffer) {
+        GC_FREE(m_buffer);
+    }
+    m_buffer = newBuffer;
+    m_capacity = newCapacity;
+    m_head = 0;
+}
+
+void JobQueue::releaseBufferIfNeeded()
+{
+    // give back the memory of a burst once the queue is drained
+    if (!m_size && m_capacity > JOB_QUEUE_RETAINED_CAPACITY) {
+        GC_FREE(m_buffer);
+        m_buffer = nullptr;
+        m_capacity = 0;
+        m_head = 0;
     }
 }
 } // namespace Escargot
@@ -26,26 +26,75 @@ namespace Escargot {
 
 class ExecutionState;
 
+// pending jobs are kept in a growable ring buffer of inline records
+// promise reaction jobs (the common case) are stored by value and do not need a Job object
 class JobQueue : public gc {
 public:
-    JobQueue() {}
+    JobQueue()
+        : m_buffer(nullptr)
+        , m_capacity(0)
+        , m_head(0)
+        , m_size(0)
+        , m_highWaterMark(0)
+    {
+    }
+
     void enqueueJob(Job* job);
+    void enqueuePromiseReactionJob(Context* relatedContext, const PromiseReaction& reaction, const Value& argument);
     void clearJobRelatedWithSpecificContext(Context* context);
     bool hasNextJob()
     {
-        return !m_jobs.empty();
+        return m_size;
+    }
+
+    // removes the first job from the queue and runs it
+    SandBox::SandBoxResult runNextJob();
+
+    size_t size() const
+    {
+        return m_size;
+    }
+
+    size_t highWaterMark() const
+    {
+        return m_highWaterMark;
     }
 
-    Job* nextJob()
+    void resetHighWaterMark()
     {
-        ASSERT(!m_jobs.empty());
-        Job* job = *m_jobs.begin();
-        m_jobs.erase(0);
-        return job;
+        m_highWaterMark = m_size;
     }
 
 private:
-    Vector<Job*, gc_allocator<Job*>> m_jobs;
+    struct JobRecord {
+        JobRecord()
+            : m_relatedContext(nullptr)
+            , m_job(nullptr)
+        {
+        }
+
+        Context* m_relatedContext;
+        // nullptr for inline promise reaction job
+        Job* m_job;
+        PromiseReaction m_reaction;
+        EncodedValue m_argument;
+    };
+
+    JobRecord& recordAt(size_t index)
+    {
+        ASSERT(index < m_size);
+        return m_buffer[(m_head + index) & (m_capacity - 1)];
+    }
+
+    JobRecord& pushRecord();
+    void grow();
+    void releaseBufferIfNeeded();
+
+    JobRecord* m_buffer;
+    size_t m_capacity; // always power of 2
+    size_t m_head;
+    size_t m_size;
+    size_t m_highWaterMark;
 };
 } // namespace Escargot
 #endif // __EscargotJobQueue__
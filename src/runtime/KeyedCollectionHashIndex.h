@@ -25,7 +25,7 @@
 
 namespace Escargot {
 
-// Open-addressing hash index used by Map/Set/WeakMap/WeakSet on top of their
+// Open-addressing hash index used by Map/Set on top of their
 // insertion-ordered storage vector. A bucket holds (storageIndex + 1); 0 means
 // empty. Deletion in the storage (tombstoning an entry) leaves the bucket
 // untouched: a stale bucket fails the key comparison, acts as a collision
@@ -73,6 +73,46 @@ struct KeyedCollectionHashIndex {
     }
 };
 
+// Map/Set compact their storage once at least half of it is tombstones.
+// Iterators created before a compaction keep the record that was current
+// when they last advanced; compaction fills that record with the removed
+// storage indexes and links a fresh one, and the iterator walks the chain
+// lazily to translate its position. The collection only references the
+// current record, so records no iterator holds are collected.
+struct KeyedCollectionCompactionRecord : public gc {
+    // tombstone count below which the storage is never compacted
+    static const size_t compactionMinimum = 8;
+
+    KeyedCollectionCompactionRecord()
+        : m_next(nullptr)
+        , m_removedIndexes(nullptr)
+        , m_removedCount(0)
+    {
+    }
+
+    static bool shouldCompact(size_t storageSize, size_t liveCount)
+    {
+        size_t tombstones = storageSize - liveCount;
+        return tombstones >= compactionMinimum && tombstones >= liveCount;
+    }
+
+    // moves an iterator position across every compaction made after record
+    static KeyedCollectionCompactionRecord* translate(KeyedCollectionCompactionRecord* record, size_t& index)
+    {
+        while (record->m_next) {
+            const uint32_t* removedBegin = record->m_removedIndexes;
+            const uint32_t* removedEnd = removedBegin + record->m_removedCount;
+            index -= std::lower_bound(removedBegin, removedEnd, (uint32_t)index) - removedBegin;
+            record = record->m_next;
+        }
+        return record;
+    }
+
+    KeyedCollectionCompactionRecord* m_next;
+    uint32_t* m_removedIndexes; // sorted, GC_MALLOC_ATOMIC
+    size_t m_removedCount;
+};
+
 // finalizer mix shared by every hash below (avalanches a 64-bit key so
 // nearby inputs land in unrelated buckets)
 inline uint64_t keyedCollectionHashMix(uint64_t u)
@@ -32,6 +32,8 @@ MapObject::MapObject(ExecutionState& state)
 
 MapObject::MapObject(ExecutionState& state, Object* proto)
     : DerivedObject(state, proto)
+    , m_liveCount(0)
+    , m_compactionBlockCount(0)
 {
 }
 
@@ -44,6 +46,7 @@ void* MapObject::operator new(size_t size)
         Object::fillGCDescriptor(obj_bitmap);
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(MapObject, m_storage));
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(MapObject, m_hashIndex));
+        GC_set_bit(obj_bitmap, GC_WORD_OFFSET(MapObject, m_compactionRecord));
         descr = GC_make_descriptor(obj_bitmap, GC_WORD_LEN(MapObject));
         typeInited = true;
     }
@@ -56,6 +59,8 @@ void MapObject::clear(ExecutionState& state)
         m_storage[i] = std::make_pair(Value(Value::EmptyValue), Value(Value::EmptyValue));
     }
     m_hashIndex = nullptr;
+    m_liveCount = 0;
+    compactIfNeeded();
 }
 
 size_t MapObject::findKeyIndex(ExecutionState& state, const Value& key, size_t* outHash)
@@ -149,16 +154,71 @@ void MapObject::addToHashIndex(size_t storageIndex, size_t hash)
     m_hashIndex.value()->insert(hash, storageIndex);
 }
 
-size_t MapObject::size(ExecutionState& state)
+void MapObject::pushEntry(const Value& key, const Value& value, size_t hash)
 {
-    size_t siz = 0;
+    m_storage.pushBack(std::make_pair(key, value));
+    m_liveCount++;
+    addToHashIndex(m_storage.size() - 1, hash);
+}
+
+void MapObject::compactIfNeeded()
+{
+    if (m_compactionBlockCount || !KeyedCollectionCompactionRecord::shouldCompact(m_storage.size(), m_liveCount)) {
+        return;
+    }
+
+    // only iterators can observe storage indexes, so the removed list is kept only when one may exist
+    uint32_t* removedIndexes = nullptr;
+    size_t removedCount = 0;
+    if (m_compactionRecord) {
+        removedIndexes = (uint32_t*)GC_MALLOC_ATOMIC(sizeof(uint32_t) * (m_storage.size() - m_liveCount));
+    }
+
+    size_t live = 0;
     for (size_t i = 0; i < m_storage.size(); i++) {
         if (m_storage[i].first.isEmpty()) {
-            continue;
+            if (removedIndexes) {
+                removedIndexes[removedCount++] = (uint32_t)i;
+            }
+        } else {
+            m_storage[live++] = m_storage[i];
         }
-        siz++;
     }
-    return siz;
+    ASSERT(live == m_liveCount);
+    m_storage.resizeWithUninitializedValues(live);
+    m_storage.shrinkToFit();
+    // rebuilt by the next lookup once the storage is large enough
+    m_hashIndex = nullptr;
+
+    if (m_compactionRecord) {
+        KeyedCollectionCompactionRecord* record = m_compactionRecord.value();
+        record->m_removedIndexes = removedIndexes;
+        record->m_removedCount = removedCount;
+        record->m_next = new KeyedCollectionCompactionRecord();
+        m_compactionRecord = record->m_next;
+    }
+}
+
+KeyedCollectionCompactionRecord* MapObject::currentCompactionRecord()
+{
+    if (!m_compactionRecord) {
+        m_compactionRecord = new KeyedCollectionCompactionRecord();
+    }
+    return m_compactionRecord.value();
+}
+
+size_t MapObject::allocatedMemorySize() const
+{
+    size_t bytes = m_storage.capacity() * sizeof(std::pair<EncodedValue, EncodedValue>);
+    if (m_hashIndex) {
+        bytes += sizeof(KeyedCollectionHashIndex) + (m_hashIndex.value()->capacity - 1) * sizeof(uint32_t);
+    }
+    return bytes;
+}
+
+size_t MapObject::size(ExecutionState& state)
+{
+    return m_liveCount;
 }
 
 bool MapObject::deleteOperation(ExecutionState& state, const Value& key)
@@ -170,6 +230,8 @@ bool MapObject::deleteOperation(ExecutionState& state, const Value& key)
     // the hash index keeps a stale bucket for i; it is skipped by comparison
     // and swept at the next rebuild
     m_storage[i] = std::make_pair(Value(Value::EmptyValue), Value(Value::EmptyValue));
+    m_liveCount--;
+    compactIfNeeded();
     return true;
 }
 
@@ -197,8 +259,7 @@ Value MapObject::getOrInsert(ExecutionState& state, Value& key, const Value& val
         return m_storage[i].second;
     }
 
-    m_storage.pushBack(std::make_pair(key, value));
-    addToHashIndex(m_storage.size() - 1, hash);
+    pushEntry(key, value, hash);
     return value;
 }
 
@@ -226,8 +287,7 @@ Value MapObject::getOrInsertComputed(ExecutionState& state, Value& key, const Va
         return value;
     }
 
-    m_storage.pushBack(std::make_pair(key, value));
-    addToHashIndex(m_storage.size() - 1, newHash);
+    pushEntry(key, value, newHash);
     return value;
 }
 
@@ -247,11 +307,10 @@ void MapObject::set(ExecutionState& state, const Value& key, const Value& value)
 
     // If key is -0, let key be +0.
     if (key.isNumber() && key.asNumber() == 0 && std::signbit(key.asNumber())) {
-        m_storage.pushBack(std::make_pair(Value(0), value));
+        pushEntry(Value(0), value, hash);
     } else {
-        m_storage.pushBack(std::make_pair(key, value));
+        pushEntry(key, value, hash);
     }
-    addToHashIndex(m_storage.size() - 1, hash);
 }
 
 IteratorObject* MapObject::values(ExecutionState& state)
@@ -272,6 +331,7 @@ IteratorObject* MapObject::entries(ExecutionState& state)
 MapIteratorObject::MapIteratorObject(ExecutionState& state, MapObject* map, Type type)
     : IteratorObject(state, state.context()->globalObject()->mapIteratorPrototype())
     , m_map(map)
+    , m_compactionRecord(map->currentCompactionRecord())
     , m_iteratorIndex(0)
     , m_type(type)
 {
@@ -285,6 +345,7 @@ void* MapIteratorObject::operator new(size_t size)
         GC_word obj_bitmap[GC_BITMAP_SIZE(MapIteratorObject)] = { 0 };
         Object::fillGCDescriptor(obj_bitmap);
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(MapIteratorObject, m_map));
+        GC_set_bit(obj_bitmap, GC_WORD_OFFSET(MapIteratorObject, m_compactionRecord));
         descr = GC_make_descriptor(obj_bitmap, GC_WORD_LEN(MapIteratorObject));
         typeInited = true;
     }
@@ -305,6 +366,10 @@ std::pair<Value, bool> MapIteratorObject::advance(ExecutionState& state)
         return std::make_pair(Value(), true);
     }
 
+    // entries removed before index by compactions since the last advance shift it down
+    m_compactionRecord = KeyedCollectionCompactionRecord::translate(m_compactionRecord, index);
+    m_iteratorIndex = index;
+
     // Let entries be the List that is the value of the [[MapData]] internal slot of m.
     // Repeat while index is less than the total number of elements of entries. The number of elements must be redetermined each time this method is evaluated.
     while (index < m->m_storage.size()) {
@@ -341,6 +406,7 @@ std::pair<Value, bool> MapIteratorObject::advance(ExecutionState& state)
 
     // Set the [[Map]] internal slot of O to undefined.
     m_map = nullptr;
+    m_compactionRecord = nullptr;
     // Return CreateIterResultObject(undefined, true).
     return std::make_pair(Value(), true);
 }
@@ -27,6 +27,7 @@ namespace Escargot {
 
 class MapIteratorObject;
 struct KeyedCollectionHashIndex;
+struct KeyedCollectionCompactionRecord;
 
 class MapObject : public DerivedObject {
     friend class MapIteratorObject;
@@ -65,15 +66,44 @@ public:
         return m_storage;
     }
 
+    // bytes held by the storage and the hash index
+    size_t allocatedMemorySize() const;
+
+    // holds off compaction while a builtin walks storage() by index across calls into script
+    class CompactionBlocker {
+    public:
+        explicit CompactionBlocker(MapObject* map)
+            : m_map(map)
+        {
+            m_map->m_compactionBlockCount++;
+        }
+
+        ~CompactionBlocker()
+        {
+            if (--m_map->m_compactionBlockCount == 0) {
+                m_map->compactIfNeeded();
+            }
+        }
+
+    private:
+        MapObject* m_map;
+    };
+
 private:
     // returns index into m_storage or SIZE_MAX; builds the hash index once the
     // storage outgrows KeyedCollectionHashIndex::buildThreshold
     size_t findKeyIndex(ExecutionState& state, const Value& key, size_t* outHash = nullptr);
     void addToHashIndex(size_t storageIndex, size_t hash = 0);
     void buildOrRebuildHashIndex();
+    void pushEntry(const Value& key, const Value& value, size_t hash);
+    void compactIfNeeded();
+    KeyedCollectionCompactionRecord* currentCompactionRecord();
 
     MapObjectData m_storage;
     Optional<KeyedCollectionHashIndex*> m_hashIndex;
+    Optional<KeyedCollectionCompactionRecord*> m_compactionRecord;
+    size_t m_liveCount;
+    size_t m_compactionBlockCount;
 };
 
 class MapIteratorObject : public IteratorObject {
@@ -98,6 +128,7 @@ public:
 
 private:
     MapObject* m_map;
+    KeyedCollectionCompactionRecord* m_compactionRecord;
     size_t m_iteratorIndex;
     Type m_type;
 };
@@ -37,6 +37,7 @@ class ArrayBufferObject;
 class ArrayBufferView;
 class DataViewObject;
 class ExecutionPauser;
+struct EphemeronValueList;
 
 #define OBJECT_PROPERTY_NAME_UINT32_VIAS 2
 #define MAXIMUM_UINT_FOR_32BIT_PROPERTY_NAME (std::numeric_limits<uint32_t>::max() >> OBJECT_PROPERTY_NAME_UINT32_VIAS)
@@ -62,6 +63,7 @@ struct ObjectExtendedExtraData : public gc {
     TightVector<std::pair<FinalizerFunction, void*>, GCUtil::gc_malloc_allocator<std::pair<FinalizerFunction, void*>>> m_finalizer;
     Optional<ObjectPrivateMemberDataChain*> m_privateMemberChain;
     Optional<FunctionObject*> m_meaningfulConstructor;
+    Optional<EphemeronValueList*> m_ephemeronValues; // values of WeakMap/WeakSet entries keyed by this object
     ObjectExtendedExtraData(void* e)
         : m_extraData(e)
         , m_removedFinalizerCount(0)
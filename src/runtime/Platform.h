@@ -36,6 +36,7 @@ public:
     virtual void* onMallocArrayBufferObjectDataBuffer(size_t sizeInByte) = 0;
     virtual void onFreeArrayBufferObjectDataBuffer(void* buffer, size_t sizeInByte, void* deleterData) = 0;
     virtual void* onReallocArrayBufferObjectDataBuffer(void* oldBuffer, size_t oldSizeInByte, size_t newSizeInByte) = 0;
+    virtual void onCommitArrayBufferObjectDataBuffer(void* buffer, size_t oldCommittedSizeInByte, size_t newCommittedSizeInByte) = 0;
 
     // Promise
     virtual void markJSJobEnqueued(Context* relatedContext) = 0;
@@ -181,11 +181,27 @@ Object* PromiseObject::catchOperation(ExecutionState& state, Value handler)
 
 Optional<Object*> PromiseObject::then(ExecutionState& state, Value onFulfilledValue, Value onRejectedValue, Optional<PromiseReaction::Capability> resultCapability)
 {
-    Object* onFulfilled = onFulfilledValue.isCallable() ? onFulfilledValue.asObject() : (Object*)(1);
-    Object* onRejected = onRejectedValue.isCallable() ? onRejectedValue.asObject() : (Object*)(2);
+    Object* onFulfilled = onFulfilledValue.isCallable() ? onFulfilledValue.asObject() : PromiseReaction::reservedHandler(PromiseReaction::Identity);
+    Object* onRejected = onRejectedValue.isCallable() ? onRejectedValue.asObject() : PromiseReaction::reservedHandler(PromiseReaction::Thrower);
 
     PromiseReaction::Capability capability = resultCapability.hasValue() ? resultCapability.value() : PromiseReaction::Capability(nullptr, nullptr, nullptr);
+    performThen(state, onFulfilled, onRejected, capability);
 
+    if (resultCapability) {
+        return capability.m_promise;
+    } else {
+        return nullptr;
+    }
+}
+
+void PromiseObject::awaitThen(ExecutionState& state, ExecutionPauser* pauser, Object* source)
+{
+    PromiseReaction::Capability capability = PromiseReaction::awaitCapability(source, pauser);
+    performThen(state, PromiseReaction::reservedHandler(PromiseReaction::AwaitFulfilled), PromiseReaction::reservedHandler(PromiseReaction::AwaitRejected), capability);
+}
+
+void PromiseObject::performThen(ExecutionState& state, Object* onFulfilled, Object* onRejected, PromiseReaction::Capability& capability)
+{
 #ifdef ESCARGOT_DEBUGGER
     if (state.context()->debuggerEnabled()) {
         capability.m_savedStackTrace = Debugger::saveStackTrace(state);
@@ -198,13 +214,11 @@ Optional<Object*> PromiseObject::then(ExecutionState& state, Value onFulfilledVa
         break;
     }
     case PromiseObject::PromiseState::FulFilled: {
-        Job* job = new PromiseReactionJob(state.context(), PromiseReaction(onFulfilled, capability), promiseResult());
-        state.context()->vmInstance()->enqueueJob(job);
+        state.context()->vmInstance()->enqueuePromiseReactionJob(state.context(), PromiseReaction(onFulfilled, capability), promiseResult());
         break;
     }
     case PromiseObject::PromiseState::Rejected: {
-        Job* job = new PromiseReactionJob(state.context(), PromiseReaction(onRejected, capability), promiseResult());
-        state.context()->vmInstance()->enqueueJob(job);
+        state.context()->vmInstance()->enqueuePromiseReactionJob(state.context(), PromiseReaction(onRejected, capability), promiseResult());
 
         if (UNLIKELY(state.context()->vmInstance()->isPromiseRejectCallbackRegistered())) {
             state.context()->vmInstance()->triggerPromiseRejectCallback(state, this, promiseResult(), VMInstance::PromiseRejectEvent::PromiseHandlerAddedAfterReject);
@@ -214,18 +228,12 @@ Optional<Object*> PromiseObject::then(ExecutionState& state, Value onFulfilledVa
     default:
         break;
     }
-
-    if (resultCapability) {
-        return capability.m_promise;
-    } else {
-        return nullptr;
-    }
 }
 
 void PromiseObject::triggerPromiseReactions(ExecutionState& state, PromiseObject::Reactions& reactions)
 {
     for (size_t i = 0; i < reactions.size(); i++) {
-        state.context()->vmInstance()->enqueueJob(new PromiseReactionJob(state.context(), reactions[i], m_promiseResult));
+        state.context()->vmInstance()->enqueuePromiseReactionJob(state.context(), reactions[i], m_promiseResult);
     }
 }
 
@@ -26,6 +26,7 @@
 namespace Escargot {
 
 class PromiseObject;
+class ExecutionPauser;
 
 struct PromiseReaction {
 public:
@@ -53,7 +54,11 @@ public:
 
         Object* m_promise;
         Object* m_resolveFunction;
-        Object* m_rejectFunction;
+        // the reserved handler of the reaction tells which one is in use
+        union {
+            Object* m_rejectFunction;
+            ExecutionPauser* m_awaitPauser;
+        };
 #ifdef ESCARGOT_DEBUGGER
         Debugger::SavedStackTraceDataVector* m_savedStackTrace;
 #endif /* ESCARGOT_DEBUGGER */
@@ -71,6 +76,49 @@ public:
     {
     }
 
+    // reserved handler values which are never an Object address
+    // await reactions resume the paused execution directly instead of calling builtin functions.
+    // their capability holds the source object in m_resolveFunction and its ExecutionPauser in m_awaitPauser
+    enum ReservedHandler : size_t {
+        Identity = 1,
+        Thrower = 2,
+        AwaitFulfilled = 3,
+        AwaitRejected = 4,
+    };
+
+    static Object* reservedHandler(ReservedHandler handler)
+    {
+        return reinterpret_cast<Object*>(handler);
+    }
+
+    bool hasReservedHandler(ReservedHandler handler) const
+    {
+        return m_handler == reservedHandler(handler);
+    }
+
+    static Capability awaitCapability(Object* source, ExecutionPauser* pauser)
+    {
+        Capability capability(nullptr, source, nullptr);
+        capability.m_awaitPauser = pauser;
+        return capability;
+    }
+
+    bool isAwaitReaction() const
+    {
+        return hasReservedHandler(AwaitFulfilled) || hasReservedHandler(AwaitRejected);
+    }
+
+    Object* awaitSource() const
+    {
+        ASSERT(isAwaitReaction());
+        return m_capability.m_resolveFunction;
+    }
+
+    ExecutionPauser* awaitPauser() const
+    {
+        ASSERT(isAwaitReaction());
+        return m_capability.m_awaitPauser;
+    }
 
     Capability m_capability;
     Object* m_handler;
@@ -134,6 +182,8 @@ public:
     // http://www.ecma-international.org/ecma-262/10.0/#sec-performpromisethen
     // You can get return value when you give resultCapability
     Optional<Object*> then(ExecutionState& state, Value onFulfilled, Value onRejected, Optional<PromiseReaction::Capability> resultCapability = Optional<PromiseReaction::Capability>());
+    // PerformPromiseThen for await. registers the paused execution as reaction without creating function objects
+    void awaitThen(ExecutionState& state, ExecutionPauser* pauser, Object* source);
 
     void* operator new(size_t size);
     void* operator new[](size_t size) = delete;
@@ -158,6 +208,8 @@ public:
     bool hasRejectHandlers() const { return m_rejectReactions.size() > 0; }
 
 protected:
+    void performThen(ExecutionState& state, Object* onFulfilled, Object* onRejected, PromiseReaction::Capability& capability);
+
     static inline void fillGCDescriptor(GC_word* desc)
     {
         Object::fillGCDescriptor(desc);
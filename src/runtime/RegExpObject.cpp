@@ -167,7 +167,7 @@ void RegExpObject::internalInit(ExecutionState& state, String* source, Option op
     m_source = source->length() ? source : defaultRegExpString;
     m_source = escapePattern(state, m_source);
 
-    auto& entry = getCacheEntryAndCompileIfNeeded(state, m_source, this->option());
+    auto entry = getCacheEntryAndCompileIfNeeded(state, m_source, this->option());
     if (entry.m_yarrError) {
         m_source = previousSource;
         setOptionValueForGC(previousOptions);
@@ -285,13 +285,29 @@ void RegExpObject::setOption(const Option& option)
     setOptionValueForGC(option);
 }
 
-RegExpObject::RegExpCacheEntry& RegExpObject::getCacheEntryAndCompileIfNeeded(ExecutionState& state, String* source, const Option& option)
+static size_t regexpCacheEntryBaseSize(String* source)
 {
+    // YarrPattern keeps terms and character classes roughly proportional to its source
+    return sizeof(JSC::Yarr::YarrPattern) + source->length() * sizeof(JSC::Yarr::PatternTerm);
+}
+
+static size_t regexpBytecodePatternSize(JSC::Yarr::BytecodePattern* bytecodePattern)
+{
+    // disjunctions of parentheses are private to BytecodePattern, so only the body is counted
+    return sizeof(JSC::Yarr::BytecodePattern) + bytecodePattern->estimatedSizeInBytes();
+}
+
+RegExpObject::RegExpCacheEntry RegExpObject::getCacheEntryAndCompileIfNeeded(ExecutionState& state, String* source, const Option& option)
+{
+    VMInstance* vmInstance = state.context()->vmInstance();
     auto cache = state.context()->regexpCache();
     auto it = cache->find(RegExpCacheKey(source, option));
     if (it != cache->end()) {
+        vmInstance->regexpCacheHitCount()++;
+        it.value().m_lastUsedTime = vmInstance->tickRegExpCacheClock();
         return it.value();
     } else {
+        vmInstance->regexpCacheMissCount()++;
         const char* yarrError = nullptr;
         JSC::Yarr::YarrPattern* yarrPattern = nullptr;
         try {
@@ -301,8 +317,25 @@ RegExpObject::RegExpCacheEntry& RegExpObject::getCacheEntryAndCompileIfNeeded(Ex
         } catch (const std::bad_alloc& e) {
             ErrorObject::throwBuiltinError(state, ErrorCode::TypeError, "got too complicated RegExp pattern to process");
         }
-        auto iter = cache->insert(std::make_pair(RegExpCacheKey(source, option), RegExpCacheEntry(yarrError, yarrPattern))).first;
-        return iter.value();
+        RegExpCacheEntry entry(yarrError, yarrPattern);
+        entry.m_compiledSize = regexpCacheEntryBaseSize(source);
+        entry.m_lastUsedTime = vmInstance->tickRegExpCacheClock();
+        cache->insert(std::make_pair(RegExpCacheKey(source, option), entry));
+        vmInstance->regexpCacheCompiledSize() += entry.m_compiledSize;
+        return entry;
+    }
+}
+
+void RegExpObject::storeBytecodePatternToCache(ExecutionState& state, String* source, const Option& option, JSC::Yarr::YarrPattern* yarrPattern, JSC::Yarr::BytecodePattern* bytecodePattern)
+{
+    auto cache = state.context()->regexpCache();
+    auto it = cache->find(RegExpCacheKey(source, option));
+    // the entry could be evicted (or even re-created from another YarrPattern) while compiling
+    if (it != cache->end() && it.value().m_yarrPattern == yarrPattern && !it.value().m_bytecodePattern) {
+        size_t size = regexpBytecodePatternSize(bytecodePattern);
+        it.value().m_bytecodePattern = bytecodePattern;
+        it.value().m_compiledSize += size;
+        state.context()->vmInstance()->regexpCacheCompiledSize() += size;
     }
 }
 
@@ -323,7 +356,7 @@ bool RegExpObject::match(ExecutionState& state, String* str, RegexMatchResult& m
     m_lastExecutedString = str;
 
     if (!m_bytecodePattern) {
-        RegExpCacheEntry& entry = getCacheEntryAndCompileIfNeeded(state, m_source, option());
+        RegExpCacheEntry entry = getCacheEntryAndCompileIfNeeded(state, m_source, option());
         if (entry.m_yarrError) {
             matchResult.m_subPatternNum = 0;
             return false;
@@ -340,7 +373,7 @@ bool RegExpObject::match(ExecutionState& state, String* str, RegexMatchResult& m
                 return false;
             }
             m_bytecodePattern = ownedBytecode.release();
-            entry.m_bytecodePattern = m_bytecodePattern;
+            storeBytecodePatternToCache(state, m_source, option(), m_yarrPattern, m_bytecodePattern);
         }
     }
 
@@ -71,9 +71,11 @@ public:
         {
         }
 
+        // compare by content so that patterns built at runtime (e.g. new RegExp(str))
+        // share an entry with an equal literal
         bool operator==(const RegExpCacheKey& otherKey) const
         {
-            return (m_body == otherKey.m_body)
+            return m_body->equals(otherKey.m_body)
                 && (m_ignoreCase == otherKey.m_ignoreCase)
                 && (m_multiline == otherKey.m_multiline)
                 && (m_dotAll == otherKey.m_dotAll)
@@ -93,12 +95,18 @@ public:
             : m_yarrError(yarrError)
             , m_yarrPattern(yarrPattern)
             , m_bytecodePattern(bytecodePattern)
+            , m_compiledSize(0)
+            , m_lastUsedTime(0)
         {
         }
 
         const char* m_yarrError;
         JSC::Yarr::YarrPattern* m_yarrPattern;
         JSC::Yarr::BytecodePattern* m_bytecodePattern;
+        // estimated bytes charged to VMInstance::regexpCacheCompiledSize() by this entry
+        size_t m_compiledSize;
+        // VMInstance::regexpCacheClock() value of the last lookup (used for LRU eviction)
+        size_t m_lastUsedTime;
     };
 
     RegExpObject(ExecutionState& state, String* source, String* option);
@@ -198,7 +206,9 @@ private:
     void setOption(const Option& option);
     void internalInit(ExecutionState& state, String* source, Option option = None);
 
-    static RegExpCacheEntry& getCacheEntryAndCompileIfNeeded(ExecutionState& state, String* source, const Option& option);
+    // returns a copy of the entry; the cache may be trimmed by GC at any allocation point
+    static RegExpCacheEntry getCacheEntryAndCompileIfNeeded(ExecutionState& state, String* source, const Option& option);
+    static void storeBytecodePatternToCache(ExecutionState& state, String* source, const Option& option, JSC::Yarr::YarrPattern* yarrPattern, JSC::Yarr::BytecodePattern* bytecodePattern);
 
     // has source, option...
     static bool hasOwnRegExpProperty(ExecutionState& state, Object* obj);
@@ -59,7 +59,9 @@ public:
     virtual Value construct(ExecutionState& state, const size_t argc, Value* argv, Object* newTarget) override;
 
     // http://www.ecma-international.org/ecma-262/10.0/#await
-    static PromiseObject* awaitOperationBeforePause(ExecutionState& state, ExecutionPauser* pauser, const Value& awaitValue, Object* source);
+    static void awaitOperationBeforePause(ExecutionState& state, ExecutionPauser* pauser, const Value& awaitValue, Object* source);
+    // runs an await reaction (see PromiseReaction::AwaitHandler)
+    static void awaitResume(ExecutionState& state, const PromiseReaction& reaction, const Value& value);
 
 private:
     EncodedValue m_thisValue;
@@ -32,6 +32,8 @@ SetObject::SetObject(ExecutionState& state)
 
 SetObject::SetObject(ExecutionState& state, Object* proto)
     : DerivedObject(state, proto)
+    , m_liveCount(0)
+    , m_compactionBlockCount(0)
 {
 }
 
@@ -39,6 +41,10 @@ SetObject::SetObject(ExecutionState& state, Object* proto, SetObjectData&& data)
     : SetObject(state, proto)
 {
     m_storage = data;
+    for (size_t i = 0; i < m_storage.size(); i++) {
+        m_liveCount += !m_storage[i].isEmpty();
+    }
+    compactIfNeeded();
 }
 
 void* SetObject::operator new(size_t size)
@@ -50,6 +56,7 @@ void* SetObject::operator new(size_t size)
         Object::fillGCDescriptor(obj_bitmap);
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(SetObject, m_storage));
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(SetObject, m_hashIndex));
+        GC_set_bit(obj_bitmap, GC_WORD_OFFSET(SetObject, m_compactionRecord));
         descr = GC_make_descriptor(obj_bitmap, GC_WORD_LEN(SetObject));
         typeInited = true;
     }
@@ -62,6 +69,8 @@ void SetObject::clear(ExecutionState& state)
         m_storage[i] = Value(Value::EmptyValue);
     }
     m_hashIndex = nullptr;
+    m_liveCount = 0;
+    compactIfNeeded();
 }
 
 size_t SetObject::findKeyIndex(ExecutionState& state, const Value& key, size_t* outHash)
@@ -164,6 +173,8 @@ bool SetObject::deleteOperation(ExecutionState& state, const Value& key)
     // the hash index keeps a stale bucket for i; it is skipped by comparison
     // and swept at the next rebuild
     m_storage[i] = Value(Value::EmptyValue);
+    m_liveCount--;
+    compactIfNeeded();
     return true;
 }
 
@@ -180,6 +191,7 @@ void SetObject::add(ExecutionState& state, const Value& key)
     } else {
         m_storage.pushBack(key);
     }
+    m_liveCount++;
     addToHashIndex(m_storage.size() - 1, hash);
 }
 
@@ -190,15 +202,62 @@ bool SetObject::has(ExecutionState& state, const Value& key)
 
 size_t SetObject::size(ExecutionState& state)
 {
-    size_t siz = 0;
+    return m_liveCount;
+}
+
+void SetObject::compactIfNeeded()
+{
+    if (m_compactionBlockCount || !KeyedCollectionCompactionRecord::shouldCompact(m_storage.size(), m_liveCount)) {
+        return;
+    }
+
+    // only iterators can observe storage indexes, so the removed list is kept only when one may exist
+    uint32_t* removedIndexes = nullptr;
+    size_t removedCount = 0;
+    if (m_compactionRecord) {
+        removedIndexes = (uint32_t*)GC_MALLOC_ATOMIC(sizeof(uint32_t) * (m_storage.size() - m_liveCount));
+    }
+
+    size_t live = 0;
     for (size_t i = 0; i < m_storage.size(); i++) {
-        Value existingKey = m_storage[i];
-        if (existingKey.isEmpty()) {
-            continue;
+        if (m_storage[i].isEmpty()) {
+            if (removedIndexes) {
+                removedIndexes[removedCount++] = (uint32_t)i;
+            }
+        } else {
+            m_storage[live++] = m_storage[i];
         }
-        siz++;
     }
-    return siz;
+    ASSERT(live == m_liveCount);
+    m_storage.resizeWithUninitializedValues(live);
+    m_storage.shrinkToFit();
+    // rebuilt by the next lookup once the storage is large enough
+    m_hashIndex = nullptr;
+
+    if (m_compactionRecord) {
+        KeyedCollectionCompactionRecord* record = m_compactionRecord.value();
+        record->m_removedIndexes = removedIndexes;
+        record->m_removedCount = removedCount;
+        record->m_next = new KeyedCollectionCompactionRecord();
+        m_compactionRecord = record->m_next;
+    }
+}
+
+KeyedCollectionCompactionRecord* SetObject::currentCompactionRecord()
+{
+    if (!m_compactionRecord) {
+        m_compactionRecord = new KeyedCollectionCompactionRecord();
+    }
+    return m_compactionRecord.value();
+}
+
+size_t SetObject::allocatedMemorySize() const
+{
+    size_t bytes = m_storage.capacity() * sizeof(EncodedValue);
+    if (m_hashIndex) {
+        bytes += sizeof(KeyedCollectionHashIndex) + (m_hashIndex.value()->capacity - 1) * sizeof(uint32_t);
+    }
+    return bytes;
 }
 
 ArrayObject* SetObject::createDenseArrayCopy(ExecutionState& state, SetObject* src)
@@ -235,6 +294,7 @@ IteratorObject* SetObject::entries(ExecutionState& state)
 SetIteratorObject::SetIteratorObject(ExecutionState& state, SetObject* set, Type type)
     : IteratorObject(state, state.context()->globalObject()->setIteratorPrototype())
     , m_set(set)
+    , m_compactionRecord(set->currentCompactionRecord())
     , m_iteratorIndex(0)
     , m_type(type)
 {
@@ -248,6 +308,7 @@ void* SetIteratorObject::operator new(size_t size)
         GC_word obj_bitmap[GC_BITMAP_SIZE(SetIteratorObject)] = { 0 };
         Object::fillGCDescriptor(obj_bitmap);
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(SetIteratorObject, m_set));
+        GC_set_bit(obj_bitmap, GC_WORD_OFFSET(SetIteratorObject, m_compactionRecord));
         descr = GC_make_descriptor(obj_bitmap, GC_WORD_LEN(SetIteratorObject));
         typeInited = true;
     }
@@ -268,6 +329,10 @@ std::pair<Value, bool> SetIteratorObject::advance(ExecutionState& state)
         return std::make_pair(Value(), true);
     }
 
+    // entries removed before index by compactions since the last advance shift it down
+    m_compactionRecord = KeyedCollectionCompactionRecord::translate(m_compactionRecord, index);
+    m_iteratorIndex = index;
+
     // Let entries be the List that is the value of the [[SetData]] internal slot of s.
     // Repeat while index is less than the total number of elements of entries. The number of elements must be redetermined each time this method is evaluated.
     while (index < s->m_storage.size()) {
@@ -297,6 +362,7 @@ std::pair<Value, bool> SetIteratorObject::advance(ExecutionState& state)
 
     // Set the [[IteratedSet]] internal slot of O to undefined.
     m_set = nullptr;
+    m_compactionRecord = nullptr;
     // Return CreateIterResultObject(undefined, true).
     return std::make_pair(Value(), true);
 }
@@ -27,6 +27,7 @@ namespace Escargot {
 
 class SetIteratorObject;
 struct KeyedCollectionHashIndex;
+struct KeyedCollectionCompactionRecord;
 
 class SetObject : public DerivedObject {
     friend class SetIteratorObject;
@@ -62,6 +63,29 @@ public:
         return m_storage;
     }
 
+    // bytes held by the storage and the hash index
+    size_t allocatedMemorySize() const;
+
+    // holds off compaction while a builtin walks storage() by index across calls into script
+    class CompactionBlocker {
+    public:
+        explicit CompactionBlocker(SetObject* set)
+            : m_set(set)
+        {
+            m_set->m_compactionBlockCount++;
+        }
+
+        ~CompactionBlocker()
+        {
+            if (--m_set->m_compactionBlockCount == 0) {
+                m_set->compactIfNeeded();
+            }
+        }
+
+    private:
+        SetObject* m_set;
+    };
+
     // bulk-copies the live (non-tombstone) elements of `src` into a fresh
     // Array, bypassing the iterator protocol entirely; only valid to call
     // when IteratorObject::tryFastSetIterationSource(src) vouches for `src`
@@ -73,9 +97,14 @@ private:
     size_t findKeyIndex(ExecutionState& state, const Value& key, size_t* outHash = nullptr);
     void addToHashIndex(size_t storageIndex, size_t hash = 0);
     void buildOrRebuildHashIndex();
+    void compactIfNeeded();
+    KeyedCollectionCompactionRecord* currentCompactionRecord();
 
     SetObjectData m_storage;
     Optional<KeyedCollectionHashIndex*> m_hashIndex;
+    Optional<KeyedCollectionCompactionRecord*> m_compactionRecord;
+    size_t m_liveCount;
+    size_t m_compactionBlockCount;
 };
 
 class SetIteratorObject : public IteratorObject {
@@ -100,6 +129,7 @@ public:
 
 private:
     SetObject* m_set;
+    KeyedCollectionCompactionRecord* m_compactionRecord;
     size_t m_iteratorIndex;
     Type m_type;
 };
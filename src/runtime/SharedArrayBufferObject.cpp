@@ -33,16 +33,7 @@ SharedArrayBufferObject::SharedArrayBufferObject(ExecutionState& state, Object*
 {
     ASSERT(byteLength < ArrayBuffer::maxArrayBufferSize);
 
-    const size_t ratio = std::max((size_t)GC_get_free_space_divisor() / 6, (size_t)1);
-    if (byteLength > (GC_get_heap_size() / ratio)) {
-        size_t n = 0;
-        size_t times = byteLength / (GC_get_heap_size() / ratio) / 3;
-        do {
-            GC_gcollect_and_unmap();
-            n += 1;
-        } while (n < times);
-        GC_invoke_finalizers();
-    }
+    collectGarbageBeforeAllocation(byteLength);
 
     updateBackingStore(BackingStore::createDefaultSharedBackingStore(byteLength));
 }
@@ -53,16 +44,7 @@ SharedArrayBufferObject::SharedArrayBufferObject(ExecutionState& state, Object*
     ASSERT(byteLength <= maxByteLength);
     ASSERT(maxByteLength < ArrayBuffer::maxArrayBufferSize);
 
-    const size_t ratio = std::max((size_t)GC_get_free_space_divisor() / 6, (size_t)1);
-    if (maxByteLength > (GC_get_heap_size() / ratio)) {
-        size_t n = 0;
-        size_t times = maxByteLength / (GC_get_heap_size() / ratio) / 3;
-        do {
-            GC_gcollect_and_unmap();
-            n += 1;
-        } while (n < times);
-        GC_invoke_finalizers();
-    }
+    collectGarbageBeforeAllocation(BackingStore::resizableAllocationSize(byteLength, maxByteLength));
 
     updateBackingStore(BackingStore::createDefaultGrowableSharedBackingStore(byteLength, maxByteLength));
 }
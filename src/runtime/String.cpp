@@ -56,6 +56,8 @@
 #include "fast-dtoa.h"
 #include "bignum-dtoa.h"
 
+#include <simdutf.h>
+
 namespace Escargot {
 std::vector<std::string> split(const std::string& s, char seperator)
 {
@@ -158,32 +160,17 @@ bool isAllSpecialCharacters(const std::string& s, bool (*fn)(char))
 
 bool isAllASCII(const char* buf, const size_t len)
 {
-    for (unsigned i = 0; i < len; i++) {
-        if ((buf[i] & 0x80) != 0) {
-            return false;
-        }
-    }
-    return true;
+    return !StringSearch::hasCharWithBits(reinterpret_cast<const LChar*>(buf), len, 0x80);
 }
 
 bool isAllASCII(const char16_t* buf, const size_t len)
 {
-    for (unsigned i = 0; i < len; i++) {
-        if (buf[i] >= 128) {
-            return false;
-        }
-    }
-    return true;
+    return !StringSearch::hasCharWithBits(buf, len, 0xFF80);
 }
 
 bool isAllLatin1(const char16_t* buf, const size_t len)
 {
-    for (unsigned i = 0; i < len; i++) {
-        if (buf[i] >= 256) {
-            return false;
-        }
-    }
-    return true;
+    return !StringSearch::hasCharWithBits(buf, len, 0xFF00);
 }
 
 bool isAllASCIIAlphanumeric(const LChar* buf, const size_t len)
@@ -290,7 +277,68 @@ char32_t readUTF8Sequence(const char*& sequence, bool& valid, int& charlen, size
     return ch - offsetsFromUTF8[length - 1];
 }
 
-UTF16StringDataNonGCStd utf8StringToUTF16StringNonGC(const char* buf, const size_t len)
+static size_t utf8ASCIIPrefixLength(const char* buf, const size_t len)
+{
+    simdutf::result r = simdutf::validate_ascii_with_errors(buf, len);
+    return r.error == simdutf::error_code::SUCCESS ? len : r.count;
+}
+
+static char16_t* prepareUTF16Output(UTF16StringData& output, size_t len)
+{
+    output.resizeWithUninitializedValues(len);
+    return output.data();
+}
+
+static char16_t* prepareUTF16Output(UTF16StringDataNonGCStd& output, size_t len)
+{
+    output.resize(len);
+    return &output[0];
+}
+
+// decodes buf when it is well-formed UTF-8 and returns false otherwise
+// ill-formed input is left to the scalar decoder, which replaces bad sequences with U+FFFD
+template <typename OutputType>
+static bool decodeWellFormedUTF8(const char* buf, const size_t len, const size_t asciiLength, OutputType& output)
+{
+    const char* rest = buf + asciiLength;
+    const size_t restLength = len - asciiLength;
+    if (!simdutf::validate_utf8(rest, restLength)) {
+        return false;
+    }
+
+    size_t restUTF16Length = simdutf::utf16_length_from_utf8(rest, restLength);
+    char16_t* dst = prepareUTF16Output(output, asciiLength + restUTF16Length);
+    size_t written = simdutf::convert_latin1_to_utf16(buf, asciiLength, dst);
+    written += simdutf::convert_valid_utf8_to_utf16(rest, restLength, dst + asciiLength);
+    ASSERT(written == asciiLength + restUTF16Length);
+    UNUSED_VARIABLE(written);
+    return true;
+}
+
+// well-formed UTF-8 fits in Latin-1 only if every lead byte is 0xC2 or 0xC3
+// returns false if buf is ill-formed or has a code point above U+00FF
+static bool decodeUTF8ToLatin1(const char* buf, const size_t len, const size_t asciiLength, Latin1StringData& output)
+{
+    ASSERT(asciiLength < len);
+    if (static_cast<unsigned char>(buf[asciiLength]) > 0xC3) {
+        return false;
+    }
+
+    const char* rest = buf + asciiLength;
+    const size_t restLength = len - asciiLength;
+    // counts every non-continuation byte, so this is an upper bound even for ill-formed input
+    size_t restLatin1Length = simdutf::latin1_length_from_utf8(rest, restLength);
+    output.resizeWithUninitializedValues(asciiLength + restLatin1Length);
+    memcpy(output.data(), buf, asciiLength);
+    size_t written = simdutf::convert_utf8_to_latin1(rest, restLength, reinterpret_cast<char*>(output.data() + asciiLength));
+    if (written == 0) {
+        return false;
+    }
+    ASSERT(written == restLatin1Length);
+    return true;
+}
+
+static UTF16StringDataNonGCStd utf8StringToUTF16StringLenient(const char* buf, const size_t len)
 {
     UTF16StringDataNonGCStd str;
     const char* source = buf;
@@ -326,12 +374,49 @@ UTF16StringDataNonGCStd utf8StringToUTF16StringNonGC(const char* buf, const size
     return str;
 }
 
+UTF16StringDataNonGCStd utf8StringToUTF16StringNonGC(const char* buf, const size_t len)
+{
+    UTF16StringDataNonGCStd str;
+    if (LIKELY(decodeWellFormedUTF8(buf, len, utf8ASCIIPrefixLength(buf, len), str))) {
+        return str;
+    }
+    return utf8StringToUTF16StringLenient(buf, len);
+}
+
 UTF16StringData utf8StringToUTF16String(const char* buf, const size_t len)
 {
-    auto str = utf8StringToUTF16StringNonGC(buf, len);
+    UTF16StringData result;
+    if (LIKELY(decodeWellFormedUTF8(buf, len, utf8ASCIIPrefixLength(buf, len), result))) {
+        return result;
+    }
+
+    auto str = utf8StringToUTF16StringLenient(buf, len);
     return UTF16StringData(str.data(), str.length());
 }
 
+size_t utf8LengthFromLatin1(const LChar* buf, const size_t len)
+{
+    return simdutf::utf8_length_from_latin1(reinterpret_cast<const char*>(buf), len);
+}
+
+size_t convertLatin1ToUTF8(const LChar* buf, const size_t len, char* out)
+{
+    return simdutf::convert_latin1_to_utf8(reinterpret_cast<const char*>(buf), len, out);
+}
+
+size_t utf8LengthFromWellFormedUTF16(const char16_t* buf, const size_t len)
+{
+    if (!simdutf::validate_utf16(buf, len)) {
+        return SIZE_MAX;
+    }
+    return simdutf::utf8_length_from_utf16(buf, len);
+}
+
+size_t convertWellFormedUTF16ToUTF8(const char16_t* buf, const size_t len, char* out)
+{
+    return simdutf::convert_valid_utf16_to_utf8(buf, len, out);
+}
+
 ASCIIStringData utf16StringToASCIIString(const char16_t* buf, const size_t len)
 {
     ASCIIStringData str;
@@ -493,14 +578,7 @@ std::pair<char16_t, char16_t> utf16EncodeCodePoint(char32_t cp)
 
 bool StringBufferAccessData::equals16Bit(const char16_t* c1, const char* c2, size_t len)
 {
-    while (len > 0) {
-        if (*c1++ != *c2++) {
-            return false;
-        }
-        len--;
-    }
-
-    return true;
+    return StringSearch::equals(c1, reinterpret_cast<const LChar*>(c2), len);
 }
 
 UTF16StringData ASCIIString::toUTF16StringData() const
@@ -508,9 +586,9 @@ UTF16StringData ASCIIString::toUTF16StringData() const
     UTF16StringData ret;
     size_t len = length();
     ret.resizeWithUninitializedValues(len);
-    for (size_t i = 0; i < len; i++) {
-        ret[i] = charAt(i);
-    }
+    size_t converted = simdutf::convert_latin1_to_utf16(reinterpret_cast<const char*>(ASCIIString::characters8()), len, ret.data());
+    ASSERT(converted == len);
+    UNUSED_VARIABLE(converted);
     return ret;
 }
 
@@ -529,44 +607,20 @@ UTF16StringData Latin1String::toUTF16StringData() const
     UTF16StringData ret;
     size_t len = length();
     ret.resizeWithUninitializedValues(len);
-    for (size_t i = 0; i < len; i++) {
-        ret[i] = charAt(i);
-    }
+    size_t converted = simdutf::convert_latin1_to_utf16(reinterpret_cast<const char*>(Latin1String::characters8()), len, ret.data());
+    ASSERT(converted == len);
+    UNUSED_VARIABLE(converted);
     return ret;
 }
 
 UTF8StringData Latin1String::toUTF8StringData() const
 {
-    UTF8StringData ret;
-    size_t len = length();
-    for (size_t i = 0; i < len; i++) {
-        uint8_t ch = m_bufferData.uncheckedCharAtFor8Bit(i); /* assume that code points above 0xff are impossible since latin-1 is 8-bit */
-        if (ch < 0x80) {
-            ret.append((char*)&ch, 1);
-        } else {
-            char buf[8];
-            auto len = utf32ToUtf8(ch, buf);
-            ret.append(buf, len);
-        }
-    }
-    return ret;
+    return bufferAccessData().toUTF8String<UTF8StringData>();
 }
 
 UTF8StringDataNonGCStd Latin1String::toNonGCUTF8StringData(int options) const
 {
-    UTF8StringDataNonGCStd ret;
-    size_t len = length();
-    for (size_t i = 0; i < len; i++) {
-        uint8_t ch = m_bufferData.uncheckedCharAtFor8Bit(i); /* assume that code points above 0xff are impossible since latin-1 is 8-bit */
-        if (ch < 0x80) {
-            ret.append((char*)&ch, 1);
-        } else {
-            char buf[8];
-            auto len = utf32ToUtf8(ch, buf);
-            ret.append(buf, len);
-        }
-    }
-    return ret;
+    return bufferAccessData().toUTF8String<UTF8StringDataNonGCStd>();
 }
 
 UTF16StringData UTF16String::toUTF16StringData() const
@@ -864,18 +918,28 @@ String* String::fromLatin1(const char16_t* src, size_t len, Optional<ExecutionSt
 
 String* String::fromUTF8(const char* src, size_t len, bool maybeASCII)
 {
-    if (maybeASCII && isAllASCII(src, len)) {
+    size_t asciiLength = maybeASCII ? utf8ASCIIPrefixLength(src, len) : 0;
+    if (asciiLength == len) {
         return String::fromASCII(src, len);
-    } else {
-        auto s = utf8StringToUTF16String(src, len);
-        return new UTF16String(std::move(s));
     }
+
+    Latin1StringData latin1;
+    if (decodeUTF8ToLatin1(src, len, asciiLength, latin1)) {
+        return new Latin1String(std::move(latin1));
+    }
+
+    UTF16StringData utf16;
+    if (LIKELY(decodeWellFormedUTF8(src, len, asciiLength, utf16))) {
+        return new UTF16String(std::move(utf16));
+    }
+    auto s = utf8StringToUTF16StringLenient(src, len);
+    return new UTF16String(s.data(), s.length());
 }
 
 #if defined(ENABLE_COMPRESSIBLE_STRING)
 String* String::fromUTF8ToCompressibleString(VMInstance* instance, const char* src, size_t len, bool maybeASCII)
 {
-    if (maybeASCII && isAllASCII(src, len)) {
+    if (maybeASCII && utf8ASCIIPrefixLength(src, len) == len) {
         return new CompressibleString(instance, src, len);
     } else {
         auto s = utf8StringToUTF16StringNonGC(src, len);
@@ -1189,113 +1253,51 @@ String* String::toWellFormed()
 
 size_t String::find(String* str, size_t pos) const
 {
-    const size_t srcStrLen = str->length();
-    const size_t size = length();
-
-    if (srcStrLen == 0)
-        return pos <= size ? pos : SIZE_MAX;
-
-    if (srcStrLen <= size) {
-        char32_t src0 = str->charAt(0);
-        const auto& data = bufferAccessData();
-        if (data.has8BitContent) {
-            for (; pos <= size - srcStrLen; ++pos) {
-                if (((const LChar*)data.buffer)[pos] == src0) {
-                    bool same = true;
-                    for (size_t k = 1; k < srcStrLen; k++) {
-                        if (((const LChar*)data.buffer)[pos + k] != str->charAt(k)) {
-                            same = false;
-                            break;
-                        }
-                    }
-                    if (same)
-                        return pos;
-                }
-            }
-        } else {
-            for (; pos <= size - srcStrLen; ++pos) {
-                if (((const char16_t*)data.buffer)[pos] == src0) {
-                    bool same = true;
-                    for (size_t k = 1; k < srcStrLen; k++) {
-                        if (((const char16_t*)data.buffer)[pos + k] != str->charAt(k)) {
-                            same = false;
-                            break;
-                        }
-                    }
-                    if (same)
-                        return pos;
-                }
-            }
+    const auto& data = bufferAccessData();
+    const auto& srcData = str->bufferAccessData();
+    const LChar* buffer8 = reinterpret_cast<const LChar*>(data.buffer);
+    const LChar* srcBuffer8 = reinterpret_cast<const LChar*>(srcData.buffer);
+
+    if (data.has8BitContent) {
+        if (srcData.has8BitContent) {
+            return StringSearch::find(buffer8, data.length, srcBuffer8, srcData.length, pos);
         }
+        return StringSearch::find(buffer8, data.length, srcData.bufferAs16Bit, srcData.length, pos);
+    } else {
+        if (srcData.has8BitContent) {
+            return StringSearch::find(data.bufferAs16Bit, data.length, srcBuffer8, srcData.length, pos);
+        }
+        return StringSearch::find(data.bufferAs16Bit, data.length, srcData.bufferAs16Bit, srcData.length, pos);
     }
-    return SIZE_MAX;
 }
 
 size_t String::find(const char* str, size_t srcStrLen, size_t pos) const
 {
-    const size_t size = length();
-
-    if (srcStrLen == 0)
-        return pos <= size ? pos : SIZE_MAX;
-
-    if (srcStrLen <= size) {
-        char32_t src0 = str[0];
-        const auto& data = bufferAccessData();
-        if (data.has8BitContent) {
-            for (; pos <= size - srcStrLen; ++pos) {
-                if (((const LChar*)data.buffer)[pos] == src0) {
-                    bool same = true;
-                    for (size_t k = 1; k < srcStrLen; k++) {
-                        if (((const LChar*)data.buffer)[pos + k] != str[k]) {
-                            same = false;
-                            break;
-                        }
-                    }
-                    if (same)
-                        return pos;
-                }
-            }
-        } else {
-            for (; pos <= size - srcStrLen; ++pos) {
-                if (((const char16_t*)data.buffer)[pos] == src0) {
-                    bool same = true;
-                    for (size_t k = 1; k < srcStrLen; k++) {
-                        if (((const char16_t*)data.buffer)[pos + k] != str[k]) {
-                            same = false;
-                            break;
-                        }
-                    }
-                    if (same)
-                        return pos;
-                }
-            }
-        }
+    const auto& data = bufferAccessData();
+    if (data.has8BitContent) {
+        return StringSearch::find(reinterpret_cast<const LChar*>(data.buffer), data.length, reinterpret_cast<const LChar*>(str), srcStrLen, pos);
     }
-    return SIZE_MAX;
+    return StringSearch::find(data.bufferAs16Bit, data.length, reinterpret_cast<const LChar*>(str), srcStrLen, pos);
 }
 
 size_t String::rfind(String* str, size_t pos)
 {
-    const size_t srcStrLen = str->length();
-    const size_t size = length();
-    if (srcStrLen == 0)
-        return pos <= size ? pos : -1;
-    if (srcStrLen <= size) {
-        if (pos > size - srcStrLen)
-            pos = size - srcStrLen;
-        do {
-            bool same = true;
-            for (size_t k = 0; k < srcStrLen; k++) {
-                if (charAt(pos + k) != str->charAt(k)) {
-                    same = false;
-                    break;
-                }
-            }
-            if (same)
-                return pos;
-        } while (pos-- > 0);
+    const auto& data = bufferAccessData();
+    const auto& srcData = str->bufferAccessData();
+    const LChar* buffer8 = reinterpret_cast<const LChar*>(data.buffer);
+    const LChar* srcBuffer8 = reinterpret_cast<const LChar*>(srcData.buffer);
+
+    if (data.has8BitContent) {
+        if (srcData.has8BitContent) {
+            return StringSearch::rfind(buffer8, data.length, srcBuffer8, srcData.length, pos);
+        }
+        return StringSearch::rfind(buffer8, data.length, srcData.bufferAs16Bit, srcData.length, pos);
+    } else {
+        if (srcData.has8BitContent) {
+            return StringSearch::rfind(data.bufferAs16Bit, data.length, srcBuffer8, srcData.length, pos);
+        }
+        return StringSearch::rfind(data.bufferAs16Bit, data.length, srcData.bufferAs16Bit, srcData.length, pos);
     }
-    return SIZE_MAX;
 }
 
 String* String::substring(size_t from, size_t to, Optional<ExecutionState*> state)
@@ -23,6 +23,7 @@
 #include "runtime/PointerValue.h"
 #include "runtime/ThreadLocal.h"
 #include "util/BasicString.h"
+#include "util/StringSearch.h"
 #include "util/Vector.h"
 #include <string>
 
@@ -81,6 +82,12 @@ bool isAllASCIIAlphanumeric(const LChar* buf, const size_t len);
 bool isIndexString(String* str);
 char32_t readUTF8Sequence(const char*& sequence, bool& valid, int& charlen, size_t remainingLength = SIZE_MAX);
 UTF16StringData utf8StringToUTF16String(const char* buf, const size_t len);
+// UTF-8 encoders backed by simdutf
+size_t utf8LengthFromLatin1(const LChar* buf, const size_t len);
+size_t convertLatin1ToUTF8(const LChar* buf, const size_t len, char* out);
+// returns SIZE_MAX if buf contains unpaired surrogates
+size_t utf8LengthFromWellFormedUTF16(const char16_t* buf, const size_t len);
+size_t convertWellFormedUTF16ToUTF8(const char16_t* buf, const size_t len, char* out);
 UTF8StringData utf16StringToUTF8String(const char16_t* buf, const size_t len);
 ASCIIStringData utf16StringToASCIIString(const char16_t* buf, const size_t len);
 ASCIIStringDataNonGCStd dtoa(double number);
@@ -115,6 +122,18 @@ public:
     };
 };
 
+inline char* prepareUTF8Output(UTF8StringData& output, size_t len)
+{
+    output.resizeWithUninitializedValues(len);
+    return output.data();
+}
+
+inline char* prepareUTF8Output(UTF8StringDataNonGCStd& output, size_t len)
+{
+    output.resize(len);
+    return &output[0];
+}
+
 struct StringBufferAccessData {
     // should be allocated on the stack
     MAKE_STACK_ALLOCATED();
@@ -207,12 +226,47 @@ struct StringBufferAccessData {
     template <typename OutputType, typename ComputingType>
     OutputType toUTF8String() const
     {
-        ComputingType s = toUTF8String<ComputingType>();
+        OutputType ret;
+        if (LIKELY(toUTF8StringFast(ret))) {
+            return ret;
+        }
+        ComputingType s = toUTF8StringSlow<ComputingType>();
         return OutputType(s.data(), s.length());
     }
 
     template <typename OutputType>
     OutputType toUTF8String(int options = StringWriteOption::NoOptions) const
+    {
+        OutputType ret;
+        if (LIKELY(toUTF8StringFast(ret))) {
+            return ret;
+        }
+        return toUTF8StringSlow<OutputType>(options);
+    }
+
+private:
+    // encodes the whole buffer in one go
+    // fails only for 16-bit content with unpaired surrogates, which toUTF8StringSlow handles
+    template <typename OutputType>
+    bool toUTF8StringFast(OutputType& ret) const
+    {
+        if (has8BitContent) {
+            const LChar* src = reinterpret_cast<const LChar*>(bufferAs8Bit);
+            size_t utf8Length = utf8LengthFromLatin1(src, length);
+            convertLatin1ToUTF8(src, length, prepareUTF8Output(ret, utf8Length));
+            return true;
+        }
+
+        size_t utf8Length = utf8LengthFromWellFormedUTF16(bufferAs16Bit, length);
+        if (UNLIKELY(utf8Length == SIZE_MAX)) {
+            return false;
+        }
+        convertWellFormedUTF16ToUTF8(bufferAs16Bit, length, prepareUTF8Output(ret, utf8Length));
+        return true;
+    }
+
+    template <typename OutputType>
+    OutputType toUTF8StringSlow(int options = StringWriteOption::NoOptions) const
     {
         OutputType ret;
         const bool replaceInvalidUtf8 = options == StringWriteOption::ReplaceInvalidUtf8;
@@ -669,12 +723,7 @@ protected:
 
     static ALWAYS_INLINE bool stringEqual(const char16_t* s, const LChar* s1, const size_t len)
     {
-        for (size_t i = 0; i < len; i++) {
-            if (s[i] != s1[i]) {
-                return false;
-            }
-        }
-        return true;
+        return StringSearch::equals(s, s1, len);
     }
 };
 
@@ -892,6 +941,18 @@ public:
         initBufferAccessData(data);
     }
 
+    enum FromGCBuffer {
+        FromGCBufferTag
+    };
+    // takes a GC_MALLOC_ATOMIC'd buffer holding len + 1 characters (null-terminated)
+    Latin1String(LChar* str, size_t len, FromGCBuffer)
+        : String()
+    {
+        m_bufferData.has8BitContent = true;
+        m_bufferData.length = len;
+        m_bufferData.buffer = str;
+    }
+
     void initBufferAccessData(Latin1StringData& stringData)
     {
         m_bufferData.has8BitContent = true;
@@ -1018,6 +1079,18 @@ public:
         initBufferAccessData(data);
     }
 
+    enum FromGCBuffer {
+        FromGCBufferTag
+    };
+    // takes a GC_MALLOC_ATOMIC'd buffer holding len + 1 characters (null-terminated)
+    UTF16String(char16_t* str, size_t len, FromGCBuffer)
+        : String()
+    {
+        m_bufferData.has8BitContent = false;
+        m_bufferData.length = len;
+        m_bufferData.buffer = str;
+    }
+
     void initBufferAccessData(UTF16StringData& stringData)
     {
         m_bufferData.has8BitContent = false;
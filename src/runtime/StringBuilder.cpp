@@ -188,6 +188,165 @@ static void processPiece(char16_t* buffer, const StringBuilderBase::StringBuilde
 }
 
 
+template <typename CharType>
+static CharType* allocateContiguousBuffer(size_t capacity)
+{
+    // one extra character for the null terminator written at finalize
+    return static_cast<CharType*>(GC_MALLOC_ATOMIC((capacity + 1) * sizeof(CharType)));
+}
+
+template <typename CharType>
+static CharType* trimContiguousBuffer(CharType* buffer, size_t length, size_t capacity)
+{
+    ASSERT(length <= capacity);
+    if (capacity - length <= length / 4) {
+        return buffer;
+    }
+    CharType* trimmed = allocateContiguousBuffer<CharType>(length);
+    memcpy(trimmed, buffer, length * sizeof(CharType));
+    // nothing else can refer to the old buffer
+    GC_FREE(buffer);
+    return trimmed;
+}
+
+void StringBuilderBase::switchToContiguousBuffer(StringBuilderPiece* piecesInlineStorage)
+{
+    ASSERT(!m_contiguousBuffer);
+    size_t capacity = m_contentLength * 2;
+    const char* numberScratch = m_numberScratch ? m_numberScratch.value()->data() : nullptr;
+    size_t currentLength = 0;
+    if (m_has8BitContent) {
+        LChar* buffer = allocateContiguousBuffer<LChar>(capacity);
+        for (size_t i = 0; i < m_piecesInlineStorageUsage; i++) {
+            processPiece(buffer, piecesInlineStorage[i], currentLength, numberScratch);
+        }
+        for (size_t i = 0; i < m_pieces.size(); i++) {
+            processPiece(buffer, m_pieces[i], currentLength, numberScratch);
+        }
+        m_contiguousBuffer = buffer;
+    } else {
+        char16_t* buffer = allocateContiguousBuffer<char16_t>(capacity);
+        for (size_t i = 0; i < m_piecesInlineStorageUsage; i++) {
+            processPiece(buffer, piecesInlineStorage[i], currentLength, numberScratch);
+        }
+        for (size_t i = 0; i < m_pieces.size(); i++) {
+            processPiece(buffer, m_pieces[i], currentLength, numberScratch);
+        }
+        m_contiguousBuffer = buffer;
+    }
+    ASSERT(currentLength == m_contentLength);
+    m_contiguousBufferCapacity = capacity;
+
+    // pieces are not needed anymore
+    m_piecesInlineStorageUsage = 0;
+    std::vector<StringBuilderPiece>().swap(m_pieces);
+    m_rootedStringSet.reset();
+    m_numberScratch.reset();
+}
+
+void StringBuilderBase::ensureContiguousBufferCapacity(size_t extraLength, bool needs16Bit)
+{
+    ASSERT(m_contiguousBuffer);
+    const size_t requiredCapacity = m_contentLength + extraLength;
+    const bool shouldWiden = needs16Bit && m_has8BitContent;
+    if (LIKELY(requiredCapacity <= m_contiguousBufferCapacity && !shouldWiden)) {
+        return;
+    }
+
+    size_t newCapacity = m_contiguousBufferCapacity;
+    while (newCapacity < requiredCapacity) {
+        newCapacity *= 2;
+    }
+
+    void* newBuffer;
+    if (shouldWiden) {
+        char16_t* dst = allocateContiguousBuffer<char16_t>(newCapacity);
+        const LChar* src = static_cast<const LChar*>(m_contiguousBuffer);
+        for (size_t i = 0; i < m_contentLength; i++) {
+            dst[i] = src[i];
+        }
+        m_has8BitContent = false;
+        newBuffer = dst;
+    } else if (m_has8BitContent) {
+        newBuffer = allocateContiguousBuffer<LChar>(newCapacity);
+        memcpy(newBuffer, m_contiguousBuffer, m_contentLength);
+    } else {
+        newBuffer = allocateContiguousBuffer<char16_t>(newCapacity);
+        memcpy(newBuffer, m_contiguousBuffer, m_contentLength * sizeof(char16_t));
+    }
+
+    // nothing else can refer to the old buffer
+    GC_FREE(m_contiguousBuffer);
+    m_contiguousBuffer = newBuffer;
+    m_contiguousBufferCapacity = newCapacity;
+}
+
+void StringBuilderBase::appendToContiguousBuffer(String* str, size_t s, size_t e)
+{
+    const size_t len = e - s;
+    auto data = str->bufferAccessData();
+    if (data.has8BitContent) {
+        ensureContiguousBufferCapacity(len, false);
+        const LChar* src = reinterpret_cast<const LChar*>(data.bufferAs8Bit) + s;
+        if (m_has8BitContent) {
+            memcpy(static_cast<LChar*>(m_contiguousBuffer) + m_contentLength, src, len);
+        } else {
+            char16_t* dst = static_cast<char16_t*>(m_contiguousBuffer) + m_contentLength;
+            for (size_t i = 0; i < len; i++) {
+                dst[i] = src[i];
+            }
+        }
+    } else {
+        const char16_t* src = data.bufferAs16Bit + s;
+        ensureContiguousBufferCapacity(len, m_has8BitContent && StringSearch::hasCharWithBits(src, len, 0xFF00));
+        if (m_has8BitContent) {
+            LChar* dst = static_cast<LChar*>(m_contiguousBuffer) + m_contentLength;
+            for (size_t i = 0; i < len; i++) {
+                dst[i] = static_cast<LChar>(src[i]);
+            }
+        } else {
+            memcpy(static_cast<char16_t*>(m_contiguousBuffer) + m_contentLength, src, len * sizeof(char16_t));
+        }
+    }
+    m_contentLength += len;
+}
+
+void StringBuilderBase::appendToContiguousBuffer(const char* str, size_t len)
+{
+    ensureContiguousBufferCapacity(len, false);
+    if (m_has8BitContent) {
+        memcpy(static_cast<LChar*>(m_contiguousBuffer) + m_contentLength, str, len);
+    } else {
+        char16_t* dst = static_cast<char16_t*>(m_contiguousBuffer) + m_contentLength;
+        for (size_t i = 0; i < len; i++) {
+            dst[i] = static_cast<LChar>(str[i]);
+        }
+    }
+    m_contentLength += len;
+}
+
+void StringBuilderBase::appendToContiguousBuffer(char16_t ch)
+{
+    ensureContiguousBufferCapacity(1, ch > 255);
+    if (m_has8BitContent) {
+        static_cast<LChar*>(m_contiguousBuffer)[m_contentLength] = static_cast<LChar>(ch);
+    } else {
+        static_cast<char16_t*>(m_contiguousBuffer)[m_contentLength] = ch;
+    }
+    m_contentLength += 1;
+}
+
+void StringBuilderBase::appendInt32ToContiguousBuffer(int32_t value, uint8_t digitLength)
+{
+    ensureContiguousBufferCapacity(digitLength, false);
+    if (m_has8BitContent) {
+        writeInt32Digits(static_cast<LChar*>(m_contiguousBuffer), m_contentLength, digitLength, value);
+    } else {
+        writeInt32Digits(static_cast<char16_t*>(m_contiguousBuffer), m_contentLength, digitLength, value);
+    }
+    m_contentLength += digitLength;
+}
+
 String* StringBuilderBase::finalizeBase(StringBuilderPiece* piecesInlineStorage, Optional<ExecutionState*> state)
 {
     if (!m_contentLength) {
@@ -199,6 +358,24 @@ String* StringBuilderBase::finalizeBase(StringBuilderPiece* piecesInlineStorage,
         throwStringLengthInvalidError(*state.value());
     }
 
+    if (m_contiguousBuffer) {
+        // hand the buffer over to the result
+        // the result lives as long as the string does, so copy it to an exact-size buffer
+        // when more than a quarter of it would be wasted
+        String* result;
+        if (m_has8BitContent) {
+            LChar* buffer = trimContiguousBuffer(static_cast<LChar*>(m_contiguousBuffer), m_contentLength, m_contiguousBufferCapacity);
+            buffer[m_contentLength] = 0;
+            result = new Latin1String(buffer, m_contentLength, Latin1String::FromGCBufferTag);
+        } else {
+            char16_t* buffer = trimContiguousBuffer(static_cast<char16_t*>(m_contiguousBuffer), m_contentLength, m_contiguousBufferCapacity);
+            buffer[m_contentLength] = 0;
+            result = new UTF16String(buffer, m_contentLength, UTF16String::FromGCBufferTag);
+        }
+        clear();
+        return result;
+    }
+
     const char* numberScratch = m_numberScratch ? m_numberScratch.value()->data() : nullptr;
     if (m_has8BitContent) {
         Latin1StringData ret;
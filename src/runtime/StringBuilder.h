@@ -32,11 +32,24 @@ class StringBuilderBase {
     MAKE_STACK_ALLOCATED();
 
 public:
-    StringBuilderBase()
+    enum Mode {
+        // remember appended pieces and copy them into the result once at finalize
+        PiecesMode,
+        // same as PiecesMode until the content exceeds STRING_BUILDER_CONTIGUOUS_BUFFER_THRESHOLD,
+        // then flatten the pieces into one buffer that grows geometrically and append into it directly.
+        // the buffer is 8-bit and widened to 16-bit on demand
+        // use this for results that can get very large (join, JSON.stringify...)
+        ContiguousBufferMode,
+    };
+
+    explicit StringBuilderBase(Mode mode = PiecesMode)
     {
         m_has8BitContent = true;
+        m_mode = mode;
         m_contentLength = 0;
         m_piecesInlineStorageUsage = 0;
+        m_contiguousBuffer = nullptr;
+        m_contiguousBufferCapacity = 0;
     }
 
     void clear()
@@ -47,6 +60,8 @@ public:
         m_pieces.clear();
         m_rootedStringSet.reset();
         m_numberScratch.reset();
+        m_contiguousBuffer = nullptr;
+        m_contiguousBufferCapacity = 0;
     }
 
     struct StringBuilderPiece {
@@ -105,7 +120,27 @@ protected:
 
     String* finalizeBase(StringBuilderPiece* piecesInlineStorage, Optional<ExecutionState*> state);
 
+    bool usesContiguousBuffer() const
+    {
+        return !!m_contiguousBuffer;
+    }
+
+    void switchToContiguousBufferIfNeeded(StringBuilderPiece* piecesInlineStorage)
+    {
+        if (UNLIKELY(m_mode == ContiguousBufferMode && m_contentLength > STRING_BUILDER_CONTIGUOUS_BUFFER_THRESHOLD)) {
+            switchToContiguousBuffer(piecesInlineStorage);
+        }
+    }
+
+    void switchToContiguousBuffer(StringBuilderPiece* piecesInlineStorage);
+    void ensureContiguousBufferCapacity(size_t extraLength, bool needs16Bit);
+    void appendToContiguousBuffer(String* str, size_t s, size_t e);
+    void appendToContiguousBuffer(const char* str, size_t len);
+    void appendToContiguousBuffer(char16_t ch);
+    void appendInt32ToContiguousBuffer(int32_t value, uint8_t digitLength);
+
     bool m_has8BitContent : 1;
+    Mode m_mode : 2;
     size_t m_piecesInlineStorageUsage;
     size_t m_contentLength;
     std::vector<StringBuilderPiece> m_pieces;
@@ -115,6 +150,11 @@ protected:
     // so (like m_rootedStringSet) it costs nothing beyond one pointer's worth of
     // space until the first non-integer appendNumber() call actually allocates it
     Optional<std::vector<char>*> m_numberScratch;
+    // GC_MALLOC_ATOMIC'd buffer of ContiguousBufferMode, holding m_contentLength characters
+    // (LChar while m_has8BitContent, char16_t otherwise). nullptr while collecting pieces
+    // it is only referenced from this stack-allocated builder, so conservative stack scanning keeps it alive
+    void* m_contiguousBuffer;
+    size_t m_contiguousBufferCapacity;
 };
 
 // number of decimal digits int32Digits() will write, including a leading '-'
@@ -158,6 +198,10 @@ class StringBuilderImpl : public StringBuilderBase {
             appendPiece(str->charAt(s), state);
         } else if (pieceLen > 0) {
             checkStringLengthLimit(state, pieceLen);
+            if (UNLIKELY(usesContiguousBuffer())) {
+                appendToContiguousBuffer(str, s, e);
+                return;
+            }
             StringBuilderPiece& piece = nextPieceSlot();
             piece.m_string = str;
             if (m_piecesInlineStorageUsage >= InlineStorageSize) {
@@ -198,12 +242,17 @@ class StringBuilderImpl : public StringBuilderBase {
             } else {
                 piece.m_type = StringBuilderPiece::Type::Latin1StringPiece;
             }
+            switchToContiguousBufferIfNeeded(m_piecesInlineStorage);
         }
     }
 
     void appendPiece(const char* str, size_t len, Optional<ExecutionState*> state = nullptr)
     {
         checkStringLengthLimit(state, len);
+        if (UNLIKELY(usesContiguousBuffer())) {
+            appendToContiguousBuffer(str, len);
+            return;
+        }
 
         uint16_t length = static_cast<uint16_t>(len);
         if (length) {
@@ -214,12 +263,17 @@ class StringBuilderImpl : public StringBuilderBase {
             piece.m_length = length;
             piece.m_raw = str;
             piece.m_type = StringBuilderPiece::Type::ConstChar;
+            switchToContiguousBufferIfNeeded(m_piecesInlineStorage);
         }
     }
 
     void appendPiece(char16_t ch, Optional<ExecutionState*> state = nullptr)
     {
         checkStringLengthLimit(state, 1);
+        if (UNLIKELY(usesContiguousBuffer())) {
+            appendToContiguousBuffer(ch);
+            return;
+        }
 
         if (ch > 255) {
             m_has8BitContent = false;
@@ -231,6 +285,7 @@ class StringBuilderImpl : public StringBuilderBase {
         piece.m_length = 1;
         piece.m_ch = ch;
         piece.m_type = StringBuilderPiece::Type::Char;
+        switchToContiguousBufferIfNeeded(m_piecesInlineStorage);
     }
 
     // no allocation, no dtoa - just remember the int32 and its digit count now,
@@ -240,6 +295,10 @@ class StringBuilderImpl : public StringBuilderBase {
     {
         uint8_t len = decimalDigitLengthOf(value);
         checkStringLengthLimit(state, len);
+        if (UNLIKELY(usesContiguousBuffer())) {
+            appendInt32ToContiguousBuffer(value, len);
+            return;
+        }
 
         m_contentLength += len;
         StringBuilderPiece& piece = nextPieceSlot();
@@ -247,6 +306,7 @@ class StringBuilderImpl : public StringBuilderBase {
         piece.m_length = len;
         piece.m_int32Value = value;
         piece.m_type = StringBuilderPiece::Type::Int32Digits;
+        switchToContiguousBufferIfNeeded(m_piecesInlineStorage);
     }
 
     // named differently from the appendPiece() overload set on purpose: a plain
@@ -259,6 +319,10 @@ class StringBuilderImpl : public StringBuilderBase {
     {
         ASCIIStringDataNonGCStd digits = dtoa(d);
         checkStringLengthLimit(state, digits.length());
+        if (UNLIKELY(usesContiguousBuffer())) {
+            appendToContiguousBuffer(digits.data(), digits.length());
+            return;
+        }
 
         if (!m_numberScratch) {
             m_numberScratch = new (GC) std::vector<char>;
@@ -273,11 +337,12 @@ class StringBuilderImpl : public StringBuilderBase {
         piece.m_length = length;
         piece.m_digitsOffset = offset;
         piece.m_type = StringBuilderPiece::Type::Digits;
+        switchToContiguousBufferIfNeeded(m_piecesInlineStorage);
     }
 
 public:
-    StringBuilderImpl()
-        : StringBuilderBase()
+    explicit StringBuilderImpl(Mode mode = PiecesMode)
+        : StringBuilderBase(mode)
     {
     }
 
@@ -27,6 +27,7 @@
 namespace Escargot {
 
 class VMInstance;
+struct EphemeronValueList;
 
 struct SymbolFinalizerData : public gc {
     SymbolFinalizerData()
@@ -44,6 +45,7 @@ public:
         : m_typeTag(POINTER_VALUE_SYMBOL_TAG_IN_DATA)
         , m_description(desc)
         , m_finalizerData()
+        , m_ephemeronValues()
     {
     }
 
@@ -63,6 +65,16 @@ public:
 
     String* symbolDescriptiveString() const;
 
+    Optional<EphemeronValueList*> ephemeronValues() const
+    {
+        return m_ephemeronValues;
+    }
+
+    void setEphemeronValues(EphemeronValueList* values)
+    {
+        m_ephemeronValues = values;
+    }
+
     static Symbol* fromGlobalSymbolRegistry(VMInstance* vm, String* stringKey);
     static Value keyForSymbol(VMInstance* vm, Symbol* sym);
 
@@ -76,6 +88,7 @@ private:
     size_t m_typeTag;
     Optional<String*> m_description; // nullptr of desc represents `undefined`
     Optional<SymbolFinalizerData*> m_finalizerData; // handle finalizer data of Symbol
+    Optional<EphemeronValueList*> m_ephemeronValues; // values of WeakMap/WeakSet entries keyed by this symbol
 };
 } // namespace Escargot
 
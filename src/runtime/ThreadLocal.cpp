@@ -21,6 +21,7 @@
 #include "runtime/ThreadLocal.h"
 #include "heap/Heap.h"
 #include "runtime/Global.h"
+#include "runtime/EphemeronTable.h"
 #include "runtime/Platform.h"
 #include "runtime/String.h"
 #include "runtime/Value.h"
@@ -91,8 +92,10 @@ MAY_THREAD_LOCAL bf_context_t ThreadLocal::g_bfContext;
 MAY_THREAD_LOCAL WASMContext ThreadLocal::g_wasmContext;
 #endif
 MAY_THREAD_LOCAL GCEventListenerSet* ThreadLocal::g_gcEventListenerSet;
+MAY_THREAD_LOCAL std::vector<EphemeronTable*>* ThreadLocal::g_ephemeronTables;
 MAY_THREAD_LOCAL ASTAllocator* ThreadLocal::g_astAllocator;
 MAY_THREAD_LOCAL WTF::BumpPointerAllocator* ThreadLocal::g_bumpPointerAllocator;
+MAY_THREAD_LOCAL size_t ThreadLocal::g_externalStringSize;
 #if defined(ENABLE_TCO)
 MAY_THREAD_LOCAL Value* ThreadLocal::g_tcoBuffer;
 #endif
@@ -222,6 +225,8 @@ static void genericGCEventListener(GC_EventType evtType)
         listeners = list.markStartListeners();
         break;
     case GC_EVENT_MARK_END:
+        // mark bits are final here and nothing is reclaimed yet
+        EphemeronTable::sweep(ThreadLocal::ephemeronTables());
         listeners = list.markEndListeners();
         break;
     case GC_EVENT_RECLAIM_START:
@@ -415,12 +420,18 @@ void ThreadLocal::initialize(uint32_t optionFromGlobal)
         GC_set_start_callback(genericGCFullGCStartCallback);
     }
 
+    // g_ephemeronTables
+    g_ephemeronTables = new std::vector<EphemeronTable*>();
+
     // g_astAllocator
     g_astAllocator = new ASTAllocator();
 
     // g_bumpPointerAllocator
     g_bumpPointerAllocator = new WTF::BumpPointerAllocator();
 
+    // g_externalStringSize
+    g_externalStringSize = 0;
+
 #if defined(ENABLE_TCO)
     // g_tcoBuffer
     g_tcoBuffer = reinterpret_cast<Value*>(GC_MALLOC_UNCOLLECTABLE(sizeof(Value) * TCO_ARGUMENT_COUNT_LIMIT));
@@ -455,6 +466,10 @@ void ThreadLocal::finalize()
     // because g_customData might contain GC-object
     Heap::finalize();
 
+    // g_externalStringSize
+    // every external string has been finalized by Heap::finalize
+    g_externalStringSize = 0;
+
     // g_randEngine does not need finalization
     delete g_randEngine;
     g_randEngine = nullptr;
@@ -471,6 +486,11 @@ void ThreadLocal::finalize()
     g_wasmContext.lastGCCheckTime = 0;
 #endif
 
+    // g_ephemeronTables
+    // tables still alive after Heap::finalize are never swept again
+    delete g_ephemeronTables;
+    g_ephemeronTables = nullptr;
+
     // g_gcEventListenerSet
     delete g_gcEventListenerSet;
     g_gcEventListenerSet = nullptr;
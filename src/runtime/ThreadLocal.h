@@ -37,6 +37,7 @@ struct WASMContext {
 namespace Escargot {
 
 class ASTAllocator;
+class EphemeronTable;
 class String;
 class Value;
 
@@ -139,8 +140,11 @@ class ThreadLocal {
     static MAY_THREAD_LOCAL WASMContext g_wasmContext;
 #endif
     static MAY_THREAD_LOCAL GCEventListenerSet* g_gcEventListenerSet;
+    static MAY_THREAD_LOCAL std::vector<EphemeronTable*>* g_ephemeronTables;
     static MAY_THREAD_LOCAL ASTAllocator* g_astAllocator;
     static MAY_THREAD_LOCAL WTF::BumpPointerAllocator* g_bumpPointerAllocator;
+    // host memory held by live external strings, which belong to the GC heap of this thread
+    static MAY_THREAD_LOCAL size_t g_externalStringSize;
 #if defined(ENABLE_TCO)
     static MAY_THREAD_LOCAL Value* g_tcoBuffer;
 #endif
@@ -298,6 +302,13 @@ public:
         return *g_gcEventListenerSet;
     }
 
+    // every live WeakMap/WeakSet table of this thread; swept at GC_EVENT_MARK_END
+    static std::vector<EphemeronTable*>& ephemeronTables()
+    {
+        ASSERT(inited && !!g_ephemeronTables);
+        return *g_ephemeronTables;
+    }
+
     static ASTAllocator* astAllocator()
     {
         ASSERT(inited && !!g_astAllocator);
@@ -310,6 +321,24 @@ public:
         return g_bumpPointerAllocator;
     }
 
+    static size_t externalStringSize()
+    {
+        ASSERT(inited);
+        return g_externalStringSize;
+    }
+
+    static void addExternalStringSize(size_t size)
+    {
+        ASSERT(inited);
+        g_externalStringSize += size;
+    }
+
+    static void removeExternalStringSize(size_t size)
+    {
+        ASSERT(inited && g_externalStringSize >= size);
+        g_externalStringSize -= size;
+    }
+
 #if defined(ENABLE_TCO)
     static Value* tcoBuffer()
     {
@@ -183,6 +183,621 @@ void TypedArrayObject::toSorted(ExecutionState& state, Object* target, uint64_t
     }
 }
 
+#if defined(ENABLE_THREADING)
+class RadixSortBarrier {
+public:
+    explicit RadixSortBarrier(size_t count)
+        : m_count(count)
+        , m_waiting(0)
+        , m_generation(0)
+    {
+    }
+
+    void wait()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        size_t generation = m_generation;
+        if (++m_waiting == m_count) {
+            m_waiting = 0;
+            m_generation++;
+            m_condition.notify_all();
+            return;
+        }
+        m_condition.wait(lock, [&]() {
+            return generation != m_generation;
+        });
+    }
+
+private:
+    size_t m_count;
+    size_t m_waiting;
+    size_t m_generation;
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+};
+#endif
+
+// stable LSD radix sort by bytes. large inputs are partitioned once and
+// every task counts and scatters its own chunk through all the passes
+template <typename UnsignedType>
+static void radixSort(UnsignedType* data, UnsignedType* scratch, size_t length)
+{
+    size_t taskCount = 1;
+#if defined(ENABLE_THREADING)
+    if (TYPEDARRAY_PARALLEL_SORT_THREAD_MAX > 1 && length >= TYPEDARRAY_PARALLEL_SORT_THRESHOLD) {
+        taskCount = std::max(std::min(static_cast<size_t>(std::thread::hardware_concurrency()), static_cast<size_t>(TYPEDARRAY_PARALLEL_SORT_THREAD_MAX)), static_cast<size_t>(1));
+    }
+    RadixSortBarrier barrier(taskCount);
+#endif
+    const size_t chunkSize = (length + taskCount - 1) / taskCount;
+    const size_t passCount = sizeof(UnsignedType);
+    std::vector<size_t> histogram(taskCount * 256);
+    bool skipPass[passCount];
+    UnsignedType* result = data;
+
+    auto sortTask = [&](size_t task) {
+        UnsignedType* from = data;
+        UnsignedType* to = scratch;
+        const size_t begin = std::min(length, task * chunkSize);
+        const size_t end = std::min(length, (task + 1) * chunkSize);
+        size_t* taskHistogram = &histogram[task * 256];
+
+        for (size_t pass = 0; pass < passCount; pass++) {
+            const size_t shift = pass * 8;
+            std::fill(taskHistogram, taskHistogram + 256, 0);
+            for (size_t i = begin; i < end; i++) {
+                taskHistogram[(from[i] >> shift) & 0xff]++;
+            }
+#if defined(ENABLE_THREADING)
+            barrier.wait();
+#endif
+            if (task == 0) {
+                // skip the pass when every key has the same digit
+                size_t firstDigit = (from[0] >> shift) & 0xff;
+                size_t sameDigitCount = 0;
+                for (size_t t = 0; t < taskCount; t++) {
+                    sameDigitCount += histogram[t * 256 + firstDigit];
+                }
+                skipPass[pass] = sameDigitCount == length;
+
+                size_t offset = 0;
+                for (size_t digit = 0; digit < 256; digit++) {
+                    for (size_t t = 0; t < taskCount; t++) {
+                        size_t count = histogram[t * 256 + digit];
+                        histogram[t * 256 + digit] = offset;
+                        offset += count;
+                    }
+                }
+            }
+#if defined(ENABLE_THREADING)
+            barrier.wait();
+#endif
+            if (skipPass[pass]) {
+                continue;
+            }
+
+            for (size_t i = begin; i < end; i++) {
+                to[taskHistogram[(from[i] >> shift) & 0xff]++] = from[i];
+            }
+#if defined(ENABLE_THREADING)
+            // the next pass reads what every task has scattered
+            barrier.wait();
+#endif
+            std::swap(from, to);
+        }
+
+        if (task == 0) {
+            result = from;
+        }
+    };
+
+#if defined(ENABLE_THREADING)
+    std::vector<std::thread> workers;
+    workers.reserve(taskCount - 1);
+    for (size_t i = 1; i < taskCount; i++) {
+        workers.emplace_back(sortTask, i);
+    }
+    sortTask(0);
+    for (auto& w : workers) {
+        w.join();
+    }
+#else
+    sortTask(0);
+#endif
+
+    if (result != data) {
+        memcpy(data, result, sizeof(UnsignedType) * length);
+    }
+}
+
+// flipping the sign bit maps two's complement order onto unsigned order
+template <typename UnsignedType>
+struct IntegerSortKey {
+    explicit IntegerSortKey(bool isSigned)
+        : m_flip(isSigned ? static_cast<UnsignedType>(static_cast<UnsignedType>(1) << (sizeof(UnsignedType) * 8 - 1)) : 0)
+    {
+    }
+
+    UnsignedType toKey(UnsignedType bits) const
+    {
+        return bits ^ m_flip;
+    }
+
+    UnsignedType fromKey(UnsignedType key) const
+    {
+        return key ^ m_flip;
+    }
+
+    UnsignedType m_flip;
+};
+
+// IEEE bits become order preserving keys once negative values are inverted and positive ones get the sign bit.
+// every NaN is canonicalized to the positive quiet NaN which keys above +Infinity
+template <typename UnsignedType>
+struct FloatSortKey {
+    FloatSortKey(UnsignedType exponentMask, UnsignedType quietNaN)
+        : m_exponentMask(exponentMask)
+        , m_quietNaN(quietNaN)
+    {
+    }
+
+    static const UnsignedType signBit = static_cast<UnsignedType>(static_cast<UnsignedType>(1) << (sizeof(UnsignedType) * 8 - 1));
+
+    UnsignedType toKey(UnsignedType bits) const
+    {
+        if ((bits & ~signBit) > m_exponentMask) {
+            bits = m_quietNaN;
+        }
+        return (bits & signBit) ? static_cast<UnsignedType>(~bits) : static_cast<UnsignedType>(bits | signBit);
+    }
+
+    UnsignedType fromKey(UnsignedType key) const
+    {
+        return (key & signBit) ? static_cast<UnsignedType>(key ^ signBit) : static_cast<UnsignedType>(~key);
+    }
+
+    UnsignedType m_exponentMask;
+    UnsignedType m_quietNaN;
+};
+
+template <typename UnsignedType, typename SortKey>
+static void sortByKey(void* buffer, size_t length, bool isShared, const SortKey& sortKey)
+{
+    UnsignedType* data = reinterpret_cast<UnsignedType*>(buffer);
+
+    // keys live in a private area when the buffer is shared, so other agents never observe them.
+    // a shared buffer only receives the sorted elements once at the end
+    UnsignedType* work = nullptr;
+    if (length >= 256) {
+        work = static_cast<UnsignedType*>(malloc(sizeof(UnsignedType) * (isShared ? length * 2 : length)));
+    }
+
+    if (!work) {
+        // small input or no memory for the scratch area. an in-place comparison sort
+        // only moves elements around, so the buffer never holds a key
+        std::sort(data, data + length, [&sortKey](UnsignedType a, UnsignedType b) -> bool {
+            return sortKey.toKey(a) < sortKey.toKey(b);
+        });
+        return;
+    }
+
+    UnsignedType* keys = isShared ? work + length : data;
+    for (size_t i = 0; i < length; i++) {
+        keys[i] = sortKey.toKey(data[i]);
+    }
+    radixSort(keys, work, length);
+    for (size_t i = 0; i < length; i++) {
+        data[i] = sortKey.fromKey(keys[i]);
+    }
+    free(work);
+}
+
+template <typename UnsignedType>
+static void sortIntegers(void* buffer, size_t length, bool isShared, bool isSigned)
+{
+    sortByKey<UnsignedType>(buffer, length, isShared, IntegerSortKey<UnsignedType>(isSigned));
+}
+
+template <typename UnsignedType>
+static void sortFloats(void* buffer, size_t length, bool isShared, UnsignedType exponentMask, UnsignedType quietNaN)
+{
+    sortByKey<UnsignedType>(buffer, length, isShared, FloatSortKey<UnsignedType>(exponentMask, quietNaN));
+}
+
+void TypedArrayObject::sortByDefaultOrder()
+{
+    ASSERT(!buffer()->isDetachedBuffer());
+    size_t length = arrayLength();
+    if (length < 2) {
+        return;
+    }
+
+    void* data = rawBuffer();
+    bool isShared = buffer()->isSharedArrayBufferObject();
+    switch (typedArrayType()) {
+    case TypedArrayType::Int8:
+        sortIntegers<uint8_t>(data, length, isShared, true);
+        break;
+    case TypedArrayType::Uint8:
+    case TypedArrayType::Uint8Clamped:
+        sortIntegers<uint8_t>(data, length, isShared, false);
+        break;
+    case TypedArrayType::Int16:
+        sortIntegers<uint16_t>(data, length, isShared, true);
+        break;
+    case TypedArrayType::Uint16:
+        sortIntegers<uint16_t>(data, length, isShared, false);
+        break;
+    case TypedArrayType::Int32:
+        sortIntegers<uint32_t>(data, length, isShared, true);
+        break;
+    case TypedArrayType::Uint32:
+        sortIntegers<uint32_t>(data, length, isShared, false);
+        break;
+    case TypedArrayType::BigInt64:
+        sortIntegers<uint64_t>(data, length, isShared, true);
+        break;
+    case TypedArrayType::BigUint64:
+        sortIntegers<uint64_t>(data, length, isShared, false);
+        break;
+    case TypedArrayType::Float16:
+        sortFloats<uint16_t>(data, length, isShared, 0x7c00, 0x7e00);
+        break;
+    case TypedArrayType::Float32:
+        sortFloats<uint32_t>(data, length, isShared, 0x7f800000, 0x7fc00000);
+        break;
+    case TypedArrayType::Float64:
+        sortFloats<uint64_t>(data, length, isShared, 0x7ff0000000000000ULL, 0x7ff8000000000000ULL);
+        break;
+    default:
+        RELEASE_ASSERT_NOT_REACHED();
+    }
+}
+
+template <typename T>
+struct IntegerElementKernel {
+    typedef T Type;
+    static const bool isInteger = true;
+    // conversion between these is a plain two's complement truncation
+    static const bool isModularInteger = true;
+    static T fromDouble(ExecutionState& state, double value)
+    {
+        return IntegralTypedArrayAdapter<T>::toNativeFromDouble(state, value);
+    }
+};
+
+template <TypedArrayType type>
+struct ElementKernel;
+
+template <>
+struct ElementKernel<TypedArrayType::Int8> : public IntegerElementKernel<int8_t> {
+};
+template <>
+struct ElementKernel<TypedArrayType::Int16> : public IntegerElementKernel<int16_t> {
+};
+template <>
+struct ElementKernel<TypedArrayType::Int32> : public IntegerElementKernel<int32_t> {
+};
+template <>
+struct ElementKernel<TypedArrayType::Uint8> : public IntegerElementKernel<uint8_t> {
+};
+template <>
+struct ElementKernel<TypedArrayType::Uint16> : public IntegerElementKernel<uint16_t> {
+};
+template <>
+struct ElementKernel<TypedArrayType::Uint32> : public IntegerElementKernel<uint32_t> {
+};
+
+template <>
+struct ElementKernel<TypedArrayType::Uint8Clamped> {
+    typedef uint8_t Type;
+    static const bool isInteger = true;
+    static const bool isModularInteger = false;
+    static Type fromDouble(ExecutionState& state, double value)
+    {
+        return Uint8ClampedAdaptor::toNativeFromDouble(state, value);
+    }
+};
+
+template <>
+struct ElementKernel<TypedArrayType::Float16> {
+    typedef Float16 Type;
+    static const bool isInteger = false;
+    static const bool isModularInteger = false;
+    static Type fromDouble(ExecutionState& state, double value)
+    {
+        return Float16(value);
+    }
+};
+
+template <>
+struct ElementKernel<TypedArrayType::Float32> {
+    typedef float Type;
+    static const bool isInteger = false;
+    static const bool isModularInteger = false;
+    static Type fromDouble(ExecutionState& state, double value)
+    {
+        return static_cast<float>(value);
+    }
+};
+
+template <>
+struct ElementKernel<TypedArrayType::Float64> {
+    typedef double Type;
+    static const bool isInteger = false;
+    static const bool isModularInteger = false;
+    static Type fromDouble(ExecutionState& state, double value)
+    {
+        return value;
+    }
+};
+
+template <TypedArrayType srcType, TypedArrayType dstType, const bool isTruncation = ElementKernel<srcType>::isInteger && ElementKernel<dstType>::isModularInteger>
+struct ElementConverter {
+    static typename ElementKernel<dstType>::Type convert(ExecutionState& state, typename ElementKernel<srcType>::Type value)
+    {
+        // every number element is exactly representable as double
+        return ElementKernel<dstType>::fromDouble(state, static_cast<double>(value));
+    }
+};
+
+template <TypedArrayType srcType, TypedArrayType dstType>
+struct ElementConverter<srcType, dstType, true> {
+    static typename ElementKernel<dstType>::Type convert(ExecutionState& state, typename ElementKernel<srcType>::Type value)
+    {
+        // widening or narrowing between integers
+        return static_cast<typename ElementKernel<dstType>::Type>(value);
+    }
+};
+
+// elements are accessed through memcpy since armeabi-v7a faults on unaligned loads.
+// with a constant size it compiles to a plain move and keeps the loop vectorizable
+template <TypedArrayType srcType, TypedArrayType dstType>
+static void convertElements(ExecutionState& state, const uint8_t* src, uint8_t* dst, size_t count)
+{
+    typedef typename ElementKernel<srcType>::Type SrcType;
+    typedef typename ElementKernel<dstType>::Type DstType;
+    for (size_t i = 0; i < count; i++) {
+        SrcType s;
+        memcpy(&s, src + i * sizeof(SrcType), sizeof(SrcType));
+        DstType d = ElementConverter<srcType, dstType>::convert(state, s);
+        memcpy(dst + i * sizeof(DstType), &d, sizeof(DstType));
+    }
+}
+
+#define FOR_EACH_NUMBER_TYPEDARRAY_TYPES(F) \
+    F(Int8)                                 \
+    F(Int16)                                \
+    F(Int32)                                \
+    F(Uint8)                                \
+    F(Uint8Clamped)                         \
+    F(Uint16)                               \
+    F(Uint32)                               \
+    F(Float16)                              \
+    F(Float32)                              \
+    F(Float64)
+
+template <TypedArrayType srcType>
+static void convertElementsFrom(ExecutionState& state, const uint8_t* src, TypedArrayType dstType, uint8_t* dst, size_t count)
+{
+    switch (dstType) {
+#define CONVERT_TO(TYPE)                                                           \
+    case TypedArrayType::TYPE:                                                     \
+        convertElements<srcType, TypedArrayType::TYPE>(state, src, dst, count); \
+        break;
+        FOR_EACH_NUMBER_TYPEDARRAY_TYPES(CONVERT_TO)
+#undef CONVERT_TO
+    default:
+        RELEASE_ASSERT_NOT_REACHED();
+    }
+}
+
+static bool isModularIntegerType(TypedArrayType type)
+{
+    switch (type) {
+    case TypedArrayType::Int8:
+    case TypedArrayType::Int16:
+    case TypedArrayType::Int32:
+    case TypedArrayType::Uint8:
+    case TypedArrayType::Uint16:
+    case TypedArrayType::Uint32:
+    case TypedArrayType::BigInt64:
+    case TypedArrayType::BigUint64:
+        return true;
+    default:
+        return false;
+    }
+}
+
+void TypedArrayObject::convertElements(ExecutionState& state, TypedArrayType srcType, const uint8_t* src, TypedArrayType dstType, uint8_t* dst, size_t count)
+{
+    if (!count) {
+        return;
+    }
+
+    size_t srcElementSize = TypedArrayHelper::elementSize(srcType);
+    // same type or a pair with the same bit level encoding (e.g. Int8 -> Uint8, BigInt64 -> BigUint64)
+    bool isSrcInteger = isModularIntegerType(srcType) || srcType == TypedArrayType::Uint8Clamped;
+    if (srcType == dstType || (isSrcInteger && isModularIntegerType(dstType) && srcElementSize == TypedArrayHelper::elementSize(dstType))) {
+        memmove(dst, src, count * srcElementSize);
+        return;
+    }
+
+    switch (srcType) {
+#define CONVERT_FROM(TYPE)                                                                  \
+    case TypedArrayType::TYPE:                                                              \
+        convertElementsFrom<TypedArrayType::TYPE>(state, src, dstType, dst, count); \
+        break;
+        FOR_EACH_NUMBER_TYPEDARRAY_TYPES(CONVERT_FROM)
+#undef CONVERT_FROM
+    default:
+        // BigInt arrays only pair with each other, which is handled above
+        RELEASE_ASSERT_NOT_REACHED();
+    }
+}
+
+void TypedArrayObject::fillElements(size_t start, size_t end, const uint8_t* element)
+{
+    ASSERT(!buffer()->isDetachedBuffer());
+    ASSERT(start <= end && end <= arrayLength());
+    size_t elementSize = this->elementSize();
+    size_t byteLength = (end - start) * elementSize;
+    if (!byteLength) {
+        return;
+    }
+
+    uint8_t* dst = rawBuffer() + start * elementSize;
+    bool isSingleByte = true;
+    for (size_t i = 1; i < elementSize; i++) {
+        if (element[i] != element[0]) {
+            isSingleByte = false;
+            break;
+        }
+    }
+    if (isSingleByte) {
+        // covers every 1-byte type and common values like 0 or -1
+        memset(dst, element[0], byteLength);
+        return;
+    }
+
+    // broadcast the pattern by doubling the filled prefix
+    memcpy(dst, element, elementSize);
+    size_t filled = elementSize;
+    while (filled < byteLength) {
+        size_t chunk = std::min(filled, byteLength - filled);
+        memcpy(dst + filled, dst, chunk);
+        filled += chunk;
+    }
+}
+
+template <typename T, const bool isForward>
+static int64_t searchRawElements(const uint8_t* buffer, int64_t k, int64_t length, T needle)
+{
+    if (isForward) {
+        if (sizeof(T) == 1) {
+            const void* found = memchr(buffer + k, static_cast<uint8_t>(needle), length - k);
+            return found ? static_cast<const uint8_t*>(found) - buffer : -1;
+        }
+        for (int64_t i = k; i < length; i++) {
+            T c;
+            memcpy(&c, buffer + i * sizeof(T), sizeof(T));
+            if (c == needle) {
+                return i;
+            }
+        }
+    } else {
+        for (int64_t i = k; i >= 0; i--) {
+            T c;
+            memcpy(&c, buffer + i * sizeof(T), sizeof(T));
+            if (c == needle) {
+                return i;
+            }
+        }
+    }
+    return -1;
+}
+
+template <typename T, const bool isForward>
+static int64_t searchRawNaN(const uint8_t* buffer, int64_t k, int64_t length)
+{
+    for (int64_t i = k; isForward ? i < length : i >= 0; isForward ? i++ : i--) {
+        T c;
+        memcpy(&c, buffer + i * sizeof(T), sizeof(T));
+        if (std::isnan(static_cast<double>(c))) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+template <typename T, const bool isForward>
+static int64_t searchIntegerElements(const uint8_t* buffer, int64_t k, int64_t length, double number)
+{
+    // an element can only match a number of its own range
+    if (!(number >= static_cast<double>(std::numeric_limits<T>::min()) && number <= static_cast<double>(std::numeric_limits<T>::max())) || std::trunc(number) != number) {
+        return -1;
+    }
+    return searchRawElements<T, isForward>(buffer, k, length, static_cast<T>(number));
+}
+
+template <typename T, const bool isForward>
+static int64_t searchFloatElements(const uint8_t* buffer, int64_t k, int64_t length, double number, bool matchesNaN)
+{
+    if (std::isnan(number)) {
+        return matchesNaN ? searchRawNaN<T, isForward>(buffer, k, length) : -1;
+    }
+    // compare in the element type when the needle survives the round trip; -0 still equals +0
+    T needle = static_cast<T>(number);
+    if (static_cast<double>(needle) != number) {
+        return -1;
+    }
+    return searchRawElements<T, isForward>(buffer, k, length, needle);
+}
+
+template <const bool isForward>
+static int64_t searchElements(TypedArrayObject* array, int64_t k, int64_t length, const Value& value, bool matchesNaN)
+{
+    const uint8_t* buffer = array->rawBuffer();
+    auto type = array->typedArrayType();
+    if (type == TypedArrayType::BigInt64 || type == TypedArrayType::BigUint64) {
+        if (!value.isBigInt()) {
+            return -1;
+        }
+        BigInt* n = value.asBigInt();
+        if (type == TypedArrayType::BigInt64) {
+            return n->fitsInt64() ? searchRawElements<int64_t, isForward>(buffer, k, length, n->toInt64()) : -1;
+        }
+        return n->fitsUint64() ? searchRawElements<uint64_t, isForward>(buffer, k, length, n->toUint64()) : -1;
+    }
+
+    if (!value.isNumber()) {
+        return -1;
+    }
+    double number = value.asNumber();
+    switch (type) {
+    case TypedArrayType::Int8:
+        return searchIntegerElements<int8_t, isForward>(buffer, k, length, number);
+    case TypedArrayType::Uint8:
+    case TypedArrayType::Uint8Clamped:
+        return searchIntegerElements<uint8_t, isForward>(buffer, k, length, number);
+    case TypedArrayType::Int16:
+        return searchIntegerElements<int16_t, isForward>(buffer, k, length, number);
+    case TypedArrayType::Uint16:
+        return searchIntegerElements<uint16_t, isForward>(buffer, k, length, number);
+    case TypedArrayType::Int32:
+        return searchIntegerElements<int32_t, isForward>(buffer, k, length, number);
+    case TypedArrayType::Uint32:
+        return searchIntegerElements<uint32_t, isForward>(buffer, k, length, number);
+    case TypedArrayType::Float16:
+        return searchFloatElements<Float16, isForward>(buffer, k, length, number, matchesNaN);
+    case TypedArrayType::Float32:
+        return searchFloatElements<float, isForward>(buffer, k, length, number, matchesNaN);
+    case TypedArrayType::Float64:
+        return searchFloatElements<double, isForward>(buffer, k, length, number, matchesNaN);
+    default:
+        RELEASE_ASSERT_NOT_REACHED();
+        return -1;
+    }
+}
+
+int64_t TypedArrayObject::indexOfElement(const Value& value, size_t fromIndex, size_t length, bool matchesNaN)
+{
+    ASSERT(length <= arrayLength());
+    if (fromIndex >= length || !rawBuffer()) {
+        return -1;
+    }
+    return searchElements<true>(this, fromIndex, length, value, matchesNaN);
+}
+
+int64_t TypedArrayObject::lastIndexOfElement(const Value& value, size_t fromIndex, size_t length)
+{
+    ASSERT(length <= arrayLength());
+    if (!length || !rawBuffer()) {
+        return -1;
+    }
+    return searchElements<false>(this, std::min(fromIndex, length - 1), length, value, false);
+}
+
 ArrayBuffer* TypedArrayObject::validateTypedArray(ExecutionState& state, const Value& O, bool checkDetachedError)
 {
     if (UNLIKELY(!O.isObject() || !O.asObject()->isTypedArrayObject())) {
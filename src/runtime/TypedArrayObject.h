@@ -112,6 +112,20 @@ public:
     virtual void sort(ExecutionState& state, uint64_t length, const std::function<bool(const Value& a, const Value& b)>& comp) override;
     virtual void toSorted(ExecutionState& state, Object* target, uint64_t length, const std::function<bool(const Value& a, const Value& b)>& comp) override;
 
+    // sorts the elements in place by numeric order (NaN last, -0 before +0) without calling into script
+    void sortByDefaultOrder();
+
+    // bulk kernels on the raw element storage. callers validate the array and the ranges
+
+    // converts count elements like GetValueFromBuffer + SetValueInBuffer would. both types share a content type,
+    // and the ranges may overlap only when no conversion is needed
+    static void convertElements(ExecutionState& state, TypedArrayType srcType, const uint8_t* src, TypedArrayType dstType, uint8_t* dst, size_t count);
+    // stores the raw bytes of one element into [start, end)
+    void fillElements(size_t start, size_t end, const uint8_t* element);
+    // strict equality search within [0, length). includes passes matchesNaN for SameValueZero
+    int64_t indexOfElement(const Value& value, size_t fromIndex, size_t length, bool matchesNaN = false);
+    int64_t lastIndexOfElement(const Value& value, size_t fromIndex, size_t length);
+
     static ArrayBuffer* validateTypedArray(ExecutionState& state, const Value& O, bool checkDetachedError = true);
 
 protected:
@@ -164,6 +164,9 @@ void* VMInstance::operator new(size_t size)
         for (size_t i = 0; i < iteratorRecordPoolCapacity; i++) {
             GC_set_bit(desc, GC_WORD_OFFSET(VMInstance, m_iteratorRecordPool) + i);
         }
+        for (size_t i = 0; i < registerFilePoolSizeClassCount * registerFilePoolCapacity; i++) {
+            GC_set_bit(desc, GC_WORD_OFFSET(VMInstance, m_registerFilePool) + i);
+        }
 
         GC_set_bit(desc, GC_WORD_OFFSET(VMInstance, m_defaultStructureForObject));
         GC_set_bit(desc, GC_WORD_OFFSET(VMInstance, m_defaultStructureForFunctionObject));
@@ -185,6 +188,7 @@ void* VMInstance::operator new(size_t size)
         GC_set_bit(desc, GC_WORD_OFFSET(VMInstance, m_regexpCache));
         GC_set_bit(desc, GC_WORD_OFFSET(VMInstance, m_regexpOptionStringCache));
         GC_set_bit(desc, GC_WORD_OFFSET(VMInstance, m_cachedUTC));
+        GC_set_bit(desc, GC_WORD_OFFSET(VMInstance, m_globalObjectLayoutCache));
         GC_set_bit(desc, GC_WORD_OFFSET(VMInstance, m_jobQueue));
 #if defined(ENABLE_INTL)
         GC_set_bit(desc, GC_WORD_OFFSET(VMInstance, m_intlAvailableLocales));
@@ -223,8 +227,10 @@ void vmMarkStartCallback(void* data)
     self->m_lastGCMarkStartTickCount = fastTickCount();
 
     bool inIdleMode = self->inIdleMode();
-    if (self->m_regexpCache->size() > REGEXP_CACHE_SIZE_MAX || UNLIKELY(inIdleMode)) {
-        self->m_regexpCache->clear();
+    if (UNLIKELY(inIdleMode)) {
+        self->clearRegExpCache();
+    } else {
+        self->evictRegExpCacheIfNeeded();
     }
 
     if (!self->m_isPruningCompiledByteCodes
@@ -277,7 +283,7 @@ void vmReclaimEndCallback(void* data)
     if (t == GC_EventType::GC_EVENT_RECLAIM_END) {
         printf("Done GC: HeapSize: [%f MB , %f MB]\n", GC_get_memory_use() / 1024.f / 1024.f, GC_get_heap_size() / 1024.f / 1024.f);
         printf("bytecode Size %f KiB\n", self->compiledByteCodeSize() / 1024.f);
-        printf("regexp cache size %zu\n", self->regexpCache()->size());
+        printf("regexp cache size %zu (%zu bytes)\n", self->m_regexpCache->size(), self->regexpCacheCompiledSize());
     }
     */
 }
@@ -355,6 +361,7 @@ VMInstance::VMInstance(const char* locale, const char* timezone, const char* bas
     , m_didSomePrototypeObjectDefineIndexedProperty(false)
     , m_config((size_t)ConfigFlag::Default)
     , m_iteratorRecordPoolSize(0)
+    , m_registerFilePoolSize()
     , m_lastGCMarkStartTickCount(fastTickCount())
     , m_compiledByteCodeSize(0)
     , m_maxCompiledByteCodeSize(SCRIPT_FUNCTION_OBJECT_BYTECODE_SIZE_MAX)
@@ -377,11 +384,17 @@ VMInstance::VMInstance(const char* locale, const char* timezone, const char* bas
     , m_promiseRejectCallbackPublic(nullptr)
     , m_toStringRecursionPreventer(nullptr)
     , m_regexpCache(nullptr)
+    , m_regexpCacheCompiledSize(0)
+    , m_maxRegExpCacheCompiledSize(REGEXP_CACHE_COMPILED_SIZE_MAX)
+    , m_regexpCacheClock(0)
+    , m_regexpCacheHitCount(0)
+    , m_regexpCacheMissCount(0)
     , m_regexpOptionStringCache(nullptr)
 #ifdef ENABLE_ICU
     , m_calendar(nullptr)
 #endif
     , m_cachedUTC(nullptr)
+    , m_globalObjectLayoutCache(nullptr)
     , m_jobQueue(nullptr)
 #if defined(ENABLE_CODE_CACHE)
     , m_codeCache(nullptr)
@@ -777,9 +790,42 @@ Optional<ObjectStructure*> VMInstance::findRootedObjectStructure(ObjectStructure
     return nullptr;
 }
 
-void VMInstance::clearCachesRelatedWithContext()
+void VMInstance::clearRegExpCache()
 {
     m_regexpCache->clear();
+    m_regexpCacheCompiledSize = 0;
+}
+
+void VMInstance::evictRegExpCacheIfNeeded()
+{
+    if (m_regexpCacheCompiledSize <= m_maxRegExpCacheCompiledSize) {
+        return;
+    }
+
+    // drop least recently used entries until the cache fits in its budget.
+    // RegExpObjects hold their own references to patterns, so evicting an entry in use is safe.
+    // this runs inside of a GC callback, so use malloc-based storage here
+    std::vector<std::pair<size_t, RegExpObject::RegExpCacheKey>> entries;
+    entries.reserve(m_regexpCache->size());
+    for (auto iter = m_regexpCache->begin(); iter != m_regexpCache->end(); ++iter) {
+        entries.push_back(std::make_pair(iter->second.m_lastUsedTime, iter->first));
+    }
+    std::sort(entries.begin(), entries.end(), [](const std::pair<size_t, RegExpObject::RegExpCacheKey>& a, const std::pair<size_t, RegExpObject::RegExpCacheKey>& b) -> bool {
+        return a.first < b.first;
+    });
+
+    for (size_t i = 0; i < entries.size() && m_regexpCacheCompiledSize > m_maxRegExpCacheCompiledSize; i++) {
+        auto iter = m_regexpCache->find(entries[i].second);
+        ASSERT(iter != m_regexpCache->end());
+        ASSERT(m_regexpCacheCompiledSize >= iter->second.m_compiledSize);
+        m_regexpCacheCompiledSize -= iter->second.m_compiledSize;
+        m_regexpCache->erase(iter);
+    }
+}
+
+void VMInstance::clearCachesRelatedWithContext()
+{
+    clearRegExpCache();
     globalSymbolRegistry().clear();
 #if defined(ENABLE_CODE_CACHE)
     // CodeCache should be cleared here because CodeCache holds a lock of cache directory
@@ -854,12 +900,40 @@ void VMInstance::somePrototypeObjectDefineIndexedProperty(ExecutionState& state)
     }
 }
 
+Value* VMInstance::allocatePooledRegisterFile(size_t registerFileSize)
+{
+    size_t sizeClass = registerFilePoolSizeClass(registerFileSize);
+    if (UNLIKELY(sizeClass >= registerFilePoolSizeClassCount)) {
+        return CustomAllocator<Value>().allocate(registerFileSize);
+    }
+    if (LIKELY(m_registerFilePoolSize[sizeClass] > 0)) {
+        return m_registerFilePool[sizeClass][--m_registerFilePoolSize[sizeClass]];
+    }
+    return CustomAllocator<Value>().allocate(registerFilePoolMinimumSize << sizeClass);
+}
+
+void VMInstance::recyclePooledRegisterFile(Value* registerFile, size_t registerFileSize)
+{
+    size_t sizeClass = registerFilePoolSizeClass(registerFileSize);
+    if (sizeClass < registerFilePoolSizeClassCount && m_registerFilePoolSize[sizeClass] < registerFilePoolCapacity) {
+        // hand it out zero filled like a fresh allocation, and keep the old values from being retained meanwhile
+        memset(static_cast<void*>(registerFile), 0, sizeof(Value) * (registerFilePoolMinimumSize << sizeClass));
+        m_registerFilePool[sizeClass][m_registerFilePoolSize[sizeClass]++] = registerFile;
+    }
+}
+
 void VMInstance::enqueueJob(Job* job)
 {
     m_jobQueue->enqueueJob(job);
     Global::platform()->markJSJobEnqueued(job->relatedContext());
 }
 
+void VMInstance::enqueuePromiseReactionJob(Context* relatedContext, const PromiseReaction& reaction, const Value& argument)
+{
+    m_jobQueue->enqueuePromiseReactionJob(relatedContext, reaction, argument);
+    Global::platform()->markJSJobEnqueued(relatedContext);
+}
+
 bool VMInstance::hasPendingJob()
 {
     return m_jobQueue->hasNextJob();
@@ -867,7 +941,41 @@ bool VMInstance::hasPendingJob()
 
 SandBox::SandBoxResult VMInstance::executePendingJob()
 {
-    return m_jobQueue->nextJob()->run();
+    return m_jobQueue->runNextJob();
+}
+
+SandBox::SandBoxResult VMInstance::executePendingJobs(size_t maxCount, uint64_t timeBudgetInMillisecond, size_t& executedJobCount)
+{
+    SandBox::SandBoxResult result;
+    // an empty queue yields undefined rather than an empty value
+    result.result = Value();
+    executedJobCount = 0;
+
+    uint64_t deadline = timeBudgetInMillisecond ? fastTickCount() + timeBudgetInMillisecond : 0;
+    while (executedJobCount < maxCount && m_jobQueue->hasNextJob()) {
+        result = m_jobQueue->runNextJob();
+        executedJobCount++;
+        if (!result.error.isEmpty() || (deadline && fastTickCount() >= deadline)) {
+            break;
+        }
+    }
+
+    return result;
+}
+
+size_t VMInstance::pendingJobCount()
+{
+    return m_jobQueue->size();
+}
+
+size_t VMInstance::pendingJobHighWaterMark()
+{
+    return m_jobQueue->highWaterMark();
+}
+
+void VMInstance::resetPendingJobHighWaterMark()
+{
+    m_jobQueue->resetHighWaterMark();
 }
 
 bool VMInstance::hasPendingJobFromAnotherThread()
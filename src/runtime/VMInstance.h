@@ -31,9 +31,11 @@ class Context;
 class CodeBlock;
 class JobQueue;
 class Job;
+struct PromiseReaction;
 class Symbol;
 class String;
 class IteratorRecord;
+struct GlobalObjectLayoutCache;
 #if defined(ENABLE_COMPRESSIBLE_STRING)
 class CompressibleString;
 #endif
@@ -185,6 +187,18 @@ public:
 
     DateObject* cachedUTC(ExecutionState& state);
 
+    // global object layout cached by the first Context (see GlobalObject::initializeBuiltins)
+    Optional<GlobalObjectLayoutCache*> globalObjectLayoutCache()
+    {
+        return m_globalObjectLayoutCache;
+    }
+
+    void setGlobalObjectLayoutCache(GlobalObjectLayoutCache* layoutCache)
+    {
+        ASSERT(!m_globalObjectLayoutCache);
+        m_globalObjectLayoutCache = layoutCache;
+    }
+
     // object
     // []
 
@@ -234,6 +248,11 @@ public:
         }
     }
 
+    // register files of generators and async functions are recycled the same way once their
+    // execution completed. files are allocated by size class so that one fits any function of its class
+    Value* allocatePooledRegisterFile(size_t registerFileSize);
+    void recyclePooledRegisterFile(Value* registerFile, size_t registerFileSize);
+
     void addObjectStructureToRootSet(ObjectStructure* structure);
     Optional<ObjectStructure*> findRootedObjectStructure(ObjectStructureItem* properties, size_t propertyCount);
 
@@ -245,8 +264,15 @@ public:
     }
 
     void enqueueJob(Job* job);
+    void enqueuePromiseReactionJob(Context* relatedContext, const PromiseReaction& reaction, const Value& argument);
     bool hasPendingJob();
     SandBox::SandBoxResult executePendingJob();
+    // runs up to maxCount jobs or until timeBudgetInMillisecond has elapsed (zero means infinity)
+    // stops after a job which throws and returns its result. returns undefined if no job ran
+    SandBox::SandBoxResult executePendingJobs(size_t maxCount, uint64_t timeBudgetInMillisecond, size_t& executedJobCount);
+    size_t pendingJobCount();
+    size_t pendingJobHighWaterMark();
+    void resetPendingJobHighWaterMark();
 
     bool hasPendingJobFromAnotherThread();
     // Non-blocking: true if a job from another thread (e.g. an Atomics.wait/waitAsync
@@ -283,6 +309,39 @@ public:
         m_maxCompiledByteCodeSize = s;
     }
 
+    // regexp cache is shared by every Context of this VMInstance
+    size_t& regexpCacheCompiledSize()
+    {
+        return m_regexpCacheCompiledSize;
+    }
+
+    size_t maxRegExpCacheCompiledSize()
+    {
+        return m_maxRegExpCacheCompiledSize;
+    }
+
+    void setMaxRegExpCacheCompiledSize(size_t s)
+    {
+        m_maxRegExpCacheCompiledSize = s;
+    }
+
+    size_t tickRegExpCacheClock()
+    {
+        return ++m_regexpCacheClock;
+    }
+
+    size_t& regexpCacheHitCount()
+    {
+        return m_regexpCacheHitCount;
+    }
+
+    size_t& regexpCacheMissCount()
+    {
+        return m_regexpCacheMissCount;
+    }
+
+    void clearRegExpCache();
+
 #if defined(ENABLE_COMPRESSIBLE_STRING)
     std::vector<CompressibleString*>& compressibleStrings()
     {
@@ -488,6 +547,21 @@ private:
     size_t m_iteratorRecordPoolSize;
     IteratorRecord* m_iteratorRecordPool[iteratorRecordPoolCapacity];
 
+    // see allocatePooledRegisterFile. size class n holds files of (registerFilePoolMinimumSize << n) values
+    static const size_t registerFilePoolMinimumSize = 8;
+    static const size_t registerFilePoolSizeClassCount = 4;
+    static const size_t registerFilePoolCapacity = 4;
+    static size_t registerFilePoolSizeClass(size_t registerFileSize)
+    {
+        size_t sizeClass = 0;
+        while ((registerFilePoolMinimumSize << sizeClass) < registerFileSize) {
+            sizeClass++;
+        }
+        return sizeClass;
+    }
+    size_t m_registerFilePoolSize[registerFilePoolSizeClassCount];
+    Value* m_registerFilePool[registerFilePoolSizeClassCount][registerFilePoolCapacity];
+
     uint64_t m_lastGCMarkStartTickCount;
 
     ObjectStructure* m_defaultStructureForObject;
@@ -552,6 +626,12 @@ private:
 
     // regexp object data
     RegExpCacheMap* m_regexpCache;
+    size_t m_regexpCacheCompiledSize;
+    size_t m_maxRegExpCacheCompiledSize;
+    size_t m_regexpCacheClock;
+    size_t m_regexpCacheHitCount;
+    size_t m_regexpCacheMissCount;
+    void evictRegExpCacheIfNeeded();
     ASCIIString** m_regexpOptionStringCache;
 
 // date object data
@@ -565,6 +645,7 @@ private:
     void ensureTzname();
     std::string m_tzname[2];
     DateObject* m_cachedUTC;
+    GlobalObjectLayoutCache* m_globalObjectLayoutCache;
 
     // job queue
     JobQueue* m_jobQueue;
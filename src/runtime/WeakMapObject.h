@@ -24,19 +24,10 @@
 
 namespace Escargot {
 
-struct KeyedCollectionHashIndex;
+class EphemeronTable;
 
 class WeakMapObject : public DerivedObject {
 public:
-    struct WeakMapObjectDataItem : public gc {
-        Optional<PointerValue*> key; // should be Object or Symbol
-        EncodedValue data;
-
-        void* operator new(size_t size);
-    };
-
-    typedef Vector<WeakMapObjectDataItem*, GCUtil::gc_malloc_allocator<WeakMapObjectDataItem*>> WeakMapObjectData;
-
     explicit WeakMapObject(ExecutionState& state);
     explicit WeakMapObject(ExecutionState& state, Object* proto);
 
@@ -56,15 +47,7 @@ public:
     void* operator new[](size_t size) = delete;
 
 private:
-    // returns index into m_storage or SIZE_MAX; builds the hash index once the
-    // storage outgrows KeyedCollectionHashIndex::buildThreshold
-    size_t findKeyIndex(PointerValue* key);
-    WeakMapObjectDataItem* insertNew(PointerValue* key, const Value& value);
-    void addToHashIndex(size_t storageIndex);
-    void buildOrRebuildHashIndex();
-
-    WeakMapObjectData m_storage;
-    Optional<KeyedCollectionHashIndex*> m_hashIndex;
+    EphemeronTable* m_table;
 };
 } // namespace Escargot
 
@@ -24,26 +24,10 @@
 
 namespace Escargot {
 
-struct KeyedCollectionHashIndex;
+class EphemeronTable;
 
 class WeakSetObject : public DerivedObject {
 public:
-    struct WeakSetObjectDataItem : public gc {
-        Optional<PointerValue*> key; // should be Object or Symbol
-
-        WeakSetObjectDataItem(PointerValue* key)
-            : key(key)
-        {
-        }
-
-        void* operator new(size_t size)
-        {
-            return GC_MALLOC_ATOMIC(size);
-        }
-    };
-
-    typedef Vector<WeakSetObjectDataItem*, GCUtil::gc_malloc_allocator<WeakSetObjectDataItem*>> WeakSetObjectData;
-
     explicit WeakSetObject(ExecutionState& state);
     explicit WeakSetObject(ExecutionState& state, Object* proto);
 
@@ -60,14 +44,7 @@ public:
     void* operator new[](size_t size) = delete;
 
 private:
-    // returns index into m_storage or SIZE_MAX; builds the hash index once the
-    // storage outgrows KeyedCollectionHashIndex::buildThreshold
-    size_t findKeyIndex(PointerValue* key);
-    void addToHashIndex(size_t storageIndex);
-    void buildOrRebuildHashIndex();
-
-    WeakSetObjectData m_storage;
-    Optional<KeyedCollectionHashIndex*> m_hashIndex;
+    EphemeronTable* m_table;
 };
 } // namespace Escargot
 #endif
@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2026-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+// escargot-compile: precompiles scripts into bytecode bundles
+// which ScriptParserRef::initializeScriptFromBundle loads without parsing.
+// bundles only load on the same Escargot build, so this tool should be built
+// with the same configuration as the engine running the bundles.
+// a bundle is loaded as trusted code, so ship it the way the engine binary is shipped
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#include "api/EscargotPublic.h"
+
+using namespace Escargot;
+
+class CompilePlatform : public PlatformRef {
+public:
+    virtual void markJSJobEnqueued(ContextRef* relatedContext) override
+    {
+        // ignore. scripts are compiled but never executed
+    }
+
+    virtual void markJSJobFromAnotherThreadExists(ContextRef* relatedContext) override
+    {
+        // ignore. scripts are compiled but never executed
+    }
+
+    virtual LoadModuleResult onLoadModule(ContextRef* relatedContext, ScriptRef* whereRequestFrom, StringRef* moduleSrc, ModuleType type) override
+    {
+        return LoadModuleResult(ErrorObjectRef::Code::None, StringRef::createFromASCII("modules are not supported"));
+    }
+
+    virtual void didLoadModule(ContextRef* relatedContext, OptionalRef<ScriptRef> whereRequestFrom, ScriptRef* loadedModule) override
+    {
+    }
+};
+
+static bool readFile(const char* fileName, std::string& data)
+{
+    FILE* fp = fopen(fileName, "rb");
+    if (!fp) {
+        return false;
+    }
+
+    char buf[4096];
+    size_t readLen;
+    while ((readLen = fread(buf, 1, sizeof buf, fp))) {
+        data.append(buf, readLen);
+    }
+    bool result = !ferror(fp);
+    fclose(fp);
+    return result;
+}
+
+static bool writeFile(const char* fileName, const std::vector<char>& data)
+{
+    FILE* fp = fopen(fileName, "wb");
+    if (!fp) {
+        return false;
+    }
+
+    bool result = fwrite(data.data(), 1, data.size(), fp) == data.size();
+    result = (fclose(fp) == 0) && result;
+    return result;
+}
+
+static bool compileFile(ContextRef* context, const char* fileName, const std::string& outputName, size_t threadCount)
+{
+    std::string source;
+    if (!readFile(fileName, source)) {
+        fprintf(stderr, "Cannot read %s\n", fileName);
+        return false;
+    }
+
+    // the embedder should create the source string from the same file content
+    StringRef* src = StringRef::createFromUTF8(source.data(), source.length());
+    StringRef* srcName = StringRef::createFromUTF8(fileName, strlen(fileName));
+
+    std::vector<char> bundle;
+    auto result = context->scriptParser()->compileScriptBundle(src, srcName, bundle, threadCount);
+    if (!result.isSuccessful()) {
+        fprintf(stderr, "%s: %s\n", fileName, result.parseErrorMessage->toStdUTF8String().data());
+        return false;
+    }
+
+    if (bundle.empty()) {
+        fprintf(stderr, "Cannot make a bundle of %s\n", fileName);
+        return false;
+    }
+
+    if (!writeFile(outputName.data(), bundle)) {
+        fprintf(stderr, "Cannot write %s\n", outputName.data());
+        return false;
+    }
+    return true;
+}
+
+static void printUsage(const char* name)
+{
+    fprintf(stderr, "Usage: %s [-o <output>] [-j <threads>] <script>...\n", name);
+    fprintf(stderr, "  writes <script>.escb for each script, or <output> for a single script\n");
+    fprintf(stderr, "  -j compiles the functions of each script on <threads> threads (needs threading support)\n");
+}
+
+int main(int argc, char* argv[])
+{
+    const char* outputName = nullptr;
+    size_t threadCount = 1;
+    std::vector<const char*> inputs;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            outputName = argv[++i];
+        } else if (strcmp(argv[i], "-j") == 0 && i + 1 < argc) {
+            int count = atoi(argv[++i]);
+            if (count < 1) {
+                printUsage(argv[0]);
+                return 1;
+            }
+            threadCount = count;
+        } else if (argv[i][0] == '-') {
+            printUsage(argv[0]);
+            return 1;
+        } else {
+            inputs.push_back(argv[i]);
+        }
+    }
+
+    if (inputs.empty() || (outputName && inputs.size() > 1)) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    Globals::initialize(new CompilePlatform());
+
+    int exitCode = 0;
+    {
+        PersistentRefHolder<VMInstanceRef> instance = VMInstanceRef::create();
+        PersistentRefHolder<ContextRef> context = ContextRef::create(instance.get());
+
+        for (size_t i = 0; i < inputs.size(); i++) {
+            std::string output = outputName ? std::string(outputName) : std::string(inputs[i]) + ".escb";
+            if (!compileFile(context.get(), inputs[i], output, threadCount)) {
+                exitCode = 1;
+            }
+        }
+
+        context.release();
+        instance.release();
+    }
+
+    Globals::finalize();
+    return exitCode;
+}
@@ -403,13 +403,8 @@ static ValueRef* builtinUneval(ExecutionStateRef* state, ValueRef* thisValue, si
 static ValueRef* builtinDrainJobQueue(ExecutionStateRef* state, ValueRef* thisValue, size_t argc, ValueRef** argv, bool isConstructCall)
 {
     ContextRef* context = state->context();
-    while (context->vmInstance()->hasPendingJob()) {
-        auto jobResult = context->vmInstance()->executePendingJob();
-        if (jobResult.error) {
-            return ValueRef::create(false);
-        }
-    }
-    return ValueRef::create(true);
+    auto jobResult = context->vmInstance()->executePendingJobs();
+    return ValueRef::create(!jobResult.error);
 }
 
 static ValueRef* builtinAddPromiseReactions(ExecutionStateRef* state, ValueRef* thisValue, size_t argc, ValueRef** argv, bool isConstructCall)
@@ -0,0 +1,471 @@
+/*
+ * Copyright (c) 2026-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#ifndef __EscargotStringSearch__
+#define __EscargotStringSearch__
+
+// search and comparison kernels over raw Latin1 (LChar) / UTF-16 (char16_t) buffers.
+// SSE2 and NEON are part of the x86-64 and ARM64 baselines, so they are used
+// unconditionally on those targets; every other target gets the scalar loops.
+#if !defined(COMPILER_MSVC) && (defined(CPU_X86_64) || (defined(CPU_X86) && defined(__SSE2__)))
+#define ESCARGOT_STRING_SEARCH_SSE2
+#include <emmintrin.h>
+#elif !defined(COMPILER_MSVC) && defined(CPU_ARM64)
+#define ESCARGOT_STRING_SEARCH_NEON
+#include <arm_neon.h>
+#endif
+
+namespace Escargot {
+// A type to hold a single Latin-1 character.
+typedef unsigned char LChar;
+
+class StringSearch {
+public:
+    // returns the index of the first `ch` in s[0, len), or SIZE_MAX
+    static ALWAYS_INLINE size_t findChar(const LChar* s, size_t len, char16_t ch)
+    {
+        if (ch > 0xFF) {
+            return SIZE_MAX;
+        }
+        // libc memchr is vectorized on every platform we care about
+        const void* found = memchr(s, ch, len);
+        return found ? static_cast<const LChar*>(found) - s : SIZE_MAX;
+    }
+
+    static size_t findChar(const char16_t* s, size_t len, char16_t ch)
+    {
+        size_t i = 0;
+#if defined(ESCARGOT_STRING_SEARCH_SSE2)
+        const __m128i c = _mm_set1_epi16(static_cast<short>(ch));
+        for (; i + 8 <= len; i += 8) {
+            __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+            unsigned mask = _mm_movemask_epi8(_mm_cmpeq_epi16(block, c));
+            if (mask) {
+                return i + (__builtin_ctz(mask) >> 1);
+            }
+        }
+#elif defined(ESCARGOT_STRING_SEARCH_NEON)
+        const uint16x8_t c = vdupq_n_u16(ch);
+        for (; i + 8 <= len; i += 8) {
+            uint64_t mask = narrowMask16(vceqq_u16(vld1q_u16(reinterpret_cast<const uint16_t*>(s + i)), c));
+            if (mask) {
+                return i + (__builtin_ctzll(mask) >> 3);
+            }
+        }
+#endif
+        for (; i < len; i++) {
+            if (s[i] == ch) {
+                return i;
+            }
+        }
+        return SIZE_MAX;
+    }
+
+    // returns the index of the last `ch` in s[0, len), or SIZE_MAX
+    template <typename T>
+    static size_t findLastChar(const T* s, size_t len, char16_t ch)
+    {
+        if (sizeof(T) == 1 && ch > 0xFF) {
+            return SIZE_MAX;
+        }
+        while (len > 0) {
+            len--;
+            if (s[len] == ch) {
+                return len;
+            }
+        }
+        return SIZE_MAX;
+    }
+
+    static ALWAYS_INLINE bool equals(const LChar* a, const LChar* b, size_t len)
+    {
+        return memcmp(a, b, len) == 0;
+    }
+
+    static ALWAYS_INLINE bool equals(const char16_t* a, const char16_t* b, size_t len)
+    {
+        return memcmp(a, b, len * sizeof(char16_t)) == 0;
+    }
+
+    // compares UTF-16 against Latin1 by widening 16 Latin1 characters at a time
+    static bool equals(const char16_t* a, const LChar* b, size_t len)
+    {
+        size_t i = 0;
+#if defined(ESCARGOT_STRING_SEARCH_SSE2)
+        const __m128i zero = _mm_setzero_si128();
+        for (; i + 16 <= len; i += 16) {
+            __m128i narrow = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+            __m128i lo = _mm_cmpeq_epi16(_mm_unpacklo_epi8(narrow, zero), _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i)));
+            __m128i hi = _mm_cmpeq_epi16(_mm_unpackhi_epi8(narrow, zero), _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i + 8)));
+            if (_mm_movemask_epi8(_mm_and_si128(lo, hi)) != 0xFFFF) {
+                return false;
+            }
+        }
+#elif defined(ESCARGOT_STRING_SEARCH_NEON)
+        for (; i + 16 <= len; i += 16) {
+            uint8x16_t narrow = vld1q_u8(b + i);
+            uint16x8_t lo = vceqq_u16(vmovl_u8(vget_low_u8(narrow)), vld1q_u16(reinterpret_cast<const uint16_t*>(a + i)));
+            uint16x8_t hi = vceqq_u16(vmovl_u8(vget_high_u8(narrow)), vld1q_u16(reinterpret_cast<const uint16_t*>(a + i + 8)));
+            if (vminvq_u16(vandq_u16(lo, hi)) != 0xFFFF) {
+                return false;
+            }
+        }
+#endif
+        for (; i < len; i++) {
+            if (a[i] != b[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static ALWAYS_INLINE bool equals(const LChar* a, const char16_t* b, size_t len)
+    {
+        return equals(b, a, len);
+    }
+
+    // returns true if any character of s[0, len) has one of `bits` set
+    // e.g. 0xFF80 finds non-ASCII, 0xFF00 finds non-Latin1 characters
+    static bool hasCharWithBits(const char16_t* s, size_t len, char16_t bits)
+    {
+        size_t i = 0;
+#if defined(ESCARGOT_STRING_SEARCH_SSE2)
+        const __m128i b = _mm_set1_epi16(static_cast<short>(bits));
+        __m128i acc = _mm_setzero_si128();
+        for (; i + 8 <= len; i += 8) {
+            acc = _mm_or_si128(acc, _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i)), b));
+        }
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(acc, _mm_setzero_si128())) != 0xFFFF) {
+            return true;
+        }
+#elif defined(ESCARGOT_STRING_SEARCH_NEON)
+        const uint16x8_t b = vdupq_n_u16(bits);
+        uint16x8_t acc = vdupq_n_u16(0);
+        for (; i + 8 <= len; i += 8) {
+            acc = vorrq_u16(acc, vandq_u16(vld1q_u16(reinterpret_cast<const uint16_t*>(s + i)), b));
+        }
+        if (vmaxvq_u16(acc)) {
+            return true;
+        }
+#endif
+        char16_t acc16 = 0;
+        for (; i < len; i++) {
+            acc16 |= s[i];
+        }
+        return acc16 & bits;
+    }
+
+    static bool hasCharWithBits(const LChar* s, size_t len, LChar bits)
+    {
+        size_t i = 0;
+#if defined(ESCARGOT_STRING_SEARCH_SSE2)
+        const __m128i b = _mm_set1_epi8(static_cast<char>(bits));
+        __m128i acc = _mm_setzero_si128();
+        for (; i + 16 <= len; i += 16) {
+            acc = _mm_or_si128(acc, _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i)), b));
+        }
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(acc, _mm_setzero_si128())) != 0xFFFF) {
+            return true;
+        }
+#elif defined(ESCARGOT_STRING_SEARCH_NEON)
+        const uint8x16_t b = vdupq_n_u8(bits);
+        uint8x16_t acc = vdupq_n_u8(0);
+        for (; i + 16 <= len; i += 16) {
+            acc = vorrq_u8(acc, vandq_u8(vld1q_u8(s + i), b));
+        }
+        if (vmaxvq_u8(acc)) {
+            return true;
+        }
+#endif
+        LChar acc8 = 0;
+        for (; i < len; i++) {
+            acc8 |= s[i];
+        }
+        return acc8 & bits;
+    }
+
+    // returns the index of the first of c0..c3 in s[0, len), or len
+    // pass a character more than once to look for fewer characters
+    static size_t findFirstOf(const LChar* s, size_t len, LChar c0, LChar c1, LChar c2, LChar c3)
+    {
+        size_t i = 0;
+#if defined(ESCARGOT_STRING_SEARCH_SSE2)
+        const __m128i v0 = _mm_set1_epi8(static_cast<char>(c0));
+        const __m128i v1 = _mm_set1_epi8(static_cast<char>(c1));
+        const __m128i v2 = _mm_set1_epi8(static_cast<char>(c2));
+        const __m128i v3 = _mm_set1_epi8(static_cast<char>(c3));
+        for (; i + 16 <= len; i += 16) {
+            __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+            __m128i cmp = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(block, v0), _mm_cmpeq_epi8(block, v1)),
+                                       _mm_or_si128(_mm_cmpeq_epi8(block, v2), _mm_cmpeq_epi8(block, v3)));
+            unsigned mask = _mm_movemask_epi8(cmp);
+            if (mask) {
+                return i + __builtin_ctz(mask);
+            }
+        }
+#elif defined(ESCARGOT_STRING_SEARCH_NEON)
+        const uint8x16_t v0 = vdupq_n_u8(c0);
+        const uint8x16_t v1 = vdupq_n_u8(c1);
+        const uint8x16_t v2 = vdupq_n_u8(c2);
+        const uint8x16_t v3 = vdupq_n_u8(c3);
+        for (; i + 16 <= len; i += 16) {
+            uint8x16_t block = vld1q_u8(s + i);
+            uint8x16_t cmp = vorrq_u8(vorrq_u8(vceqq_u8(block, v0), vceqq_u8(block, v1)),
+                                      vorrq_u8(vceqq_u8(block, v2), vceqq_u8(block, v3)));
+            uint64_t mask = narrowMask8(cmp);
+            if (mask) {
+                return i + (__builtin_ctzll(mask) >> 2);
+            }
+        }
+#endif
+        for (; i < len; i++) {
+            LChar c = s[i];
+            if (c == c0 || c == c1 || c == c2 || c == c3) {
+                return i;
+            }
+        }
+        return len;
+    }
+
+    // returns the index of the first character of s[0, len) which is not one of [A-Za-z0-9_$], or len
+    // the caller checks non-ASCII characters, some of them are identifier parts as well
+    static size_t findNonASCIIIdentifierPart(const LChar* s, size_t len)
+    {
+        size_t i = 0;
+#if defined(ESCARGOT_STRING_SEARCH_SSE2)
+        // compares are signed, so non-ASCII bytes are negative and fail both ranges
+        const __m128i caseBit = _mm_set1_epi8(0x20);
+        const __m128i beforeA = _mm_set1_epi8('a' - 1);
+        const __m128i afterZ = _mm_set1_epi8('z' + 1);
+        const __m128i before0 = _mm_set1_epi8('0' - 1);
+        const __m128i after9 = _mm_set1_epi8('9' + 1);
+        const __m128i underscore = _mm_set1_epi8('_');
+        const __m128i dollar = _mm_set1_epi8('$');
+        for (; i + 16 <= len; i += 16) {
+            __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+            __m128i lower = _mm_or_si128(block, caseBit);
+            __m128i isAlpha = _mm_and_si128(_mm_cmpgt_epi8(lower, beforeA), _mm_cmplt_epi8(lower, afterZ));
+            __m128i isDigit = _mm_and_si128(_mm_cmpgt_epi8(block, before0), _mm_cmplt_epi8(block, after9));
+            __m128i isPart = _mm_or_si128(_mm_or_si128(isAlpha, isDigit),
+                                          _mm_or_si128(_mm_cmpeq_epi8(block, underscore), _mm_cmpeq_epi8(block, dollar)));
+            unsigned mask = _mm_movemask_epi8(isPart) ^ 0xFFFF;
+            if (mask) {
+                return i + __builtin_ctz(mask);
+            }
+        }
+#elif defined(ESCARGOT_STRING_SEARCH_NEON)
+        const uint8x16_t caseBit = vdupq_n_u8(0x20);
+        const uint8x16_t a = vdupq_n_u8('a');
+        const uint8x16_t z = vdupq_n_u8('z');
+        const uint8x16_t zero = vdupq_n_u8('0');
+        const uint8x16_t nine = vdupq_n_u8('9');
+        const uint8x16_t underscore = vdupq_n_u8('_');
+        const uint8x16_t dollar = vdupq_n_u8('$');
+        for (; i + 16 <= len; i += 16) {
+            uint8x16_t block = vld1q_u8(s + i);
+            uint8x16_t lower = vorrq_u8(block, caseBit);
+            uint8x16_t isAlpha = vandq_u8(vcgeq_u8(lower, a), vcleq_u8(lower, z));
+            uint8x16_t isDigit = vandq_u8(vcgeq_u8(block, zero), vcleq_u8(block, nine));
+            uint8x16_t isPart = vorrq_u8(vorrq_u8(isAlpha, isDigit),
+                                         vorrq_u8(vceqq_u8(block, underscore), vceqq_u8(block, dollar)));
+            uint64_t mask = narrowMask8(vmvnq_u8(isPart));
+            if (mask) {
+                return i + (__builtin_ctzll(mask) >> 2);
+            }
+        }
+#endif
+        for (; i < len; i++) {
+            LChar c = s[i];
+            LChar lower = c | 0x20;
+            if (!((lower >= 'a' && lower <= 'z') || (c >= '0' && c <= '9') || c == '_' || c == '$')) {
+                return i;
+            }
+        }
+        return len;
+    }
+
+    // returns the first index >= pos where needle occurs in haystack, or SIZE_MAX
+    // candidates are filtered by comparing the first and the last character of needle
+    // against a whole block of positions at once, then verified with equals()
+    template <typename H, typename N>
+    static size_t find(const H* haystack, size_t haystackLength, const N* needle, size_t needleLength, size_t pos)
+    {
+        if (needleLength == 0) {
+            return pos <= haystackLength ? pos : SIZE_MAX;
+        }
+        if (needleLength > haystackLength || pos > haystackLength - needleLength) {
+            return SIZE_MAX;
+        }
+        const char16_t first = needle[0];
+        const char16_t last = needle[needleLength - 1];
+        if (sizeof(H) == 1 && (first > 0xFF || last > 0xFF)) {
+            return SIZE_MAX;
+        }
+        if (needleLength == 1) {
+            size_t found = findChar(haystack + pos, haystackLength - pos, first);
+            return found == SIZE_MAX ? SIZE_MAX : pos + found;
+        }
+
+        // last position where needle can start
+        const size_t end = haystackLength - needleLength;
+        if (findCandidates(haystack, end, needle, needleLength, pos)) {
+            return pos;
+        }
+
+        for (; pos <= end; pos++) {
+            if (haystack[pos] == first && haystack[pos + needleLength - 1] == last
+                && equals(haystack + pos + 1, needle + 1, needleLength - 2)) {
+                return pos;
+            }
+        }
+        return SIZE_MAX;
+    }
+
+    // returns the last index <= pos where needle occurs in haystack, or SIZE_MAX
+    template <typename H, typename N>
+    static size_t rfind(const H* haystack, size_t haystackLength, const N* needle, size_t needleLength, size_t pos)
+    {
+        if (needleLength == 0) {
+            return pos <= haystackLength ? pos : SIZE_MAX;
+        }
+        if (needleLength > haystackLength) {
+            return SIZE_MAX;
+        }
+        if (pos > haystackLength - needleLength) {
+            pos = haystackLength - needleLength;
+        }
+        const char16_t first = needle[0];
+        size_t limit = pos + 1;
+        while (true) {
+            size_t found = findLastChar(haystack, limit, first);
+            if (found == SIZE_MAX) {
+                return SIZE_MAX;
+            }
+            if (equals(haystack + found + 1, needle + 1, needleLength - 1)) {
+                return found;
+            }
+            limit = found;
+        }
+    }
+
+private:
+#if defined(ESCARGOT_STRING_SEARCH_NEON)
+    // NEON has no movemask; narrow each lane to a nibble (8-bit lanes) or a byte (16-bit lanes)
+    static ALWAYS_INLINE uint64_t narrowMask8(uint8x16_t cmp)
+    {
+        return vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(cmp), 4)), 0);
+    }
+
+    static ALWAYS_INLINE uint64_t narrowMask16(uint16x8_t cmp)
+    {
+        return vget_lane_u64(vreinterpret_u64_u8(vmovn_u16(cmp)), 0);
+    }
+#endif
+
+    // scans whole blocks of candidate start positions in [pos, end].
+    // returns true with `pos` set to the match, otherwise `pos` is where the scalar loop should continue
+    template <typename N>
+    static bool findCandidates(const LChar* haystack, size_t end, const N* needle, size_t needleLength, size_t& pos)
+    {
+#if defined(ESCARGOT_STRING_SEARCH_SSE2) || defined(ESCARGOT_STRING_SEARCH_NEON)
+        const size_t lastOffset = needleLength - 1;
+#if defined(ESCARGOT_STRING_SEARCH_SSE2)
+        const __m128i first = _mm_set1_epi8(static_cast<char>(needle[0]));
+        const __m128i last = _mm_set1_epi8(static_cast<char>(needle[lastOffset]));
+#else
+        const uint8x16_t first = vdupq_n_u8(static_cast<uint8_t>(needle[0]));
+        const uint8x16_t last = vdupq_n_u8(static_cast<uint8_t>(needle[lastOffset]));
+#endif
+        for (; pos + 16 <= end + 1; pos += 16) {
+#if defined(ESCARGOT_STRING_SEARCH_SSE2)
+            __m128i blockFirst = _mm_loadu_si128(reinterpret_cast<const __m128i*>(haystack + pos));
+            __m128i blockLast = _mm_loadu_si128(reinterpret_cast<const __m128i*>(haystack + pos + lastOffset));
+            unsigned mask = _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(blockFirst, first), _mm_cmpeq_epi8(blockLast, last)));
+            while (mask) {
+                unsigned bit = __builtin_ctz(mask);
+                if (equals(haystack + pos + bit + 1, needle + 1, needleLength - 2)) {
+                    pos += bit;
+                    return true;
+                }
+                mask &= mask - 1;
+            }
+#else
+            uint8x16_t cmp = vandq_u8(vceqq_u8(vld1q_u8(haystack + pos), first), vceqq_u8(vld1q_u8(haystack + pos + lastOffset), last));
+            uint64_t mask = narrowMask8(cmp);
+            while (mask) {
+                unsigned bit = __builtin_ctzll(mask) >> 2;
+                if (equals(haystack + pos + bit + 1, needle + 1, needleLength - 2)) {
+                    pos += bit;
+                    return true;
+                }
+                mask &= ~(0xFULL << (bit << 2));
+            }
+#endif
+        }
+#endif
+        return false;
+    }
+
+    template <typename N>
+    static bool findCandidates(const char16_t* haystack, size_t end, const N* needle, size_t needleLength, size_t& pos)
+    {
+#if defined(ESCARGOT_STRING_SEARCH_SSE2) || defined(ESCARGOT_STRING_SEARCH_NEON)
+        const size_t lastOffset = needleLength - 1;
+#if defined(ESCARGOT_STRING_SEARCH_SSE2)
+        const __m128i first = _mm_set1_epi16(static_cast<short>(needle[0]));
+        const __m128i last = _mm_set1_epi16(static_cast<short>(needle[lastOffset]));
+#else
+        const uint16x8_t first = vdupq_n_u16(needle[0]);
+        const uint16x8_t last = vdupq_n_u16(needle[lastOffset]);
+#endif
+        for (; pos + 8 <= end + 1; pos += 8) {
+#if defined(ESCARGOT_STRING_SEARCH_SSE2)
+            __m128i blockFirst = _mm_loadu_si128(reinterpret_cast<const __m128i*>(haystack + pos));
+            __m128i blockLast = _mm_loadu_si128(reinterpret_cast<const __m128i*>(haystack + pos + lastOffset));
+            unsigned mask = _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi16(blockFirst, first), _mm_cmpeq_epi16(blockLast, last)));
+            while (mask) {
+                unsigned lane = __builtin_ctz(mask) >> 1;
+                if (equals(haystack + pos + lane + 1, needle + 1, needleLength - 2)) {
+                    pos += lane;
+                    return true;
+                }
+                mask &= ~(3u << (lane << 1));
+            }
+#else
+            uint16x8_t cmp = vandq_u16(vceqq_u16(vld1q_u16(reinterpret_cast<const uint16_t*>(haystack + pos)), first),
+                                       vceqq_u16(vld1q_u16(reinterpret_cast<const uint16_t*>(haystack + pos + lastOffset)), last));
+            uint64_t mask = narrowMask16(cmp);
+            while (mask) {
+                unsigned lane = __builtin_ctzll(mask) >> 3;
+                if (equals(haystack + pos + lane + 1, needle + 1, needleLength - 2)) {
+                    pos += lane;
+                    return true;
+                }
+                mask &= ~(0xFFULL << (lane << 3));
+            }
+#endif
+        }
+#endif
+        return false;
+    }
+};
+
+} // namespace Escargot
+
+#endif
@@ -212,19 +212,31 @@ public:
 
 namespace detail {
 
+// merge the sorted runs [begin, middle) and [middle, end) of src into dst
 template <typename T, typename Comparator>
 ALWAYS_INLINE bool
-merge(T* dst, const T* src, size_t srcIndex, size_t srcEnd, size_t width, Comparator c)
+mergeRuns(T* dst, const T* src, size_t begin, size_t middle, size_t end, Comparator& c)
 {
-    size_t left = srcIndex;
-    size_t leftEnd = std::min(left + width, srcEnd);
-    size_t right = leftEnd;
-    size_t rightEnd = std::min(right + width, srcEnd);
+    size_t left = begin;
+    size_t right = middle;
     bool lessOrEqual;
 
-    for (size_t dstIndex = left; dstIndex < rightEnd; ++dstIndex) {
-        if (right < rightEnd) {
-            if (left >= leftEnd) {
+    // runs which are already in order are copied without comparing every element
+    if (left < middle && right < end) {
+        if (!c(src[right], src[middle - 1], &lessOrEqual)) {
+            return false;
+        }
+        if (!lessOrEqual) {
+            for (size_t i = begin; i < end; i++) {
+                dst[i] = src[i];
+            }
+            return true;
+        }
+    }
+
+    for (size_t dstIndex = begin; dstIndex < end; ++dstIndex) {
+        if (right < end) {
+            if (left >= middle) {
                 dst[dstIndex] = src[right++];
                 continue;
             }
@@ -244,32 +256,145 @@ merge(T* dst, const T* src, size_t srcIndex, size_t srcEnd, size_t width, Compar
     return true;
 }
 
+// binary insertion sort of [begin, end) where [begin, sortedEnd) is already sorted
+template <typename T, typename Comparator>
+bool insertionSort(T* array, size_t begin, size_t sortedEnd, size_t end, Comparator& c)
+{
+    bool lessOrEqual;
+    for (size_t i = sortedEnd; i < end; i++) {
+        T pivot = array[i];
+        size_t low = begin;
+        size_t high = i;
+        while (low < high) {
+            size_t middle = low + (high - low) / 2;
+            if (!c(pivot, array[middle], &lessOrEqual)) {
+                return false;
+            }
+            if (lessOrEqual) {
+                high = middle;
+            } else {
+                low = middle + 1;
+            }
+        }
+        for (size_t j = i; j > low; j--) {
+            array[j] = array[j - 1];
+        }
+        array[low] = pivot;
+    }
+    return true;
+}
+
+// find the natural run starting at begin, reversing it when it is strictly descending
+template <typename T, typename Comparator>
+bool findRun(T* array, size_t begin, size_t nelems, size_t& runEnd, Comparator& c)
+{
+    runEnd = begin + 1;
+    if (runEnd == nelems) {
+        return true;
+    }
+
+    bool lessOrEqual;
+    if (!c(array[runEnd], array[begin], &lessOrEqual)) {
+        return false;
+    }
+    runEnd++;
+    if (lessOrEqual) {
+        while (runEnd < nelems) {
+            if (!c(array[runEnd], array[runEnd - 1], &lessOrEqual)) {
+                return false;
+            }
+            if (!lessOrEqual) {
+                break;
+            }
+            runEnd++;
+        }
+        std::reverse(array + begin, array + runEnd);
+    } else {
+        while (runEnd < nelems) {
+            if (!c(array[runEnd], array[runEnd - 1], &lessOrEqual)) {
+                return false;
+            }
+            if (lessOrEqual) {
+                break;
+            }
+            runEnd++;
+        }
+    }
+    return true;
+}
+
 } /* namespace detail */
 
 /*
- * Sort the array using the merge sort algorithm. The scratch should point to
- * a temporary storage that can hold nelems elements.
+ * Sort the array using a natural merge sort (TimSort without galloping).
+ * Ascending and strictly descending runs of the input are detected, short
+ * runs are extended with binary insertion sort, and the runs are merged
+ * bottom-up. The sort is stable. The scratch should point to a temporary
+ * storage that can hold nelems elements.
  *
  * The comparator must provide the () operator with the following signature:
  *
- *     bool operator()(const T& a, const T& a, bool *lessOrEqualp);
+ *     bool operator()(const T& a, const T& b, bool *lessOrEqualp);
  *
- * It should return true on success and set *lessOrEqualp to the result of
- * a <= b operation. If it returns false, the sort terminates immediately with
- * the false result. In this case the content of the array and scratch is
- * arbitrary.
+ * It should return true on success and set *lessOrEqualp to true when a
+ * must be placed before b. If it returns false, the sort terminates
+ * immediately with the false result. In this case the content of the
+ * array and scratch is arbitrary.
  */
 template <typename T, typename Comparator>
 bool mergeSort(T* array, size_t nelems, T* scratch, Comparator c)
 {
+    if (nelems < 2) {
+        return true;
+    }
+
+    size_t minRun = nelems;
+    size_t remainder = 0;
+    while (minRun >= 32) {
+        remainder |= minRun & 1;
+        minRun >>= 1;
+    }
+    minRun += remainder;
+
+    std::vector<size_t> runEnds;
+    for (size_t begin = 0; begin < nelems;) {
+        size_t runEnd;
+        if (!detail::findRun(array, begin, nelems, runEnd, c)) {
+            return false;
+        }
+        size_t forcedEnd = std::min(begin + minRun, nelems);
+        if (runEnd < forcedEnd) {
+            if (!detail::insertionSort(array, begin, runEnd, forcedEnd, c)) {
+                return false;
+            }
+            runEnd = forcedEnd;
+        }
+        runEnds.push_back(runEnd);
+        begin = runEnd;
+    }
+
     T* dst = scratch;
     T* src = array;
 
-    for (size_t width = 1; width < nelems; width *= 2) {
-        for (size_t srcIndex = 0; srcIndex < nelems; srcIndex += 2 * width)
-            if (!detail::merge(dst, src, srcIndex, nelems, width, c)) {
-                return false;
+    while (runEnds.size() > 1) {
+        size_t mergedRunCount = 0;
+        size_t begin = 0;
+        for (size_t i = 0; i < runEnds.size(); i += 2) {
+            if (i + 1 < runEnds.size()) {
+                if (!detail::mergeRuns(dst, src, begin, runEnds[i], runEnds[i + 1], c)) {
+                    return false;
+                }
+                begin = runEnds[i + 1];
+            } else {
+                for (size_t j = begin; j < runEnds[i]; j++) {
+                    dst[j] = src[j];
+                }
+                begin = runEnds[i];
             }
+            runEnds[mergedRunCount++] = begin;
+        }
+        runEnds.resize(mergedRunCount);
+
         T* tmp = src;
         src = dst;
         dst = tmp;
@@ -258,8 +258,7 @@ Object* WASMOperations::asyncCompileModule(ExecutionState& state, Value source)
 {
     PromiseReaction::Capability capability = PromiseObject::newPromiseCapability(state, state.context()->globalObject()->promise());
     NativeFunctionObject* asyncCompiler = new NativeFunctionObject(state, NativeFunctionInfo(AtomicString(), WASMOperations::compileModule, 1, NativeFunctionInfo::Strict));
-    Job* job = new PromiseReactionJob(state.context(), PromiseReaction(asyncCompiler, capability), source);
-    state.context()->vmInstance()->enqueueJob(job);
+    state.context()->vmInstance()->enqueuePromiseReactionJob(state.context(), PromiseReaction(asyncCompiler, capability), source);
 
     return capability.m_promise;
 }
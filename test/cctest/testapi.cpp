@@ -23,6 +23,8 @@ using namespace Escargot;
 
 #include "gtest/gtest.h"
 
+#include <algorithm>
+#include <thread>
 #include <vector>
 
 static bool stringEndsWith(const std::string& str, const std::string& suffix)
@@ -217,8 +219,16 @@ static OptionalRef<StringRef> builtinHelperFileRead(OptionalRef<ExecutionStateRe
     }
 }
 
+// committed bytes of reserved ArrayBuffer stores, as reported to the Platform
+static int64_t s_committedArrayBufferSize;
+
 class ShellPlatform : public PlatformRef {
 public:
+    virtual void onCommitArrayBufferObjectDataBuffer(void* buffer, size_t oldCommittedSizeInByte, size_t newCommittedSizeInByte) override
+    {
+        s_committedArrayBufferSize += static_cast<int64_t>(newCommittedSizeInByte) - static_cast<int64_t>(oldCommittedSizeInByte);
+    }
+
     virtual void markJSJobEnqueued(ContextRef* relatedContext) override
     {
         // ignore. we always check pending job after eval script
@@ -498,6 +508,100 @@ TEST(ValueRef, Basic2)
     });
 }
 
+static std::string evalTestScript(const char* source)
+{
+    return evalScript(g_context.get(), StringRef::createFromUTF8(source, strlen(source)), StringRef::createFromASCII("test.js"), false);
+}
+
+TEST(MapObject, Compaction)
+{
+    // iterators created before a compaction continue from the same entry
+    evalTestScript(R"(
+    var m = new Map();
+    for (var i = 0; i < 40; i++) m.set(i, i);
+    var it = m.keys();
+    var firstKeys = [it.next().value, it.next().value];
+    for (var i = 0; i < 30; i++) m.delete(i);
+    )");
+    EXPECT_EQ(evalTestScript("firstKeys.join()"), "0,1");
+    EXPECT_EQ(evalTestScript("[it.next().value, m.size].join()"), "30,10");
+    EXPECT_EQ(evalTestScript("m.clear(); m.set('a', 1); [it.next().value, it.next().done].join()"), "a,true");
+
+    // forEach skips entries deleted ahead of it and visits ones added during iteration
+    EXPECT_EQ(evalTestScript(R"(
+    var s = new Set([1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12]), visited = [];
+    s.forEach(v => { if (v < 10) s.delete(v + 1); if (v == 1) s.add(99); visited.push(v); });
+    visited.join() + " " + s.size
+    )"),
+              "1,3,5,7,9,11,12,99 8");
+
+    EXPECT_EQ(evalTestScript(R"(
+    var churn = new Map();
+    for (var i = 0; i < 100000; i++) { churn.set("k" + i, i); if (i >= 10) churn.delete("k" + (i - 10)); }
+    churn.size + " " + [...churn.values()].join(":")
+    )"),
+              "10 99990:99991:99992:99993:99994:99995:99996:99997:99998:99999");
+
+    Evaluator::execute(g_context.get(), [](ExecutionStateRef* state) -> ValueRef* {
+        MapObjectRef* map = MapObjectRef::create(state);
+        for (int i = 0; i < 10000; i++) {
+            map->set(state, ValueRef::create(i), ValueRef::create(i));
+            if (i >= 10) {
+                map->deleteOperation(state, ValueRef::create(i - 10));
+            }
+        }
+        EXPECT_EQ(map->size(state), 10u);
+        EXPECT_TRUE(map->allocatedMemorySize() < 1024);
+        return ValueRef::createUndefined();
+    });
+}
+
+TEST(StringRef, UTF8Transcoding)
+{
+    std::string ascii = "hello world";
+    StringRef* str = StringRef::createFromUTF8(ascii.data(), ascii.length());
+    EXPECT_TRUE(str->has8BitContent());
+    EXPECT_EQ(str->toStdUTF8String(), ascii);
+
+    // every code point fits Latin-1
+    std::string latin1 = "caf\xc3\xa9 \xc2\xa1";
+    str = StringRef::createFromUTF8(latin1.data(), latin1.length());
+    EXPECT_TRUE(str->has8BitContent());
+    EXPECT_EQ(str->length(), 6u);
+    EXPECT_EQ(str->charAt(3), 0xE9);
+    EXPECT_EQ(str->toStdUTF8String(), latin1);
+
+    std::string utf16 = "a\xe2\x82\xac\xf0\x9f\x98\x80";
+    str = StringRef::createFromUTF8(utf16.data(), utf16.length());
+    EXPECT_FALSE(str->has8BitContent());
+    EXPECT_EQ(str->length(), 4u);
+    EXPECT_EQ(str->charAt(1), 0x20AC);
+    EXPECT_EQ(str->charAt(2), 0xD83D);
+    EXPECT_EQ(str->toStdUTF8String(), utf16);
+
+    // ill-formed input still decodes to U+FFFD
+    std::string invalid = "a\xff" "b";
+    str = StringRef::createFromUTF8(invalid.data(), invalid.length());
+    EXPECT_EQ(str->length(), 3u);
+    EXPECT_EQ(str->charAt(1), 0xFFFD);
+
+    // lone surrogates are kept or replaced depending on the option
+    char16_t lone[] = { u'x', 0xD800 };
+    str = StringRef::createFromUTF16(lone, 2);
+    EXPECT_EQ(str->toStdUTF8String(), std::string("x\xed\xa0\x80"));
+    EXPECT_EQ(str->toStdUTF8String(StringRef::ReplaceInvalidUtf8), std::string("x\xef\xbf\xbd"));
+}
+
+TEST(StringRef, External)
+{
+    static const char16_t buffer[] = u"external string";
+    size_t before = Memory::externalStringSize();
+    StringRef* str = StringRef::createExternalFromUTF16(buffer, 15, [](void* buffer, void* data) {}, nullptr);
+    EXPECT_TRUE(str->hasExternalMemory());
+    EXPECT_TRUE(str->equalsWithASCIIString("external string", 15));
+    EXPECT_EQ(Memory::externalStringSize(), before + 15 * sizeof(char16_t));
+}
+
 TEST(Evaluator, Basic)
 {
     auto result = Evaluator::execute(g_context.get(), [](ExecutionStateRef* state) -> ValueRef* {
@@ -588,6 +692,375 @@ TEST(EvalScript, Run3)
     EXPECT_EQ(s2, "Uncaught Error:\neval code (1:22)\neval code (1:39)\n");
 }
 
+TEST(EvalScript, LargeStringBuilding)
+{
+    // results cross STRING_BUILDER_CONTIGUOUS_BUFFER_THRESHOLD; the 16-bit character is appended after the switch
+    evalTestScript(R"(
+    var arr = [];
+    for (var i = 0; i < 5000; i++) arr.push(i);
+    arr.push('가');
+    )");
+    EXPECT_EQ(evalTestScript("var joined = arr.join('-'); [joined.length, joined.charCodeAt(joined.length - 1), joined.substring(0, 10)].join()"), "23891,44032,0-1-2-3-4-");
+    EXPECT_EQ(evalTestScript("var json = JSON.stringify({ a: 'x'.repeat(10000), b: arr }); json.length + ' ' + json.substring(json.length - 8)"), "33908 99,\"가\"]}");
+    EXPECT_EQ(evalTestScript("'xy'.repeat(3000).length"), "6000");
+    EXPECT_EQ(evalTestScript("var padded = '가'.padStart(9000, 'ab'); [padded.length, padded.substring(0, 4), padded.charCodeAt(8999)].join()"), "9000,abab,44032");
+    EXPECT_EQ(evalTestScript("'a-b-a'.repeat(2000).replaceAll('-', 'é').lastIndexOf('éaa')"), "9993");
+}
+
+TEST(EvalScript, AwaitOrdering)
+{
+    // primitives, native promises and thenables take different await paths but must keep the spec job order;
+    // ticks(n) queues a chain of n reactions to compare against
+    evalTestScript(R"(
+    var awaitLog;
+    function ticks(n) { var p = Promise.resolve(); for (let i = 1; i <= n; i++) p = p.then(() => awaitLog.push("t" + i)); }
+    )");
+
+    evalTestScript("awaitLog = []; (async () => { awaitLog.push(await 'v'); awaitLog.push(await 'w'); })(); ticks(3);");
+    EXPECT_EQ(evalTestScript("awaitLog.join()"), "v,t1,w,t2,t3");
+
+    evalTestScript("awaitLog = []; (async () => { awaitLog.push(await Promise.resolve('p')); })(); ticks(3);");
+    EXPECT_EQ(evalTestScript("awaitLog.join()"), "p,t1,t2,t3");
+
+    evalTestScript("awaitLog = []; (async () => { try { await Promise.reject('r'); } catch (e) { awaitLog.push(e); } })(); ticks(3);");
+    EXPECT_EQ(evalTestScript("awaitLog.join()"), "r,t1,t2,t3");
+
+    evalTestScript("awaitLog = []; (async () => { awaitLog.push(await { then(r) { r('t'); } }); })(); ticks(3);");
+    EXPECT_EQ(evalTestScript("awaitLog.join()"), "t1,t,t2,t3");
+
+    // the returned promise settles one tick after the body finishes
+    evalTestScript("awaitLog = []; (async () => { awaitLog.push('a'); return 'done'; })().then(v => awaitLog.push(v)); ticks(3); awaitLog.push('b');");
+    EXPECT_EQ(evalTestScript("awaitLog.join()"), "a,b,done,t1,t2,t3");
+
+    // for await over an async generator
+    evalTestScript("awaitLog = []; (async () => { for await (var v of (async function*() { yield await 'g1'; yield 'g2'; })()) awaitLog.push(v); })(); ticks(8);");
+    EXPECT_EQ(evalTestScript("awaitLog.join()"), "t1,t2,g1,t3,t4,g2,t5,t6,t7,t8");
+}
+
+TEST(EvalScript, GeneratorIteration)
+{
+    // for-of steps builtin generators without IteratorResult objects and reuses pooled register files
+    evalTestScript(R"(
+    function* range(n) { for (let i = 0; i < n; i++) yield i; return "r"; }
+    function collect(iterable) { var out = []; for (var x of iterable) out.push(x); return out.join(); }
+    )");
+    EXPECT_EQ(evalTestScript("collect(range(3))"), "0,1,2");
+
+    // yield* over a generator and over a hand-written iterator whose done and value are getters
+    EXPECT_EQ(evalTestScript(R"(
+    function* outer() {
+        yield* range(2);
+        var got = 0;
+        yield* { [Symbol.iterator]() { return this; }, next() { return { get done() { got++; return got > 2; }, get value() { return "v" + got; } }; } };
+        yield got;
+    }
+    collect(outer())
+    )"),
+              "0,1,v2,3");
+
+    EXPECT_EQ(evalTestScript("var bad = []; for (var k = 0; k < 50; k++) { var sum = 0; for (var x of range(k)) sum += x; if (sum !== k * (k - 1) / 2) bad.push(k); } bad.join()"), "");
+
+    // leaving the loop early closes the generator
+    EXPECT_EQ(evalTestScript("var closed = range(5); for (var x of closed) { if (x == 1) break; } JSON.stringify(closed.next())"), "{\"done\":true}");
+    EXPECT_EQ(evalTestScript("function* thrower() { yield 1; throw 'e'; } var thrown = []; try { for (var x of thrower()) thrown.push(x); } catch (e) { thrown.push(e); } thrown.join()"), "1,e");
+
+    EXPECT_EQ(evalTestScript("var [a, b, ...rest] = range(5); [a, b, rest.join(':')].join()"), "0,1,2:3:4");
+
+    // locals of async functions survive the await
+    evalTestScript("var asyncSum = 0; async function af(v) { var t = [v, v + 1]; await null; return t[0] + t[1]; } for (var k = 0; k < 20; k++) af(k).then(v => asyncSum += v);");
+    EXPECT_EQ(evalTestScript("asyncSum"), "400");
+}
+
+TEST(EvalScript, TypedArrayDefaultSort)
+{
+    EXPECT_EQ(evalTestScript("Array.from(new Float64Array([3, NaN, -0, 0, -Infinity, 1.5, -2, NaN, Infinity]).sort(), v => Object.is(v, -0) ? '-0' : String(v)).join(' ')"), "-Infinity -2 -0 0 1.5 3 Infinity NaN NaN");
+    EXPECT_EQ(evalTestScript("new Int8Array([5, -128, 127, 0, -1]).sort().join(' ')"), "-128 -1 0 5 127");
+    EXPECT_EQ(evalTestScript("new Uint32Array([4294967295, 0, 7, 65536]).sort().join(' ')"), "0 7 65536 4294967295");
+    EXPECT_EQ(evalTestScript("new BigInt64Array([5n, -(2n ** 63n), 0n, -1n]).sort().join(' ')"), "-9223372036854775808 -1 0 5");
+
+    // long enough for the radix sort; toSorted leaves the source untouched
+    EXPECT_EQ(evalTestScript(R"(
+    var big = new Int32Array(3000);
+    for (var i = 0; i < big.length; i++) big[i] = (i * 7919) % 3001 - 1500;
+    var sorted = big.toSorted();
+    [sorted.every((v, i) => i == 0 || sorted[i - 1] <= v), big[1] == 7919 % 3001 - 1500].join()
+    )"),
+              "true,true");
+
+    // shared buffers sort on a private copy of the keys
+    EXPECT_EQ(evalTestScript(R"(
+    var shared = new Float32Array(new SharedArrayBuffer(4 * 1000));
+    for (var i = 0; i < shared.length; i++) shared[i] = i % 3 ? (i * 31) % 997 - 500 : (i % 2 ? -0 : NaN);
+    shared.sort();
+    [shared.slice(0, -167).every((v, i, a) => i == 0 || a[i - 1] <= v), shared.slice(-167).every(isNaN), Object.is(shared[shared.indexOf(0)], -0)].join()
+    )"),
+              "true,true,true");
+}
+
+TEST(EvalScript, ArraySortComparators)
+{
+    // default and recognized comparators sort on precomputed keys, anything else falls back to calling the comparator
+    EXPECT_EQ(evalTestScript("[10, 9, 1, undefined, , 100, 'b', null, true].sort().join('|')"), "1|10|100|9|b||true||");
+    EXPECT_EQ(evalTestScript("[3, -0, 2, 0, Infinity, -Infinity, 1].sort((a, b) => a - b).join(' ')"), "-Infinity 0 0 1 2 3 Infinity");
+    EXPECT_EQ(evalTestScript("[3, 1, 2, undefined, 5].sort(function (x, y) { return y - x; }).join(' ')"), "5 3 2 1 ");
+
+    // property comparators keep the sort stable
+    evalTestScript("var people = [{ n: 'c', age: 3 }, { n: 'a', age: 1 }, { n: 'b', age: 3 }, { n: 'd', age: 2 }];");
+    EXPECT_EQ(evalTestScript("people.sort((a, b) => a.age - b.age).map(p => p.n).join('')"), "adcb");
+    EXPECT_EQ(evalTestScript("people.sort((a, b) => b.age - a.age).map(p => p.n).join('')"), "cbda");
+
+    EXPECT_EQ(evalTestScript("var calls = 0; [{ get age() { calls++; return 2; } }, { age: 1 }].sort((a, b) => a.age - b.age).map(p => p.age).join(' ') + ' ' + (calls > 0)"), "1 2 true");
+    EXPECT_EQ(evalTestScript("[2, '10', 1].sort((a, b) => a - b).join(' ')"), "1 2 10");
+    // automatic semicolon insertion makes this comparator return undefined
+    EXPECT_EQ(evalTestScript("[3, 1, 2].sort((a, b) => { return\n a - b; }).join(' ')"), "3 1 2");
+
+    EXPECT_EQ(evalTestScript(R"(
+    var sorted = [];
+    for (var i = 0; i < 1000; i++) sorted.push(i % 2 ? i : 1000 - i);
+    sorted.sort((a, b) => a - b);
+    sorted.every((v, i) => i == 0 || sorted[i - 1] <= v)
+    )"),
+              "true");
+}
+
+TEST(EvalScript, ArrayIterationFastPaths)
+{
+    // callbacks mutating the receiver drop the fast paths mid-iteration
+    EXPECT_EQ(evalTestScript("var a = [1, 2, , 4, 5], seen = []; a.forEach(function (v, i, o) { if (i == 0) o.pop(); seen.push(v); }); seen.join()"), "1,2,4");
+    EXPECT_EQ(evalTestScript("[a.every(v => v < 5), a.some(v => v == 4)].join()"), "true,true");
+    EXPECT_EQ(evalTestScript("[1, 2, 3, 4, 5, 6].filter(function (v, i, o) { if (i == 1) o.length = 4; return v % 2 == 0; }).join()"), "2,4");
+    EXPECT_EQ(evalTestScript("[1, , 3].filter(v => true).length"), "2");
+    EXPECT_EQ(evalTestScript("[1, 2, 3, 4].reduce((acc, v, i, o) => { if (i == 1) o.push(9); return acc + v; })"), "10");
+    EXPECT_EQ(evalTestScript("[1, 2, , 4].reduceRight((acc, v) => acc + ',' + v)"), "4,2,1");
+    EXPECT_EQ(evalTestScript("[[5, , 7].find(v => v === undefined), [5, , 7].findIndex(v => v === undefined)].join()"), ",1");
+    EXPECT_EQ(evalTestScript("[1, 2, 3].map(function (v, i, o) { if (i == 0) o[5] = 1; return v * 2; }).join()"), "2,4,6");
+    EXPECT_EQ(evalTestScript("var g = [1, 2, 3, 4], seen = []; g.forEach(function (v, i) { if (i == 0) g.shift(); seen.push(v); }); seen.join()"), "1,3,4");
+
+    // splice returns the removed run and leaves holes in place
+    EXPECT_EQ(evalTestScript("var c = [0, 1, 2, 3, 4, 5, , 7]; [c.splice(2, 3).join(), c.join(), c.length].join('|')"), "2,3,4|0,1,5,,7|5");
+    EXPECT_EQ(evalTestScript("var d = [0, 1, 2]; [d.splice(1, 1, 'x', 'y', 'z').join(), d.join(), d.length].join('|')"), "1|0,x,y,z,2|5");
+    EXPECT_EQ(evalTestScript("var e = [1, 2, 3]; [e.splice(1).join(), e.length, e.splice(0, 0, 7, 8).length, e.join()].join('|')"), "2,3|1|0|7,8,1");
+    EXPECT_EQ(evalTestScript("try { Object.freeze([1, 2, 3]).splice(0, 1); } catch (err) { err.constructor.name }"), "TypeError");
+}
+
+TEST(EvalScript, TypedArrayBulkKernels)
+{
+    // set, construction, fill, copyWithin and search over every element type
+    evalTestScript(R"(
+    var bulkSource = new Float64Array([1.5, -1.5, 300, -300, NaN, 65537, -0, 3e9]);
+    function bulkKernels(T) {
+        var a = new T(10);
+        a.set(bulkSource, 1);
+        var b = new T(new Int16Array([-1, 300, 7]));
+        var c = new T(8).fill(-129, 1, 7);
+        c.copyWithin(2, 0, 5);
+        return [a.join(), b.join(), c.join(), a.includes(NaN), a.indexOf(1), a.lastIndexOf(0)].join("/");
+    }
+    function bigIntKernels(T) {
+        var a = new T([1n, -1n, 2n ** 63n]);
+        var b = new T(4).fill(-2n, 1);
+        b.set(new BigInt64Array([5n, -5n]), 2);
+        var c = new T(new (T === BigInt64Array ? BigUint64Array : BigInt64Array)(a));
+        return [a.join(), b.join(), c.join(), a.indexOf(-1n), a.includes(2n ** 63n)].join("/");
+    }
+    )");
+
+    const std::pair<const char*, const char*> cases[] = {
+        { "bulkKernels(Int8Array)", "0,1,-1,44,-44,0,1,0,0,0/-1,44,7/0,127,0,127,127,127,127,0/false/1/9" },
+        { "bulkKernels(Uint8Array)", "0,1,255,44,212,0,1,0,0,0/255,44,7/0,127,0,127,127,127,127,0/false/1/9" },
+        { "bulkKernels(Uint8ClampedArray)", "0,2,0,255,0,0,255,0,255,0/0,255,7/0,0,0,0,0,0,0,0/false/-1/9" },
+        { "bulkKernels(Int16Array)", "0,1,-1,300,-300,0,1,0,24064,0/-1,300,7/0,-129,0,-129,-129,-129,-129,0/false/1/9" },
+        { "bulkKernels(Uint16Array)", "0,1,65535,300,65236,0,1,0,24064,0/65535,300,7/0,65407,0,65407,65407,65407,65407,0/false/1/9" },
+        { "bulkKernels(Int32Array)", "0,1,-1,300,-300,0,65537,0,-1294967296,0/-1,300,7/0,-129,0,-129,-129,-129,-129,0/false/1/9" },
+        { "bulkKernels(Uint32Array)", "0,1,4294967295,300,4294966996,0,65537,0,3000000000,0/4294967295,300,7/0,4294967167,0,4294967167,4294967167,4294967167,4294967167,0/false/1/9" },
+        { "bulkKernels(Float16Array)", "0,1.5,-1.5,300,-300,NaN,Infinity,0,Infinity,0/-1,300,7/0,-129,0,-129,-129,-129,-129,0/true/-1/9" },
+        { "bulkKernels(Float32Array)", "0,1.5,-1.5,300,-300,NaN,65537,0,3000000000,0/-1,300,7/0,-129,0,-129,-129,-129,-129,0/true/-1/9" },
+        { "bulkKernels(Float64Array)", "0,1.5,-1.5,300,-300,NaN,65537,0,3000000000,0/-1,300,7/0,-129,0,-129,-129,-129,-129,0/true/-1/9" },
+        { "bigIntKernels(BigInt64Array)", "1,-1,-9223372036854775808/0,-2,5,-5/1,-1,-9223372036854775808/1/false" },
+        { "bigIntKernels(BigUint64Array)", "1,18446744073709551615,9223372036854775808/0,18446744073709551614,5,18446744073709551611/1,18446744073709551615,9223372036854775808/-1/true" },
+    };
+    for (const auto& c : cases) {
+        SCOPED_TRACE(c.first);
+        EXPECT_EQ(evalTestScript(c.first), c.second);
+    }
+
+    // a species constructor returning an overlapping view copies element by element
+    evalTestScript("var d = new Uint8Array([1, 2, 3, 4, 5, 6]); d.constructor = { [Symbol.species]: function (n) { return new Uint8Array(d.buffer, 2, n); } };");
+    EXPECT_EQ(evalTestScript("d.slice(0, 4).join()"), "1,2,1,2");
+    EXPECT_EQ(evalTestScript("d.join()"), "1,2,1,2,1,2");
+    EXPECT_EQ(evalTestScript("var e = new Float32Array([1.25, -7, NaN]); e.constructor = { [Symbol.species]: Int16Array }; e.slice().join()"), "1,-7,0");
+    EXPECT_EQ(evalTestScript("try { new Int8Array(new BigInt64Array(0)); } catch (err) { err.constructor.name }"), "TypeError");
+}
+
+TEST(EvalScript, ResizableArrayBufferGrowth)
+{
+    // large buffers grow in place; views stay valid and shrunk bytes read as zero after regrowth
+    int64_t committedBase = s_committedArrayBufferSize;
+    evalTestScript(R"(
+    var rab = new ArrayBuffer(16, { maxByteLength: 64 * 1024 * 1024 });
+    var u8 = new Uint8Array(rab);
+    var fixed = new Uint32Array(rab, 8, 2);
+    u8[15] = 7;
+    )");
+    EXPECT_EQ(evalTestScript("rab.resize(32 * 1024 * 1024); [u8.length, u8[15], u8[u8.length - 1], fixed[1]].join()"), "33554432,7,0,117440512");
+    // only the committed pages are reported, not the reservation
+    EXPECT_EQ(s_committedArrayBufferSize - committedBase, 32 * 1024 * 1024);
+    EXPECT_EQ(evalTestScript("u8[u8.length - 1] = 9; u8.fill(3, 1000000, 1000010); rab.resize(100); [u8.length, u8[99], fixed.length].join()"), "100,0,2");
+    EXPECT_TRUE(s_committedArrayBufferSize - committedBase > 0 && s_committedArrayBufferSize - committedBase <= 64 * 1024);
+    EXPECT_EQ(evalTestScript("rab.resize(2000000); [u8[1000000], u8[1999999], u8[15]].join()"), "0,0,7");
+    EXPECT_TRUE(s_committedArrayBufferSize - committedBase >= 2000000 && s_committedArrayBufferSize - committedBase <= 2000000 + 64 * 1024);
+    EXPECT_EQ(evalTestScript("try { rab.resize(64 * 1024 * 1024 + 1); } catch (e) { e.constructor.name }"), "RangeError");
+
+    evalTestScript("var gsab = new SharedArrayBuffer(8, { maxByteLength: 16 * 1024 * 1024 });");
+    committedBase = s_committedArrayBufferSize;
+    EXPECT_EQ(evalTestScript(R"(
+    var s8 = new Uint8Array(gsab);
+    s8[7] = 1;
+    gsab.grow(8 * 1024 * 1024);
+    s8[s8.length - 1] = 2;
+    [s8.length, s8[7], s8[s8.length - 1], s8[4096]].join()
+    )"),
+              "8388608,1,2,0");
+    // the first page was committed on creation
+    EXPECT_TRUE(s_committedArrayBufferSize - committedBase < 8 * 1024 * 1024 && s_committedArrayBufferSize - committedBase >= 8 * 1024 * 1024 - 64 * 1024);
+}
+
+static std::string toJSStringLiteral(const std::u16string& str)
+{
+    std::string literal = "'";
+    char buf[8];
+    for (char16_t ch : str) {
+        snprintf(buf, sizeof(buf), "\\u%04x", static_cast<unsigned>(ch));
+        literal += buf;
+    }
+    return literal + "'";
+}
+
+TEST(StringSearch, IndexOf)
+{
+    // needles of 1 (single character scan), 2, 16 and 17 characters (candidate scan on the
+    // first and last character, then verification) placed around the 16 byte blocks of the scan
+    const std::u16string latin1Needle = u"abcdefghijklmnépq";
+    const std::u16string utf16Needle = u"あbédefghijklmn一pq";
+    const size_t needleLengths[] = { 1, 2, 16, 17 };
+    const size_t haystackLength = 72;
+
+    for (int wideHaystack = 0; wideHaystack < 2; wideHaystack++) {
+        for (int wideNeedle = 0; wideNeedle < 2; wideNeedle++) {
+            for (size_t needleLength : needleLengths) {
+                std::u16string needle = (wideNeedle ? utf16Needle : latin1Needle).substr(0, needleLength);
+                // a decoy that only differs in its middle or last character
+                std::u16string decoy = needle;
+                decoy[needleLength / 2] = u'z';
+                if (needleLength > 1) {
+                    decoy[needleLength - 1] = u'y';
+                }
+
+                const size_t positions[] = { 0, 14, 15, 16, 17, 31, 32, 33, 47, haystackLength - needleLength, SIZE_MAX };
+                for (size_t position : positions) {
+                    std::u16string haystack(haystackLength, wideHaystack ? u'い' : u'x');
+                    haystack.replace(haystackLength - needleLength, needleLength, decoy);
+                    haystack.replace(3, needleLength, decoy);
+                    if (position != SIZE_MAX) {
+                        haystack.replace(position, needleLength, needle);
+                    }
+
+                    char expected[64];
+                    size_t first = haystack.find(needle);
+                    size_t last = haystack.rfind(needle);
+                    snprintf(expected, sizeof(expected), "%d,%d,%s", first == std::u16string::npos ? -1 : (int)first,
+                             last == std::u16string::npos ? -1 : (int)last, first == std::u16string::npos ? "false" : "true");
+
+                    std::string source = "var h = " + toJSStringLiteral(haystack) + ", n = " + toJSStringLiteral(needle) + "; h.indexOf(n) + ',' + h.lastIndexOf(n) + ',' + h.includes(n)";
+                    SCOPED_TRACE(source);
+                    auto s = evalScript(g_context.get(), StringRef::createFromUTF8(source.data(), source.length()), StringRef::createFromASCII("test.js"), false);
+                    EXPECT_EQ(s, expected);
+                }
+            }
+        }
+    }
+}
+
+TEST(StringSearch, MixedWidthEquals)
+{
+    // a long slice of a two-byte string is a view on two-byte storage, so === compares UTF-16 against Latin1
+    const size_t lengths[] = { 25, 31, 32, 33, 48, 49 };
+    for (size_t length : lengths) {
+        char source[256];
+        snprintf(source, sizeof(source), "var latin1 = 'a\\u00e9'.repeat(%zu).slice(0, %zu); var wide = ('\\u3042' + latin1).slice(1);"
+                                         "[wide === latin1, wide === latin1.slice(0, -1) + 'z', wide.slice(0, -1) === latin1.slice(0, -1)].join()",
+                 length, length);
+        SCOPED_TRACE(source);
+        auto s = evalScript(g_context.get(), StringRef::createFromASCII(source, strlen(source)), StringRef::createFromASCII("test.js"), false);
+        EXPECT_EQ(s, "true,false,true");
+    }
+}
+
+// the lexer skips over 8-bit sources in blocks, and over 16-bit sources one character at a time,
+// so the same source made of Latin1 characters should give the same result either way
+static std::string expectSameResultAs16Bit(const std::string& source)
+{
+    std::u16string wide;
+    for (char ch : source) {
+        wide.push_back(static_cast<unsigned char>(ch));
+    }
+    StringRef* fileName = StringRef::createFromASCII("lexer.js");
+    auto s8 = evalScript(g_context.get(), StringRef::createFromLatin1(reinterpret_cast<const unsigned char*>(source.data()), source.length()), fileName, false);
+    auto s16 = evalScript(g_context.get(), StringRef::createFromUTF16(wide.data(), wide.length()), fileName, false);
+    EXPECT_EQ(s8, s16);
+    return s8;
+}
+
+TEST(Lexer, BlockScanBoundaries)
+{
+    // characters the block scan has to stop at, placed around the first and second block boundary
+    // after the point where a scan starts (after the quote, the comment opener or the first identifier character)
+    const std::string latin1 = "\xE9";
+    const std::string tail(20, 'y');
+    const size_t offsets[] = { 0, 1, 14, 15, 16, 17, 30, 31, 32, 33 };
+    for (size_t offset : offsets) {
+        SCOPED_TRACE(offset);
+        const std::string pad(offset, 'x');
+
+        const std::string stringParts[] = { "\\'", "\"", "\\\\", "\\\n", "\\\r\n", "\\\r", "\\x41", "\\u00e9", latin1, "\\'" + pad + latin1, "*/", "\n", "\r" };
+        for (const std::string& part : stringParts) {
+            expectSameResultAs16Bit("var s = '" + pad + part + tail + "'; s.length + ' ' + escape(s)");
+        }
+        EXPECT_EQ(expectSameResultAs16Bit("'" + pad + "\\'" + tail + "'.indexOf(\"'\")"), std::to_string(offset));
+        EXPECT_EQ(expectSameResultAs16Bit("'" + pad + latin1 + tail + "'.charCodeAt(" + std::to_string(offset) + ")"), "233");
+        EXPECT_EQ(expectSameResultAs16Bit("'" + pad + "\\\r\n" + tail + "'.length"), std::to_string(offset + tail.length()));
+        EXPECT_EQ(expectSameResultAs16Bit("\"" + pad + "'" + tail + "\".length"), std::to_string(offset + tail.length() + 1));
+        EXPECT_EQ(expectSameResultAs16Bit("'" + pad + "\n" + tail + "'").find("SyntaxError"), 0u + std::string("Script parsing error: ").length());
+
+        // line terminators end single-line comments and count as line breaks in multi-line ones,
+        // which the error locations show
+        const std::string commentParts[] = { latin1, "*/", "/*", "'", "\\", "*", "**", "* /", "\n", "\r", "\r\n" };
+        for (const std::string& part : commentParts) {
+            expectSameResultAs16Bit("//" + pad + part + tail + "\nthrow new Error('c')");
+            expectSameResultAs16Bit("/*" + pad + part + tail + "*/throw new Error('c')");
+        }
+        EXPECT_EQ(expectSameResultAs16Bit("//" + pad + latin1 + "\r\n\nthrow 1"), "Uncaught 1:\nlexer.js (3:7)\n");
+        EXPECT_EQ(expectSameResultAs16Bit("/*" + pad + "*\n" + tail + "**/throw 1"), "Uncaught 1:\nlexer.js (2:30)\n");
+        // a line break in a comment is enough for automatic semicolon insertion
+        EXPECT_EQ(expectSameResultAs16Bit("var a = 1 /*" + pad + "\n" + tail + "*/ var b = 2; a + b"), "3");
+        EXPECT_EQ(expectSameResultAs16Bit("/*" + pad + "*/'done'"), "done");
+        EXPECT_EQ(expectSameResultAs16Bit("/*" + pad + "*").find("SyntaxError"), 0u + std::string("Script parsing error: ").length());
+        EXPECT_EQ(expectSameResultAs16Bit("1 //" + pad), "1");
+
+        // identifiers stop at anything but [A-Za-z0-9_$], where the scalar loop checks escapes and non-ASCII parts;
+        // the ASCII neighbours of each range end the identifier
+        const std::string identifierParts[] = { "$", "_", "0", "9", "A", "Z", "a", "z", "\\u0062", latin1, "\xAA", "\xB5", "\xB7", "\xD7", "@", "[", "`", "{", "/", ":", " " };
+        for (const std::string& part : identifierParts) {
+            const std::string identifier = "a" + pad + part + tail;
+            expectSameResultAs16Bit("var " + identifier + " = 7; " + identifier);
+        }
+        EXPECT_EQ(expectSameResultAs16Bit("var a" + pad + "\\u0062" + tail + " = 7; a" + pad + "b" + tail), "7");
+        EXPECT_EQ(expectSameResultAs16Bit("var q" + pad + latin1 + tail + " = 7; typeof q" + pad), "undefined");
+        EXPECT_EQ(expectSameResultAs16Bit("var a" + pad + "\xD7" + tail + " = 7").find("SyntaxError"), 0u + std::string("Script parsing error: ").length());
+        EXPECT_EQ(expectSameResultAs16Bit("var a" + pad + tail + " = 8; a" + pad + tail), "8");
+    }
+}
+
 TEST(EvalScript, ParseError)
 {
     auto s = evalScript(g_context.get(), StringRef::createFromASCII("."), StringRef::createFromASCII("test.js"), false);
@@ -600,6 +1073,62 @@ TEST(EvalScript, RuntimeError)
     EXPECT_TRUE(s.find("Uncaught 1") == 0);
 }
 
+TEST(Context, GlobalObjectLayoutCache)
+{
+    // the second Context of a VMInstance starts from the cached global object layout
+    PersistentRefHolder<ContextRef> context = createEscargotContext(g_instance.get());
+    auto s = evalScript(context.get(), StringRef::createFromASCII("typeof Object.keys + typeof Function.prototype.call + typeof Iterator.from + typeof Array.from"), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "functionfunctionfunctionfunction");
+
+    s = evalScript(context.get(), StringRef::createFromASCII("Object.getOwnPropertyNames(globalThis).filter(function(name) { return name === 'Object'; }).length"), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "1");
+
+    s = evalScript(context.get(), StringRef::createFromASCII("var desc = Object.getOwnPropertyDescriptor(globalThis, 'Object'); '' + desc.writable + desc.enumerable + desc.configurable"), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "truefalsetrue");
+
+    // every builtin of the restored layout is reachable
+    s = evalScript(context.get(), StringRef::createFromASCII("Object.getOwnPropertyNames(globalThis).filter(function(name) { return globalThis[name] === undefined; }).join()"), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "undefined");
+
+#if defined(ENABLE_SHADOWREALM)
+    s = evalScript(context.get(), StringRef::createFromASCII("new ShadowRealm().evaluate('Object === globalThis.Object && Function === globalThis.Function && Iterator === globalThis.Iterator')"), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "true");
+    s = evalScript(g_context.get(), StringRef::createFromASCII("new ShadowRealm().evaluate('Object.keys({ a: 1, b: 2 }).join()')"), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "a,b");
+#endif
+}
+
+TEST(Context, LazyDisposableStack)
+{
+    PersistentRefHolder<ContextRef> context = createEscargotContext(g_instance.get());
+    auto s = evalScript(context.get(), StringRef::createFromASCII("var desc = Object.getOwnPropertyDescriptor(globalThis, 'DisposableStack'); typeof desc.value + desc.writable + desc.enumerable + desc.configurable"), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "functiontruefalsetrue");
+    s = evalScript(context.get(), StringRef::createFromASCII("var stack = new AsyncDisposableStack(); Object.prototype.toString.call(stack) + typeof stack.disposeAsync"), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "[object AsyncDisposableStack]function");
+
+    // deleting one name keeps the other one working
+    context = createEscargotContext(g_instance.get());
+    s = evalScript(context.get(), StringRef::createFromASCII("delete globalThis.AsyncDisposableStack; typeof globalThis.AsyncDisposableStack + typeof new DisposableStack().use"), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "undefinedfunction");
+
+    context = createEscargotContext(g_instance.get());
+    s = evalScript(context.get(), StringRef::createFromASCII("delete globalThis.DisposableStack; typeof globalThis.DisposableStack + typeof new AsyncDisposableStack().use"), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "undefinedfunction");
+
+    // another realm can still install the builtin after its name was replaced
+    context = createEscargotContext(g_instance.get());
+    ValueRef* newTarget = eval(context.get(), StringRef::createFromASCII("delete globalThis.DisposableStack; globalThis.DisposableStack = 1; function F() {}; F.prototype = null; F"));
+    Evaluator::execute(g_context.get(), [](ExecutionStateRef* state, ValueRef* newTarget) -> ValueRef* {
+        state->context()->globalObject()->defineDataProperty(state, StringRef::createFromASCII("otherRealmNewTarget"), newTarget, true, true, true);
+        return ValueRef::createUndefined();
+    },
+                       newTarget);
+    s = evalScript(g_context.get(), StringRef::createFromASCII("var stack = Reflect.construct(DisposableStack, [], otherRealmNewTarget); delete globalThis.otherRealmNewTarget; Object.getPrototypeOf(stack) === DisposableStack.prototype"), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "false");
+    s = evalScript(context.get(), StringRef::createFromASCII("DisposableStack"), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "1");
+}
+
 TEST(Object, ConstructorName)
 {
     ObjectRef* testObj = eval(g_context.get(), StringRef::createFromASCII("function foo(){}; var ctorNameTest = new foo(); ctorNameTest;"))->asObject();
@@ -1778,6 +2307,30 @@ TEST(BackingStore, Basic1)
     });
 }
 
+TEST(BackingStore, ReallocateReserved)
+{
+    // a resizable buffer of this size is backed by reserved address space
+    ValueRef* value = eval(g_context.get(), StringRef::createFromASCII("var rab = new ArrayBuffer(4, { maxByteLength: 4 * 1024 * 1024 }); new Uint8Array(rab).set([1, 2, 3, 4]); rab"));
+    ASSERT_TRUE(value->isArrayBufferObject());
+
+    Evaluator::execute(g_context.get(), [](ExecutionStateRef* state, ArrayBufferObjectRef* abo) -> ValueRef* {
+        BackingStoreRef* bs = abo->backingStore().get();
+
+        // within the reservation
+        bs->reallocate(1024);
+        EXPECT_TRUE(abo->byteLength() == 1024);
+        EXPECT_TRUE(static_cast<uint8_t*>(abo->rawBuffer())[3] == 4);
+
+        // past the reservation the contents move to a new allocation
+        bs->reallocate(8 * 1024 * 1024);
+        EXPECT_TRUE(abo->byteLength() == 8 * 1024 * 1024);
+        uint8_t* data = static_cast<uint8_t*>(abo->rawBuffer());
+        EXPECT_TRUE(data[0] == 1 && data[3] == 4 && data[1024] == 0 && data[8 * 1024 * 1024 - 1] == 0);
+        return ValueRef::createUndefined();
+    },
+                       value->asArrayBufferObject());
+}
+
 TEST(SharedArrayBufferObject, Basic1)
 {
     Evaluator::execute(g_context.get(), [](ExecutionStateRef* state) -> ValueRef* {
@@ -1882,6 +2435,23 @@ TEST(RegExp, Basic2)
     });
 }
 
+TEST(RegExp, Cache)
+{
+    size_t hitCount = g_instance->regExpCacheHitCount();
+    size_t missCount = g_instance->regExpCacheMissCount();
+
+    Evaluator::execute(g_context.get(), [](ExecutionStateRef* state) -> ValueRef* {
+        // equal sources should share a cache entry even if they are different strings
+        RegExpObjectRef::create(state, StringRef::createFromUTF8("cache[0-9]+test", 15), RegExpObjectRef::RegExpObjectOption::None);
+        RegExpObjectRef::create(state, StringRef::createFromUTF8("cache[0-9]+test", 15), RegExpObjectRef::RegExpObjectOption::Global);
+        return ValueRef::createUndefined();
+    });
+
+    EXPECT_EQ(g_instance->regExpCacheMissCount(), missCount + 1);
+    EXPECT_EQ(g_instance->regExpCacheHitCount(), hitCount + 1);
+    EXPECT_TRUE(g_instance->regExpCacheCompiledSize() > 0);
+}
+
 TEST(EnumerateObjectOwnProperties, Basic1)
 {
     Evaluator::execute(g_context.get(), [](ExecutionStateRef* state) -> ValueRef* {
@@ -2525,6 +3095,268 @@ TEST(ReloadableString, Basic)
         return ValueRef::createUndefined(); }, string, &d);
 }
 
+static const char bundleTestSource[] = R"(
+function outer(a) {
+    function inner(b) { return a * b; }
+    return inner;
+}
+var bundleLazy = function () { return "lazy:" + outer(6)(7); };
+[typeof outer, bundleLazy()].join()
+)";
+
+static std::string executeBundleScript(ContextRef* context, ScriptRef* script)
+{
+    auto evalResult = Evaluator::execute(context, [](ExecutionStateRef* state, ScriptRef* script) -> ValueRef* { return script->execute(state); }, script);
+    return evalResult.resultOrErrorToString(context)->toStdUTF8String();
+}
+
+struct ReloadableSourceData {
+    const char* source;
+    bool loaded;
+};
+
+// data should outlive the instance, which may unload the string on enterIdleMode
+static StringRef* createReloadableSource(VMInstanceRef* instance, ReloadableSourceData* data)
+{
+    return StringRef::createReloadableString(instance, true, strlen(data->source), data, [](void* callbackData) -> void* {
+        ReloadableSourceData* d = static_cast<ReloadableSourceData*>(callbackData);
+        size_t len = strlen(d->source);
+        void* ptr = malloc(len);
+        memcpy(ptr, d->source, len);
+        d->loaded = true;
+        return ptr; }, [](void* memoryPtr, void* callbackData) {
+        static_cast<ReloadableSourceData*>(callbackData)->loaded = false;
+        free(memoryPtr); });
+}
+
+#if defined(ENABLE_CODE_CACHE)
+TEST(CodeCacheBundle, RoundTrip)
+{
+    std::vector<char> bundle;
+    auto compileResult = g_context->scriptParser()->compileScriptBundle(StringRef::createFromASCII(bundleTestSource), StringRef::createFromASCII("bundle.js"), bundle);
+    ASSERT_TRUE(compileResult.script.hasValue());
+    ASSERT_TRUE(bundle.size() > 0);
+
+    ReloadableSourceData d = { bundleTestSource, false };
+    PersistentRefHolder<VMInstanceRef> instance = VMInstanceRef::create();
+    StringRef* source = createReloadableSource(instance.get(), &d);
+
+    // a fresh Context loads the global code and decodes each function from the bundle when it is first called,
+    // the source is only read for Function.prototype.toString
+    PersistentRefHolder<ContextRef> context = createEscargotContext(instance.get());
+    auto loadResult = context->scriptParser()->initializeScriptFromBundle(bundle.data(), bundle.size(), source, StringRef::createFromASCII("bundle.js"), false);
+    ASSERT_TRUE(loadResult.script.hasValue());
+    EXPECT_FALSE(d.loaded);
+    EXPECT_EQ(executeBundleScript(context.get(), loadResult.script.get()), "function,lazy:42");
+    EXPECT_FALSE(d.loaded);
+    EXPECT_EQ(evalScript(context.get(), StringRef::createFromASCII("bundleLazy() + outer(2)(3)"), StringRef::createFromASCII("test.js"), false), "lazy:426");
+    EXPECT_FALSE(d.loaded);
+
+    auto s = evalScript(context.get(), StringRef::createFromASCII("bundleLazy.toString() + '|' + outer(1).toString()"), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "function () { return \"lazy:\" + outer(6)(7); }|function inner(b) { return a * b; }");
+    EXPECT_TRUE(d.loaded);
+
+    context.release();
+    instance.release();
+}
+
+TEST(CodeCacheBundle, Rejection)
+{
+    StringRef* source = StringRef::createFromASCII(bundleTestSource);
+    StringRef* srcName = StringRef::createFromASCII("bundle.js");
+    std::vector<char> bundle;
+    g_context->scriptParser()->compileScriptBundle(source, srcName, bundle);
+    ASSERT_TRUE(bundle.size() > 0);
+
+    PersistentRefHolder<ContextRef> context = createEscargotContext(g_instance.get());
+    auto load = [&](const std::vector<char>& data, size_t size, StringRef* source, bool verifySourceHash) -> std::string {
+        auto result = context->scriptParser()->initializeScriptFromBundle(data.data(), size, source, srcName, verifySourceHash);
+        if (!result.script) {
+            return "rejected";
+        }
+        return executeBundleScript(context.get(), result.script.get());
+    };
+    EXPECT_EQ(load(bundle, bundle.size(), source, false), "function,lazy:42");
+    EXPECT_EQ(load(bundle, bundle.size(), source, true), "function,lazy:42");
+
+    const size_t truncatedSizes[] = { 0, 7, 64, bundle.size() / 2, bundle.size() - 1 };
+    for (size_t size : truncatedSizes) {
+        SCOPED_TRACE(size);
+        EXPECT_EQ(load(bundle, size, source, false), "rejected");
+    }
+
+    // every byte is covered by a checksum: a flipped byte is rejected at load time, or when the function
+    // it belongs to is first called, which then falls back to parsing the source
+    size_t rejectedCount = 0;
+    for (size_t i = 0; i < bundle.size(); i++) {
+        std::vector<char> flipped = bundle;
+        flipped[i] ^= 0x5a;
+        auto s = load(flipped, flipped.size(), source, true);
+        if (s == "rejected") {
+            rejectedCount++;
+        } else {
+            EXPECT_EQ(s, "function,lazy:42") << "flipped byte " << i;
+        }
+        // the header and the entry list are checked before anything is loaded
+        if (i < 64) {
+            EXPECT_EQ(s, "rejected") << "flipped byte " << i;
+        }
+    }
+    EXPECT_TRUE(rejectedCount >= 64);
+
+    std::string longer = std::string(bundleTestSource) + " ";
+    EXPECT_EQ(load(bundle, bundle.size(), StringRef::createFromASCII(longer.data(), longer.length()), false), "rejected");
+
+    // only the length is compared by default, so another source of the same length runs the bundled code
+    std::string sameLength = bundleTestSource;
+    sameLength.replace(sameLength.find("lazy:"), 5, "LAZY:");
+    EXPECT_EQ(load(bundle, bundle.size(), StringRef::createFromASCII(sameLength.data(), sameLength.length()), false), "function,lazy:42");
+    EXPECT_EQ(load(bundle, bundle.size(), StringRef::createFromASCII(sameLength.data(), sameLength.length()), true), "rejected");
+}
+
+TEST(CodeCacheBundle, CodeCacheDisabled)
+{
+    // no cache directory can be made under /dev/null, so the code cache of this VMInstance stays disabled
+    PersistentRefHolder<VMInstanceRef> instance = VMInstanceRef::create(nullptr, nullptr, "/dev/null");
+    PersistentRefHolder<ContextRef> context = createEscargotContext(instance.get());
+
+    StringRef* source = StringRef::createFromASCII(bundleTestSource);
+    std::vector<char> bundle;
+    auto compileResult = context->scriptParser()->compileScriptBundle(source, StringRef::createFromASCII("bundle.js"), bundle);
+    ASSERT_TRUE(compileResult.script.hasValue());
+    ASSERT_TRUE(bundle.size() > 0);
+
+    auto loadResult = context->scriptParser()->initializeScriptFromBundle(bundle.data(), bundle.size(), source, StringRef::createFromASCII("bundle.js"), false);
+    ASSERT_TRUE(loadResult.script.hasValue());
+    EXPECT_EQ(executeBundleScript(context.get(), loadResult.script.get()), "function,lazy:42");
+
+    context.release();
+    instance.release();
+}
+
+TEST(CodeCacheBundle, ParallelCompile)
+{
+    const char source[] = R"(
+    function a(x) { return x + 1; }
+    function b(x) { function c(y) { return y * 2; } return c(a(x)); }
+    var d = (function () { var e = function (z) { return "e" + z; }; return e; })();
+    class K { m() { return b(3); } get g() { return d(4); } }
+    var k = new K();
+    [a(1), b(2), d(3), k.m(), k.g].join()
+    )";
+
+    // threadCount 16 leaves some workers without a function
+    const size_t threadCounts[] = { 1, 4, 16 };
+    std::vector<char> bundles[3];
+    for (size_t i = 0; i < 3; i++) {
+        auto compileResult = g_context->scriptParser()->compileScriptBundle(StringRef::createFromASCII(source), StringRef::createFromASCII("parallel.js"), bundles[i], threadCounts[i]);
+        ASSERT_TRUE(compileResult.script.hasValue());
+        ASSERT_TRUE(bundles[i].size() > 0);
+    }
+    // the merged bundles hold the same entries, in another order
+    EXPECT_EQ(bundles[1].size(), bundles[0].size());
+    EXPECT_EQ(bundles[2].size(), bundles[0].size());
+
+    // every function is found in the merged bundles, so the source is never read
+    ReloadableSourceData data[3] = { { source, false }, { source, false }, { source, false } };
+    PersistentRefHolder<VMInstanceRef> instance = VMInstanceRef::create();
+    for (size_t i = 0; i < 3; i++) {
+        SCOPED_TRACE(threadCounts[i]);
+        PersistentRefHolder<ContextRef> context = createEscargotContext(instance.get());
+        auto loadResult = context->scriptParser()->initializeScriptFromBundle(bundles[i].data(), bundles[i].size(), createReloadableSource(instance.get(), &data[i]), StringRef::createFromASCII("parallel.js"), false);
+        ASSERT_TRUE(loadResult.script.hasValue());
+        EXPECT_EQ(executeBundleScript(context.get(), loadResult.script.get()), "2,6,e3,8,e4");
+        EXPECT_FALSE(data[i].loaded);
+    }
+    instance.release();
+}
+#endif
+
+TEST(ParallelCompile, HotFunctions)
+{
+    const std::string source = R"(
+    function used(x) { return x + 1; }
+    function unused(x) { return x - 1; }
+    var iife = (function () { function helper(y) { return y * 2; } return helper(used(1)); })();
+    var later = function (z) { return "later" + z; };
+    [iife, used(2)].join()
+    )";
+    const size_t laterStart = source.find("function (z)");
+    const size_t unusedStart = source.find("function unused");
+
+    // the results do not depend on whether a worker is done before a function is called
+    std::vector<size_t> profile;
+    PersistentRefHolder<VMInstanceRef> instance = VMInstanceRef::create();
+    for (size_t i = 0; i < 2; i++) {
+        PersistentRefHolder<ContextRef> context = createEscargotContext(instance.get());
+        auto result = context->scriptParser()->initializeScriptWithParallelCompile(StringRef::createFromUTF8(source.data(), source.length()), StringRef::createFromASCII("hot.js"), 2, profile);
+        ASSERT_TRUE(result.script.hasValue());
+        EXPECT_EQ(executeBundleScript(context.get(), result.script.get()), "4,3");
+        EXPECT_EQ(evalScript(context.get(), StringRef::createFromASCII("later(1)"), StringRef::createFromASCII("test.js"), false), "later1");
+
+        // the functions called in this run make the profile of the next one
+        profile = result.script->compiledFunctionStarts();
+        EXPECT_TRUE(std::find(profile.begin(), profile.end(), laterStart) != profile.end());
+        EXPECT_TRUE(std::find(profile.begin(), profile.end(), unusedStart) == profile.end());
+        EXPECT_EQ(profile.size(), 4u);
+    }
+    instance.release();
+}
+
+TEST(BackgroundParse, Basic)
+{
+    ReloadableSourceData d = { bundleTestSource, false };
+    PersistentRefHolder<VMInstanceRef> instance = VMInstanceRef::create();
+    PersistentRefHolder<ContextRef> context = createEscargotContext(instance.get());
+    auto task = context->scriptParser()->startBackgroundParse(createReloadableSource(instance.get(), &d), StringRef::createFromASCII("background.js"));
+    // an event loop would keep running other work here
+    while (!ScriptParserRef::isBackgroundParseDone(task)) {
+        std::this_thread::yield();
+    }
+    EXPECT_TRUE(ScriptParserRef::isBackgroundParseDone(task));
+
+    // the worker got its own copy of the source. the bundle it made is loaded without reading the source again
+    instance->enterIdleMode();
+    EXPECT_FALSE(d.loaded);
+    auto result = context->scriptParser()->finishBackgroundParse(task);
+    ASSERT_TRUE(result.script.hasValue());
+#if defined(ENABLE_CODE_CACHE) && defined(ENABLE_THREADING)
+    EXPECT_FALSE(d.loaded);
+#endif
+    // only the global code comes from the worker, functions are compiled from the source when called
+    EXPECT_EQ(executeBundleScript(context.get(), result.script.get()), "function,lazy:42");
+    EXPECT_TRUE(d.loaded);
+    EXPECT_EQ(evalScript(context.get(), StringRef::createFromASCII("bundleLazy.toString()"), StringRef::createFromASCII("test.js"), false), "function () { return \"lazy:\" + outer(6)(7); }");
+
+    context.release();
+    instance.release();
+}
+
+TEST(BackgroundParse, SyntaxError)
+{
+    const char source[] = "var ok = 1;\nfunction f() { return ok + ; }";
+
+#if defined(ENABLE_CODE_CACHE)
+    // a script that does not parse gives no bundle
+    std::vector<char> bundle;
+    auto compileResult = g_context->scriptParser()->compileScriptBundle(StringRef::createFromASCII(source), StringRef::createFromASCII("error.js"), bundle);
+    EXPECT_FALSE(compileResult.script.hasValue());
+    EXPECT_TRUE(bundle.empty());
+#endif
+
+    // finishBackgroundParse parses again on the owning Context, and reports the same error as a parse on this thread
+    PersistentRefHolder<ContextRef> context = createEscargotContext(g_instance.get());
+    auto task = context->scriptParser()->startBackgroundParse(StringRef::createFromASCII(source), StringRef::createFromASCII("error.js"));
+    auto result = context->scriptParser()->finishBackgroundParse(task);
+    EXPECT_FALSE(result.script.hasValue());
+    EXPECT_EQ(result.parseErrorCode, ErrorObjectRef::Code::SyntaxError);
+
+    auto expected = context->scriptParser()->initializeScript(StringRef::createFromASCII(source), StringRef::createFromASCII("error.js"));
+    EXPECT_FALSE(expected.script.hasValue());
+    EXPECT_EQ(result.parseErrorMessage->toStdUTF8String(), expected.parseErrorMessage->toStdUTF8String());
+    EXPECT_EQ(evalScript(context.get(), StringRef::createFromASCII("typeof ok"), StringRef::createFromASCII("test.js"), false), "undefined");
+}
+
 TEST(DisabledStackOverflow, Basic)
 {
     Evaluator::execute(g_context.get(), [](ExecutionStateRef* state) -> ValueRef* {
@@ -3020,6 +3852,74 @@ TEST(WeakPtr, WeakMap)
     instance.release();
 }
 
+TEST(WeakPtr, WeakMapEphemeron)
+{
+    PersistentRefHolder<VMInstanceRef> instance = VMInstanceRef::create();
+    PersistentRefHolder<ContextRef> context = createEscargotContext(instance.get());
+
+    // a value which refers to its own key must not keep the entry alive
+    PersistentRefHolder<ObjectRef> key;
+    PersistentRefHolder<ObjectRef> value;
+    PersistentRefHolder<ValueRef> map = Evaluator::execute(context.get(), [](ExecutionStateRef* state, PersistentRefHolder<ObjectRef>* key, PersistentRefHolder<ObjectRef>* value) -> ValueRef* {
+        auto wm = WeakMapObjectRef::create(state);
+        *key = ObjectRef::create(state);
+        *value = ObjectRef::create(state);
+        value->get()->set(state, StringRef::createFromASCII("key"), key->get());
+        wm->set(state, key->get(), value->get());
+        return wm; }, &key, &value).result;
+
+    // clear stack
+    Evaluator::execute(context.get(), [](ExecutionStateRef* state, StringRef* s) -> ValueRef* { return ValueRef::create(100); }, StringRef::createFromUTF8("qwer"));
+
+    key.setWeak();
+    value.setWeak();
+
+    for (size_t i = 0; i < 100; i++) {
+        PersistentRefHolder<StringRef> dummy = StringRef::createFromUTF8("asdf");
+    }
+    Memory::gc();
+    Memory::gc();
+    Memory::gc();
+    Memory::gc();
+    Memory::gc();
+
+    EXPECT_TRUE(map.get() != nullptr);
+    EXPECT_TRUE(key.get() == nullptr);
+    EXPECT_TRUE(value.get() == nullptr);
+
+    // memoization cache workload with many short-lived keys
+    // (timed at full size by the weakmap-memoization runner of tools/run-tests.py)
+    evalScript(context.get(), StringRef::createFromASCII(R"(
+    var memo = new WeakMap(), computed = 0;
+    function area(r) {
+        var v = memo.get(r);
+        if (v === undefined) { computed++; v = r.w * r.h; memo.set(r, v); }
+        return v;
+    }
+    var rects = [];
+    for (var i = 0; i < 20000; i++) rects.push({ w: i % 7, h: i % 11 });
+    var sum = 0;
+    for (var round = 0; round < 3; round++) for (var i = 0; i < rects.length; i += 1 + round) sum += area(rects[i]);
+    for (var i = 0; i < rects.length; i += 2) memo.delete(rects[i]);
+    rects.length = 1000;
+    )"),
+               StringRef::createFromASCII("test.js"), false);
+    Memory::gc();
+    auto s = evalScript(context.get(), StringRef::createFromASCII(R"(
+    var hits = 0;
+    for (var i = 0; i < rects.length; i++) if (memo.has(rects[i])) hits++;
+    var seen = new WeakSet(), sym = Symbol("s");
+    seen.add(sym); seen.add(rects[1]); seen.delete(rects[1]);
+    [computed, sum, hits, seen.has(sym), seen.has(rects[1]), memo.get(rects[3])].join();
+    )"),
+                        StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "20000,549881,500,true,false,9");
+
+    map.release();
+    context.release();
+    instance.release();
+}
+
 static void finalizerTester(void* obj, void* data)
 {
     (*((size_t*)data))++;
@@ -3109,3 +4009,42 @@ TEST(EvaluateJob, Job)
     context.release();
     instance.release();
 }
+
+TEST(EvaluateJob, BatchedDraining)
+{
+    PersistentRefHolder<VMInstanceRef> instance = VMInstanceRef::create();
+    PersistentRefHolder<ContextRef> context = createEscargotContext(instance.get());
+
+    eval(context.get(), StringRef::createFromASCII("var n = 0; for (var i = 0; i < 200; i++) { Promise.resolve(i).then(function(v) { n += v; }); }"));
+    EXPECT_EQ(instance->pendingJobCount(), 200u);
+    EXPECT_TRUE(instance->pendingJobHighWaterMark() >= 200u);
+
+    size_t executed = 0;
+    auto result = instance->executePendingJobs(50, 0, &executed);
+    EXPECT_TRUE(result.isSuccessful());
+    EXPECT_EQ(executed, 50u);
+    EXPECT_EQ(instance->pendingJobCount(), 150u);
+
+    instance->enqueueEvaluateJob(context, [](ExecutionStateRef* state, void* data) -> ValueRef* {
+        state->throwException(ValueRef::create(7));
+        return ValueRef::createUndefined(); }, nullptr);
+
+    // stops at the throwing job which was queued last
+    auto throwingResult = instance->executePendingJobs(1000, 0, &executed);
+    EXPECT_FALSE(throwingResult.isSuccessful());
+    EXPECT_EQ(executed, 151u);
+    EXPECT_EQ(instance->pendingJobCount(), 0u);
+
+    auto emptyResult = instance->executePendingJobs(1000, 0, &executed);
+    EXPECT_TRUE(emptyResult.isSuccessful());
+    EXPECT_TRUE(emptyResult.result->isUndefined());
+    EXPECT_EQ(executed, 0u);
+
+    instance->resetPendingJobHighWaterMark();
+    EXPECT_EQ(instance->pendingJobHighWaterMark(), 0u);
+    ValueRef* sum = eval(context.get(), StringRef::createFromASCII("n"));
+    EXPECT_TRUE(sum->isInt32() && sum->asInt32() == 19900);
+
+    context.release();
+    instance.release();
+}
@@ -158,6 +158,39 @@ def run_octane_loading(engine, arch, extra_arg):
          cwd=OCTANE_DIR)
 
 
+@runner('parser-throughput', default=False)
+def run_parser_throughput(engine, arch, extra_arg):
+    # large inputs only, small files are dominated by timer resolution
+    inputs = []
+    for pattern in [join('test', 'octane', '*.js'),
+                    join('test', 'web-tooling-benchmark', 'dist', '*.js'),
+                    join('test', 'web-tooling-benchmark', 'third_party', '**', '*.js'),
+                    join('test', 'vendortest', '**', '*.js')]:
+        for path in sorted(glob(join(PROJECT_SOURCE_DIR, pattern), recursive=True)):
+            if os.path.getsize(path) >= 100 * 1024:
+                inputs.append(path)
+    if not inputs:
+        raise Exception('no parser inputs, check out test/octane, test/vendortest or test/web-tooling-benchmark')
+
+    run([engine, '-e', 'var parserInputs = %s' % repr(inputs),
+         join(PROJECT_SOURCE_DIR, 'tools', 'test', 'parser', 'throughput.js')])
+
+
+@runner('weakmap-memoization', default=False)
+def run_weakmap_memoization(engine, arch, extra_arg):
+    run([engine, join(PROJECT_SOURCE_DIR, 'tools', 'test', 'weakmap', 'memoization.js')])
+
+
+@runner('typedarray-bulk', default=False)
+def run_typedarray_bulk(engine, arch, extra_arg):
+    run([engine, join(PROJECT_SOURCE_DIR, 'tools', 'test', 'typedarray', 'bulk.js')])
+
+
+@runner('context-creation', default=False)
+def run_context_creation(engine, arch, extra_arg):
+    run([engine, join(PROJECT_SOURCE_DIR, 'tools', 'test', 'context', 'creation.js')])
+
+
 @runner('modifiedVendorTest', default=True)
 def run_internal_test(engine, arch, extra_arg):
     INTERNAL_OVERRIDE_DIR = join(PROJECT_SOURCE_DIR, 'tools', 'test', 'ModifiedVendorTest')
@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2026-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+// context creation workload: many Contexts on one VMInstance, each touching a few builtins
+// prints the best time per Context and the memory growth of the process over the whole run
+// usage: escargot tools/test/context/creation.js
+
+var contextCount = typeof contextCount === 'number' ? contextCount : 500;
+var contextIterations = typeof contextIterations === 'number' ? contextIterations : 5;
+
+function createContexts() {
+    var globals = [];
+    for (var i = 0; i < contextCount; i++) {
+        var g = createNewGlobalObject();
+        if (typeof g.Object.keys !== 'function' || typeof g.Array.from !== 'function') {
+            throw new Error("builtins missing in a new Context");
+        }
+        globals.push(g);
+    }
+    return globals.length;
+}
+
+gc();
+var startMemory = processMemoryUsage();
+var best = Infinity;
+for (var j = 0; j < contextIterations; j++) {
+    var start = Date.now();
+    createContexts();
+    best = Math.min(best, Date.now() - start);
+    gc();
+}
+var endMemory = processMemoryUsage();
+
+print("Context creation: " + contextCount + " contexts, " + (best * 1000 / contextCount).toFixed(1) + " us per context, memory growth " + Math.round((endMemory - startMemory) / 1024) + " KB");
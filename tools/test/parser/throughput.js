@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2026-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+// parses each file of `parserInputs` without running it and prints the best time
+// `new Function` scans the whole source, function bodies are compiled only when called
+// usage: escargot -e "var parserInputs = ['a.js', 'b.js']" tools/test/parser/throughput.js
+
+var parserIterations = typeof parserIterations === 'number' ? parserIterations : 10;
+var totalBytes = 0;
+var totalTime = 0;
+
+for (var i = 0; i < parserInputs.length; i++) {
+    var src = read(parserInputs[i]);
+    try {
+        new Function(src);
+    } catch (e) {
+        print(parserInputs[i] + ": skipped (" + e + ")");
+        continue;
+    }
+
+    var best = Infinity;
+    for (var j = 0; j < parserIterations; j++) {
+        var start = Date.now();
+        new Function(src);
+        best = Math.min(best, Date.now() - start);
+    }
+    best = Math.max(best, 1);
+    totalBytes += src.length;
+    totalTime += best;
+    print(parserInputs[i] + ": " + src.length + " chars, " + best + " ms, " + (src.length / 1000 / best).toFixed(1) + " MB/s");
+}
+
+print("Parser throughput: " + totalBytes + " chars in " + totalTime + " ms, " + (totalBytes / 1000 / Math.max(totalTime, 1)).toFixed(1) + " MB/s");
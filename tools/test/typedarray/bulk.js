@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2026-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+// bulk TypedArray copies, fills and searches on large arrays, prints the best time of each operation
+// usage: escargot tools/test/typedarray/bulk.js
+
+var typedArrayLength = typeof typedArrayLength === 'number' ? typedArrayLength : 1 << 22;
+var typedArrayIterations = typeof typedArrayIterations === 'number' ? typedArrayIterations : 10;
+
+var u8 = new Uint8Array(typedArrayLength);
+var i32 = new Int32Array(typedArrayLength);
+var f32 = new Float32Array(typedArrayLength);
+var f64 = new Float64Array(typedArrayLength);
+for (var i = 0; i < typedArrayLength; i++) {
+    i32[i] = i;
+    f64[i] = i * 0.5;
+}
+
+var operations = [
+    ["Int32Array set from Int32Array", function () { i32.set(new Int32Array(i32.buffer, 0, typedArrayLength >> 1), typedArrayLength >> 1); }],
+    ["Float32Array set from Float64Array", function () { f32.set(f64); }],
+    ["Uint8Array set from Int32Array", function () { u8.set(i32); }],
+    ["Float64Array from Int32Array", function () { new Float64Array(i32); }],
+    ["Int32Array slice", function () { i32.slice(1); }],
+    ["Float64Array fill", function () { f64.fill(1.5); }],
+    ["Uint8Array fill", function () { u8.fill(7); }],
+    ["Int32Array copyWithin", function () { i32.copyWithin(1, 0, typedArrayLength - 1); }],
+    ["Int32Array indexOf (miss)", function () { i32.indexOf(-1); }],
+    ["Float64Array includes NaN (miss)", function () { f64.includes(NaN); }],
+    ["Uint8Array lastIndexOf (miss)", function () { u8.lastIndexOf(255); }],
+];
+
+var total = 0;
+for (var i = 0; i < operations.length; i++) {
+    var best = Infinity;
+    for (var j = 0; j < typedArrayIterations; j++) {
+        var start = Date.now();
+        operations[i][1]();
+        best = Math.min(best, Date.now() - start);
+    }
+    total += best;
+    print(operations[i][0] + ": " + best + " ms");
+}
+
+print("TypedArray bulk operations: " + typedArrayLength + " elements, " + total + " ms");
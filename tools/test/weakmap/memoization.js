@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2026-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+// memoization cache workload: many short-lived object keys, repeated lookups and partial deletion
+// prints the best time of the workload and of the collection that sweeps the dropped keys
+// usage: escargot tools/test/weakmap/memoization.js
+
+var weakMapKeyCount = typeof weakMapKeyCount === 'number' ? weakMapKeyCount : 200000;
+var weakMapIterations = typeof weakMapIterations === 'number' ? weakMapIterations : 5;
+
+function runWorkload() {
+    var memo = new WeakMap();
+    var computed = 0;
+    function area(r) {
+        var v = memo.get(r);
+        if (v === undefined) {
+            computed++;
+            v = r.w * r.h;
+            memo.set(r, v);
+        }
+        return v;
+    }
+
+    var rects = [];
+    for (var i = 0; i < weakMapKeyCount; i++) {
+        rects.push({ w: i % 7, h: i % 11 });
+    }
+    var sum = 0;
+    for (var round = 0; round < 3; round++) {
+        for (var i = 0; i < rects.length; i += 1 + round) {
+            sum += area(rects[i]);
+        }
+    }
+    for (var i = 0; i < rects.length; i += 2) {
+        memo.delete(rects[i]);
+    }
+    if (computed !== weakMapKeyCount) {
+        throw new Error("unexpected miss count " + computed);
+    }
+    return sum;
+}
+
+var bestWorkload = Infinity;
+var bestGC = Infinity;
+for (var j = 0; j < weakMapIterations; j++) {
+    var start = Date.now();
+    runWorkload();
+    var middle = Date.now();
+    gc();
+    var end = Date.now();
+    bestWorkload = Math.min(bestWorkload, middle - start);
+    bestGC = Math.min(bestGC, end - middle);
+}
+
+print("WeakMap memoization: " + weakMapKeyCount + " keys, " + bestWorkload + " ms, gc " + bestGC + " ms");